@@ -73,6 +73,9 @@ void f(std::string fname)
     cusz_len         uncomp_len = cusz_len{3600, 1800, 1, 1, 1.03};
     cusz_len         decomp_len = uncomp_len;
 
+    /* Optional: allocate ahead; compressing (and decompressing) data of this shape then reuses the buffers. */
+    cusz_commit_space(comp, uncomp_len, nullptr);
+
     cusz::TimeRecord compress_timerecord;
     cusz::TimeRecord decompress_timerecord;
 
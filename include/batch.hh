@@ -0,0 +1,103 @@
+/**
+ * @file batch.hh
+ * @author Jiannan Tian
+ * @brief Batched compression of many same-shaped fields into one multi-field archive.
+ * @version 0.3
+ * @date 2022-12-18
+ *
+ * (C) 2022 by Indiana University, Argonne National Laboratory
+ *
+ */
+
+#ifndef B8D2E4F1_3A6C_4B97_A5E0_7C1D9F3B6E28
+#define B8D2E4F1_3A6C_4B97_A5E0_7C1D9F3B6E28
+
+#include "cusz/cuda_compat.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "context.hh"
+#include "cusz/type.h"
+
+namespace cusz {
+
+/**
+ * in-memory (and on-disk) layout of a multi-field archive
+ *
+ *   | BatchHeader | field 0 (.cusza) | field 1 (.cusza) | ... | BatchEntry[nfield] (table of contents) |
+ *
+ * Every field is an ordinary single-field archive, so a field can be decompressed on its own, either from the
+ * table of contents or after extracting its byte range.
+ */
+struct alignas(64) BatchHeader {
+    char     magic[8];  // "CUSZBTCH"
+    uint32_t version;
+    uint32_t nfield;
+    uint64_t toc_offset;
+    uint64_t total_nbyte;
+};
+
+struct BatchEntry {
+    uint64_t offset;  // position of the field archive from the beginning of the batch archive
+    uint64_t nbyte;
+    char     name[48];  // from Context::fname.fname, truncated; may be empty
+};
+
+struct BatchHelper {
+    static constexpr uint32_t VERSION = 1;
+
+    static bool is_batch_archive(uint8_t const* archive, size_t const archive_len);
+
+    static uint32_t          get_nfield(uint8_t const* archive);
+    static BatchEntry const* get_toc(uint8_t const* archive);
+};
+
+/**
+ * @brief Compress `nfield` fields into one multi-field archive.
+ *
+ * Fields of one shape share a compressor, so predictor, codec and sparse-codec workspaces are allocated once for
+ * the whole batch. On CUDA, two compressors alternate on their own streams so that field i + 1 is predicted while
+ * field i is being encoded and collected into the archive; on host, a single compressor takes the fields one after
+ * another in the calling thread, each with all of its OpenMP threads, with no overlap between fields.
+ *
+ * @tparam Compressor predefined Compressor type, accessible via cusz::Framework<T>::XFeaturedCompressor
+ * @tparam T uncompressed data type
+ * @param configs (host) one configuration per field; all fields share the execution policy of configs[0]
+ * @param fields (device, or host with the host policy) inputs, each allocated for >1.03x its length
+ * @param nfield number of fields
+ * @param archive (host) output multi-field archive
+ * @param stream CUDA stream of the first compressor (the second creates its own), or null for both to; unused with
+ * the host policy
+ * @return size of the archive in bytes
+ */
+template <class Compressor, typename T>
+size_t compress_batch(
+    Context*              configs,
+    T**                   fields,
+    size_t const          nfield,
+    std::vector<uint8_t>& archive,
+    cudaStream_t          stream = nullptr);
+
+/**
+ * @brief Decompress the fields of a multi-field archive; fields whose output is null are skipped.
+ *
+ * Outputs need not be zeroed beforehand: every element of a field is overwritten, outliers included.
+ *
+ * @param archive (host) multi-field archive
+ * @param archive_len (host) archive size in bytes, for checking
+ * @param fields (device, or host with the host policy) outputs, each allocated for >1.03x its length
+ * @param policy where decompression runs
+ * @param stream CUDA stream; unused with the host policy
+ */
+template <class Compressor, typename T>
+void decompress_batch(
+    uint8_t*              archive,
+    size_t const          archive_len,
+    T**                   fields,
+    cusz_execution_policy policy = CUDA,
+    cudaStream_t          stream = nullptr);
+
+}  // namespace cusz
+
+#endif /* B8D2E4F1_3A6C_4B97_A5E0_7C1D9F3B6E28 */
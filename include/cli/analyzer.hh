@@ -12,19 +12,23 @@
 #ifndef ANALYSIS_ANALYZER_HH
 #define ANALYSIS_ANALYZER_HH
 
+#include <cmath>
 #include <cstdio>
 #include <iostream>
 #include <stdexcept>
 #include <string>
 #include <vector>
 
+#ifndef CUSZ_HOST_ONLY
 #include <thrust/device_ptr.h>
 #include <thrust/extrema.h>
 #include <thrust/sort.h>
+#endif
 
 #include <algorithm>
 #include <numeric>
 
+#include "../cusz/cuda_compat.h"
 #include "../hf/hf_bookg.hh"
 #include "../hf/hf_codecg.hh"
 #include "../kernel/cpplaunch_cuda.hh"
@@ -74,40 +78,90 @@ class Analyzer {
     Analyzer()  = default;
     ~Analyzer() = default;
 
-    // TODO execution policy
+   private:
+    // places the ranks[lo, hi)-th smallest of buf[beg, end) at their sorted positions; ranks ascend
+    template <typename T>
+    static void select_ranks(T* buf, size_t beg, size_t end, size_t const* ranks, size_t lo, size_t hi)
+    {
+        if (lo == hi) return;
+
+        auto mid = lo + (hi - lo) / 2, at = ranks[mid];
+        std::nth_element(buf + beg, buf + at, buf + end);
+
+        // the halves are disjoint; fork only where it pays off
+#pragma omp task if (at - beg > (1 << 16))
+        select_ranks(buf, beg, at, ranks, lo, mid);
+#pragma omp task if (end - at > (1 << 16))
+        select_ranks(buf, at + 1, end, ranks, mid + 1, hi);
+#pragma omp taskwait
+    }
+
+   public:
+    /**
+     * @brief Values of the given ranks (0-based, in sorted order) of `in`, which is left as is. Each rank costs a
+     * partition of the part of a scratch copy it falls in, so k ranks take O(n log k) instead of sorting.
+     */
+    template <typename T>
+    static std::vector<T> select(T const* in, size_t len, std::vector<size_t> ranks)
+    {
+        std::vector<T> res;
+        if (len == 0) return res;
+
+        for (auto& r : ranks) r = std::min(r, len - 1);
+        std::vector<size_t> uniq(ranks);
+        std::sort(uniq.begin(), uniq.end());
+        uniq.erase(std::unique(uniq.begin(), uniq.end()), uniq.end());
+
+        std::vector<T> buf(in, in + len);
+#pragma omp parallel
+#pragma omp single
+        select_ranks(buf.data(), 0, len, uniq.data(), 0, uniq.size());
+
+        for (auto r : ranks) res.push_back(buf[r]);
+        return res;
+    }
+
+    // quantiles q in [0, 1], by the nearest rank below q * (len - 1)
+    template <typename T>
+    static std::vector<T> quantiles(T const* in, size_t len, std::vector<double> const& q)
+    {
+        std::vector<size_t> ranks;
+        for (auto _q : q) ranks.push_back(size_t(std::max(0.0, std::min(1.0, _q)) * (len == 0 ? 0 : len - 1)));
+        return select(in, len, ranks);
+    }
+
+    // every len/100-th smallest value, then the largest; `in` is no longer sorted in place
     template <typename T, ExecutionPolicy policy = ExecutionPolicy::host>
     static std::vector<T> percentile100(T* in, size_t len)
     {
-        std::vector<T> res;
-        auto           step = int(ceil(len / 100));
+        std::vector<size_t> ranks;
+        auto                step = std::max(len / 100, (size_t)1);
+        for (size_t i = 0; i < len; i += step) ranks.push_back(i);
+        if (len) ranks.push_back(len - 1);
 
         if CONSTEXPR (policy == ExecutionPolicy::cuda_device) {
+#ifndef CUSZ_HOST_ONLY
             // caveat: no residence check
-            thrust::sort(thrust::device, in, in + len);
             T* htmp;
             cudaMallocHost(&htmp, sizeof(T) * len);
             cudaMemcpy(htmp, in, sizeof(T) * len, cudaMemcpyDeviceToHost);
-            for (auto i = 0; i < len; i += step) {  //
-                res.push_back(htmp[i]);
-            }
-            res.push_back(htmp[len - 1]);
+            auto res = select(htmp, len, ranks);
             cudaFreeHost(htmp);
+            return res;
+#else
+            throw std::runtime_error("Analyzer::percentile100() This build has no CUDA backend.");
+#endif
         }
         else {  // fallback
-            std::sort(in, in + len);
-            for (auto i = 0; i < len; i += step) {  //
-                res.push_back(in[i]);
-            }
-            res.push_back(in[len - 1]);
+            return select(in, len, ranks);
         }
-
-        return res;
     }
 
     template <typename Data, ExecutionPolicy policy, AnalyzerMethod method>
     static extrema_result_t get_maxmin_rng(Data* d_data, size_t len)
     {
         if CONSTEXPR (policy == ExecutionPolicy::cuda_device and method == AnalyzerMethod::thrust) {
+#ifndef CUSZ_HOST_ONLY
             auto t0 = hires::now();
             // ------------------------------------------------------------
             thrust::device_ptr<Data> g_ptr = thrust::device_pointer_cast(d_data);
@@ -122,6 +176,9 @@ class Analyzer {
             auto t1 = hires::now();
 
             return extrema_result_t{max_val, min_val, rng, static_cast<duration_t>(t1 - t0).count()};
+#else
+            throw std::runtime_error("Analyzer::get_maxmin_rng() This build has no CUDA backend.");
+#endif
         }
         else {
             throw std::runtime_error("Analyzer::get_maxmin_rng() Other policy and method not implemented.");
@@ -66,11 +66,14 @@ static const char cusz_short_doc[] =
     "          - (1D) hacc  hacc1b  (2D) cesm  exafel\n"
     "          - (3D) hurricane  nyx-s  nyx-m  qmc  qmcpre  rtm  parihaka\n"
     "      + anchor (on|off)\n"
+    "      + policy (cuda|cpu) where to run the pipeline; also \"--policy\"\n"
+    "      + stream <MiB> compress out-of-core in segments of that size; also \"--stream\"\n"
+    "      + spval (xor|raw) how outlier values are stored\n"
     // "      + pipeline auto, binary, radius\n"
     "      example: \"--config demo=cesm,radius=512\"\n"
     "  report list: \n"
     "      syntax: opt[=v], \"kw1[=(on|off)],kw2[=(on|off)]\n"
-    "      keyworkds: time, quality\n"
+    "      keyworkds: time, quality, memory\n"
     "      example: \"--report time\", \"--report time=off\"\n"
     "\n"
     "example:\n"
@@ -133,7 +136,9 @@ static const char cusz_full_doc[] =
     "\n"
     "    *Additional*\n"
     "        *-p* or *--*@p@*redictor*\n"
-    "                Select predictor from \"lorenzo\" (default) or \"spline3d\" (3D only).\n"
+    "                Select predictor from \"lorenzo\" (default), \"lorenzoii\", \"spline3\" or \"regression\"\n"
+    "                (Lorenzo or linear regression, chosen per block); all but the first with policy=cpu only.\n"
+    "                Decompression follows the predictor recorded in the archive.\n"
     "        *--origin* or *--compare* /path/to/origin-datum\n"
     "                For verification & get data quality evaluation.\n"
     "        *--opath*  /path/to\n"
@@ -152,7 +157,7 @@ static const char cusz_full_doc[] =
     "    *Print Report to stdout*\n"
     "        *--report* (option=on/off)-list\n"
     "                Syntax: opt[=v], \"kw1[=(on|off)],kw2=[=(on|off)]\n"
-    "                Keyworkds: time  quality  compressibility\n"
+    "                Keyworkds: time  quality  compressibility  memory\n"
     "                Example: \"--report time\", \"--report time=off\"\n"
     "\n"
     "    *Demonstration*\n"
@@ -190,6 +195,16 @@ static const char cusz_full_doc[] =
     "                       Manually specify chunk size for Huffman codec, overriding autotuning.\n"
     "                       Should be a power-of-2 that is sufficiently large.\n"
     "                       ^^This affects Huffman decoding performance significantly.^^\n"
+    "                   + *policy*=<cuda|cpu>\n"
+    "                       Run the pipeline on GPU (default) or on multithreaded host.\n"
+    "                       Both write the same archive format.\n"
+    "                   + *stream*=<MiB>\n"
+    "                       Compress out-of-core: the input is cut along the slowest dimension into\n"
+    "                       segments of at most <MiB> (uncompressed), written as a multi-segment archive.\n"
+    "                       Decompression detects such archives automatically.\n"
+    "                   + *spval*=<xor|raw>\n"
+    "                       Store outlier values XOR-ed with their predecessor, with the shared leading\n"
+    "                       and trailing bits dropped per block (default), or as is.\n"
     "\n"
     "*EXAMPLES*\n"
     "    *Demo Datasets*\n"
@@ -19,6 +19,7 @@
 #include "../common/capsule.hh"
 #include "../common/definition.hh"
 #include "../header.h"
+#include "../stat/compare_cpu.hh"
 #include "../stat/compare_gpu.hh"
 #include "verify.hh"
 
@@ -92,9 +93,9 @@ struct QualityViewer {
     template <typename T>
     static void echo_metric_cpu(T* _d1, T* _d2, size_t len, size_t compressed_bytes = 0, bool from_device = true)
     {
-        auto stat = new cusz_stats;
-        T*   reconstructed;
-        T*   origin;
+        cusz_stats stat;
+        T*         reconstructed;
+        T*         origin;
         if (not from_device) {
             reconstructed = _d1;
             origin        = _d2;
@@ -107,15 +108,10 @@ struct QualityViewer {
             cudaMemcpy(reconstructed, _d1, bytes, cudaMemcpyDeviceToHost);
             cudaMemcpy(origin, _d2, bytes, cudaMemcpyDeviceToHost);
         }
-        cusz::verify_data<T>(stat, reconstructed, origin, len);
-        print_metrics_cross<T>(stat, compressed_bytes, false);
-
-        auto stat_auto_lag1 = new cusz_stats;
-        verify_data<T>(stat_auto_lag1, origin, origin + 1, len - 1);
-        auto stat_auto_lag2 = new cusz_stats;
-        verify_data<T>(stat_auto_lag2, origin, origin + 2, len - 2);
-
-        print_metrics_auto(&stat_auto_lag1->reduced.coeff, &stat_auto_lag2->reduced.coeff);
+        // cross and lag-1/2 autocorrelation in one pass
+        parsz::cppstd_assess_quality<T>(&stat, reconstructed, origin, len);
+        print_metrics_cross<T>(&stat, compressed_bytes, false);
+        print_metrics_auto(&stat.autocor.lag_one, &stat.autocor.lag_two);
 
         if (from_device) {
             if (reconstructed) cudaFreeHost(reconstructed);
@@ -130,7 +126,7 @@ struct QualityViewer {
     }
 
     template <typename T>
-    static void view(header_t header, Capsule<T>& xdata, Capsule<T>& cmp, string const& compare)
+    static void view(header_t header, Capsule<T>& xdata, Capsule<T>& cmp, string const& compare, bool on_host = false)
     {
         auto len             = ConfigHelper::get_uncompressed_len(header);
         auto compressd_bytes = ConfigHelper::get_filesize(header);
@@ -148,7 +144,14 @@ struct QualityViewer {
             cmp.template free<HOST>();
         };
 
-        if (compare != "") {
+        auto compare_host_only = [&]() {
+            cmp.template alloc<HOST>().template from_file<HOST>(compare);
+            echo_metric_cpu(xdata.hptr, cmp.hptr, len, compressd_bytes, /* from_device */ false);
+            cmp.template free<HOST>();
+        };
+
+        if (compare != "" and on_host) { compare_host_only(); }
+        else if (compare != "") {
             auto gb = 1.0 * sizeof(T) * len / 1e9;
             if (gb < 0.8)
                 compare_on_gpu();
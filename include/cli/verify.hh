@@ -40,10 +40,10 @@ void verify_data(cusz_stats* s, T* xdata, T* odata, size_t len)
         max_odata = max_odata < odata[i] ? odata[i] : max_odata;
         min_odata = min_odata > odata[i] ? odata[i] : min_odata;
 
-        max_xdata = max_xdata < odata[i] ? odata[i] : max_xdata;
+        max_xdata = max_xdata < xdata[i] ? xdata[i] : max_xdata;
         min_xdata = min_xdata > xdata[i] ? xdata[i] : min_xdata;
 
-        float abserr = fabs(xdata[i] - odata[i]);
+        double abserr = fabs(xdata[i] - odata[i]);
         if (odata[i] != 0) {
             rel_abserr        = abserr / fabs(odata[i]);
             max_pwrrel_abserr = max_pwrrel_abserr < rel_abserr ? rel_abserr : max_pwrrel_abserr;
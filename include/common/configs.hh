@@ -12,7 +12,7 @@
 #ifndef CUSZ_COMMON_CONFIGS_HH
 #define CUSZ_COMMON_CONFIGS_HH
 
-#include <cuda_runtime.h>
+#include "../cusz/cuda_compat.h"
 #include <cxxabi.h>
 #include <cmath>
 #include <fstream>
@@ -23,6 +23,7 @@
 #include <unordered_map>
 #include <vector>
 
+#include "../cusz/type.h"
 #include "../header.h"
 #include "definition.hh"
 
@@ -110,9 +111,9 @@ struct ConfigHelper {
     static uint32_t predictor_lookup(std::string name)
     {
         const std::unordered_map<std::string, uint32_t> lut = {
-            {"lorenzo", 0}, {"lorenzoii", 1}, {"spline3", 2}  //
+            {"lorenzo", LorenzoI}, {"lorenzoii", LorenzoII}, {"spline3", Spline3}, {"regression", Regression}  //
         };
-        if (lut.find(name) != lut.end()) throw std::runtime_error("no such predictor as " + name);
+        if (lut.find(name) == lut.end()) throw std::runtime_error("no such predictor as " + name);
         return lut.at(name);
     }
 
@@ -142,10 +143,11 @@ struct ConfigHelper {
 
     static bool check_predictor(const std::string& val, bool fatal = false)
     {
-        auto legal = (val == "lorenzo") or (val == "spline3");
+        auto legal = (val == "lorenzo") or (val == "lorenzoii") or (val == "spline3") or (val == "regression");
         if (not legal) {
             if (fatal)
-                throw std::runtime_error("`predictor` must be \"lorenzo\" or \"spline3\".");
+                throw std::runtime_error(
+                    "`predictor` must be \"lorenzo\", \"lorenzoii\", \"spline3\" or \"regression\".");
             else
                 printf("fallback to the default \"%s\".", get_default_predictor().c_str());
         }
@@ -13,8 +13,11 @@
 #define CUSZ_COMPONENT_HH
 
 #include "component/prediction.hh"
-#include "component/spcodec.hh"
 #include "component/spcodec_vec.hh"
 #include "hf/hf.hh"
 
+#ifndef CUSZ_HOST_ONLY
+#include "component/spcodec.hh"
+#endif
+
 #endif
\ No newline at end of file
@@ -12,14 +12,17 @@
 #ifndef CUSZ_COMPONENT_PREDICTORS_HH
 #define CUSZ_COMPONENT_PREDICTORS_HH
 
-#include <cuda_runtime.h>
+#include "cusz/cuda_compat.h"
 #include <cstdint>
 #include <memory>
 
 #include "cusz/type.h"
 #include "predictor_boilerplate.hh"
+#include "utils/mempool.hh"
 
-#define DEFINE_ARRAY(VAR, TYPE) TYPE* d_##VAR{nullptr};
+#define DEFINE_ARRAY(VAR, TYPE) \
+    TYPE* d_##VAR{nullptr};     \
+    TYPE* h_##VAR{nullptr};
 
 namespace cusz {
 
@@ -31,6 +34,9 @@ class PredictionUnified {
     using ErrCtrl   = E;
     using Precision = FP;
 
+    // what the compressor predicts with
+    static const cusz_predictortype kind = LorenzoI;
+
    private:
     class impl;
     std::unique_ptr<impl> pimpl;
@@ -43,8 +49,12 @@ class PredictionUnified {
     PredictionUnified(PredictionUnified&&);                  // move ctor
     PredictionUnified& operator=(PredictionUnified&&);       // move assign
 
-    void init(cusz_predictortype, size_t, size_t, size_t, bool dbg_print = false);
-    void init(cusz_predictortype, dim3, bool = false);
+    // before init(); buffers come from the default memory resource otherwise
+    void set_memory_resource(memory_resource*);
+    // before init(); room for len / factor outliers (4 by default)
+    void set_outlier_density_factor(int);
+    void init(cusz_predictortype, size_t, size_t, size_t, bool dbg_print = false, cusz_execution_policy = CUDA);
+    void init(cusz_predictortype, dim3, bool = false, cusz_execution_policy = CUDA);
 
     void construct(
         cusz_predictortype predictor,
@@ -53,9 +63,13 @@ class PredictionUnified {
         T**                ptr_anchor,
         E**                ptr_errctrl,
         T**                ptr_outlier,
+        uint32_t**         ptr_outlier_idx,
+        uint32_t*          num_outliers,
         double const       eb,
         int const          radius,
-        cudaStream_t       stream);
+        cudaStream_t       stream,
+        uint32_t*          out_freq = nullptr,
+        int const          nbin     = 0);
 
     void reconstruct(
         cusz_predictortype predictor,
@@ -67,6 +81,26 @@ class PredictionUnified {
         int const          radius,
         cudaStream_t       stream);
 
+    void reconstruct_region(
+        cusz_predictortype predictor,
+        dim3               len3,
+        T*                 outlier_xdata,
+        E*                 errctrl,
+        double const       eb,
+        int const          radius,
+        dim3               region_lo3,
+        dim3               region_hi3);
+
+    void reconstruct_slab(
+        cusz_predictortype predictor,
+        dim3               len3,
+        T*                 outlier_xdata,
+        E*                 errctrl,
+        double const       eb,
+        int const          radius,
+        size_t const       begin,
+        size_t const       end);
+
     void clear_buffer();
 
     float  get_time_elapsed() const;
@@ -82,6 +116,27 @@ class PredictionUnified {
     T* expose_outlier() const;
 };
 
+// the same buffers, predicting by the second-order Lorenzo (host only)
+template <typename T, typename E, typename FP>
+class PredictorLorenzoII : public PredictionUnified<T, E, FP> {
+   public:
+    static const cusz_predictortype kind = LorenzoII;
+};
+
+// the same buffers, predicting each block by Lorenzo or by linear regression, whichever fits it better (host only)
+template <typename T, typename E, typename FP>
+class PredictorRegression : public PredictionUnified<T, E, FP> {
+   public:
+    static const cusz_predictortype kind = Regression;
+};
+
+// the same buffers and kernels, only predicting by Spline3
+template <typename T, typename E, typename FP>
+class PredictorSpline3 : public PredictionUnified<T, E, FP> {
+   public:
+    static const cusz_predictortype kind = Spline3;
+};
+
 template <typename T, typename E, typename FP>
 class PredictionUnified<T, E, FP>::impl : public PredictorBoilerplate {
     // TODO remove the placeholder below
@@ -95,8 +150,10 @@ class PredictionUnified<T, E, FP>::impl : public PredictorBoilerplate {
     impl();
     ~impl();
 
-    void init(cusz_predictortype, size_t, size_t, size_t, bool = false);
-    void init(cusz_predictortype, dim3, bool = false);
+    void set_memory_resource(memory_resource*);
+    void set_outlier_density_factor(int);
+    void init(cusz_predictortype, size_t, size_t, size_t, bool = false, cusz_execution_policy = CUDA);
+    void init(cusz_predictortype, dim3, bool = false, cusz_execution_policy = CUDA);
 
     void construct(
         cusz_predictortype predictor,
@@ -105,9 +162,13 @@ class PredictionUnified<T, E, FP>::impl : public PredictorBoilerplate {
         T**                ptr_anchor,
         E**                ptr_errctrl,
         T**                ptr_outlier,
+        uint32_t**         ptr_outlier_idx,
+        uint32_t*          num_outliers,
         double const       eb,
         int const          radius,
-        cudaStream_t       stream);
+        cudaStream_t       stream,
+        uint32_t*          out_freq = nullptr,
+        int const          nbin     = 0);
 
     void reconstruct(
         cusz_predictortype predictor,
@@ -119,6 +180,26 @@ class PredictionUnified<T, E, FP>::impl : public PredictorBoilerplate {
         int const          radius,
         cudaStream_t       stream);
 
+    void reconstruct_region(
+        cusz_predictortype predictor,
+        dim3               len3,
+        T*                 outlier_xdata,
+        E*                 errctrl,
+        double const       eb,
+        int const          radius,
+        dim3               region_lo3,
+        dim3               region_hi3);
+
+    void reconstruct_slab(
+        cusz_predictortype predictor,
+        dim3               len3,
+        T*                 outlier_xdata,
+        E*                 errctrl,
+        double const       eb,
+        int const          radius,
+        size_t const       begin,
+        size_t const       end);
+
     void clear_buffer();
 
     float get_time_elapsed() const;
@@ -132,8 +213,15 @@ class PredictionUnified<T, E, FP>::impl : public PredictorBoilerplate {
     // data
     DEFINE_ARRAY(anchor, T);
     DEFINE_ARRAY(errctrl, E);
+    // outliers, compacted: values, indices and (device) count
     DEFINE_ARRAY(outlier, T);
+    DEFINE_ARRAY(outlier_idx, uint32_t);
+    DEFINE_ARRAY(outlier_num, uint32_t);
+    size_t outlier_cap{0};
+    int    outlier_density_factor{4};
     // flags
+    cusz_execution_policy policy{CUDA};
+    memory_resource*      mem{default_memory_resource()};
     // bool delay_postquant{false};
 
     template <bool NO_R_SEPARATE>
@@ -18,6 +18,8 @@
 
 #include "../common/configs.hh"
 #include "../cusz/type.h"
+#include "../kernel/regression_cpu.hh"
+#include "../kernel/spline3_cpu.hh"
 
 namespace cusz {
 
@@ -174,31 +176,47 @@ class PredictorBoilerplate {
 
     void derive_alloclen(cusz_predictortype predictor, dim3 base)
     {
-        if (predictor == LorenzoI) {
+        if (predictor == LorenzoI or predictor == LorenzoII) {
             // normal
             this->__derive_len(base, this->alloclen);
         }
 
         else if (predictor == Spline3) {
             // maximum possible
-            int sublen[3]      = {32, 8, 8};
-            int anchor_step[3] = {8, 8, 8};
+            int const stride         = spline3_anchor_stride(base);
+            int       sublen[3]      = {32, 8, 8};
+            int       anchor_step[3] = {stride, stride, stride};
             this->__derive_len(base, this->alloclen, sublen, anchor_step, true);
         }
+        else if (predictor == Regression) {
+            auto const block3    = regression_block3(base);
+            int        sublen[3] = {(int)block3.x, (int)block3.y, (int)block3.z};
+            this->__derive_len(base, this->alloclen, sublen, sublen, true);
+            // coefficients and selector bitmap, rather than a point per block
+            this->alloclen.assigned.anchor = regression_anchor_len(base);
+        }
     }
 
     void derive_rtlen(cusz_predictortype predictor, dim3 base)
     {
-        if (predictor == LorenzoI) {
+        if (predictor == LorenzoI or predictor == LorenzoII) {
             // normal
             this->__derive_len(base, this->rtlen);
         }
         else if (predictor == Spline3) {
             // maximum possible
-            int sublen[3]      = {32, 8, 8};
-            int anchor_step[3] = {8, 8, 8};
+            int const stride         = spline3_anchor_stride(base);
+            int       sublen[3]      = {32, 8, 8};
+            int       anchor_step[3] = {stride, stride, stride};
             this->__derive_len(base, this->rtlen, sublen, anchor_step, true);
         }
+        else if (predictor == Regression) {
+            auto const block3    = regression_block3(base);
+            int        sublen[3] = {(int)block3.x, (int)block3.y, (int)block3.z};
+            this->__derive_len(base, this->rtlen, sublen, sublen, true);
+            // coefficients and selector bitmap, rather than a point per block
+            this->rtlen.assigned.anchor = regression_anchor_len(base);
+        }
     }
 
     // "real" methods
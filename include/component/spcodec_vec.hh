@@ -12,12 +12,19 @@
 #ifndef CF358238_3946_4FFC_B5E6_45C12F0C0B44
 #define CF358238_3946_4FFC_B5E6_45C12F0C0B44
 
-#include <cuda_runtime.h>
+#include "cusz/cuda_compat.h"
 
+#include <cstddef>
 #include <cstdint>
 #include <memory>
 
-#define DEFINE_ARRAY(VAR, TYPE) TYPE* d_##VAR{nullptr};
+#include "cusz/type.h"
+#include "kernel/spv_val.hh"
+#include "utils/mempool.hh"
+
+#define DEFINE_ARRAY(VAR, TYPE) \
+    TYPE* d_##VAR{nullptr};     \
+    TYPE* h_##VAR{nullptr};
 
 namespace cusz {
 
@@ -43,9 +50,18 @@ class SpcodecVec {
     SpcodecVec(SpcodecVec&&);                  // move ctor
     SpcodecVec& operator=(SpcodecVec&&);       // move assign
 
-    void init(size_t const, int = 4, bool = false);
+    // before init(); buffers come from the default memory resource otherwise
+    void set_memory_resource(memory_resource*);
+    // how outlier values are stored (XOR-coded by default); decoding follows what the subfile says
+    void set_value_coding(cusz_spcodec_valcoding);
+    void init(size_t const, int = 4, bool = false, cusz_execution_policy = CUDA);
     void encode(T*, size_t const, BYTE*&, size_t&, cudaStream_t = nullptr, bool = false);
+    // from (val, idx, nnz) compacted elsewhere, e.g., by the predictor; the pairs are sorted in place
+    void encode_compacted(
+        T*, uint32_t*, int const, size_t const, BYTE*&, size_t&, cudaStream_t = nullptr, bool = false);
     void decode(BYTE*, T*, cudaStream_t = nullptr);
+    // (host) scatter only the entries within the [begin, end) index ranges; out holds the ranges back to back
+    void decode_region(BYTE*, size_t const*, size_t const, T*);
     void clear_buffer();
     // getter
     float get_time_elapsed() const;
@@ -72,15 +88,25 @@ struct SpcodecVec<T, M>::impl {
 
     RTE rte;
 
+    cusz_execution_policy policy{CUDA};
+    memory_resource*      mem{default_memory_resource()};
+    accsz::spv_valcoding  val_coding{accsz::spv_valcoding::XOR};
+
    private:
-    void subfile_collect(Header&, size_t, cudaStream_t = nullptr, bool = false);
+    void subfile_collect(Header&, size_t, T*, uint32_t*, cudaStream_t = nullptr, bool = false);
+    static void check_version(Header const&);
 
    public:
     impl() = default;
     ~impl();
-    void init(size_t const, int = 4, bool = false);
+    void set_memory_resource(memory_resource*);
+    void set_value_coding(cusz_spcodec_valcoding);
+    void init(size_t const, int = 4, bool = false, cusz_execution_policy = CUDA);
     void encode(T*, size_t const, BYTE*&, size_t&, cudaStream_t = nullptr, bool = false);
+    void encode_compacted(
+        T*, uint32_t*, int const, size_t const, BYTE*&, size_t&, cudaStream_t = nullptr, bool = false);
     void decode(BYTE*, T*, cudaStream_t = nullptr);
+    void decode_region(BYTE*, size_t const*, size_t const, T*);
     void clear_buffer();
     // getter
     float get_time_elapsed() const;
@@ -89,16 +115,26 @@ struct SpcodecVec<T, M>::impl {
 template <typename T, typename M>
 struct SpcodecVec<T, M>::impl::Header {
     static const int HEADER = 0;
-    static const int IDX    = 1;
-    static const int VAL    = 2;
+    static const int IDX    = 1;  // bit-packed, see accsz::spv_idx_layout; raw uint32_t in version 1
+    static const int VAL    = 2;  // as is, or XOR-coded (see accsz::spv_val_layout); as is in version 1
     static const int END    = 3;
 
+    // 1: raw idx and val (no version field); 2: bit-packed idx, val as val_coding says
+    static const uint32_t VERSION = 2;
+
     int       header_nbyte : 16;
     size_t    uncompressed_len;
     int       nnz;
     MetadataT entry[END + 1];
+    // since version 2; the header_nbyte of older subfiles stops short of them
+    uint64_t  version;
+    int       val_coding;  // accsz::spv_valcoding
 
     MetadataT subfile_size() const { return entry[END]; }
+    uint64_t  get_version() const
+    {
+        return (size_t)header_nbyte >= offsetof(Header, version) + sizeof(version) ? version : 1;
+    }
 };
 
 template <typename T, typename M>
@@ -14,12 +14,13 @@
 
 #include <memory>
 
-#include <cuda_runtime.h>
+#include "cusz/cuda_compat.h"
 
 #include "common/type_traits.hh"
 #include "component.hh"
 #include "context.hh"
 #include "header.h"
+#include "utils/mempool.hh"
 
 #define PUBLIC_TYPES                                                   \
     using Predictor     = typename BINDING::Predictor;                 \
@@ -63,11 +64,14 @@ class Compressor {
     Compressor& operator=(Compressor&&);
 
     // methods
+    // before init(); handed down to all components
+    void set_memory_resource(memory_resource*);
     void init(Context*, bool dbg_print = false);
-    void init(Header*, bool dbg_print = false);
+    void init(Header*, bool dbg_print = false, cusz_execution_policy = CUDA);
     void destroy();
     void compress(Context*, T*, BYTE*&, size_t&, cudaStream_t = nullptr, bool = false);
     void decompress(Header*, BYTE*, T*, cudaStream_t = nullptr, bool = true);
+    void decompress_region(Header*, BYTE*, dim3, dim3, T*);
     void clear_buffer();
     // getter
     void export_header(Header&);
@@ -84,7 +88,12 @@ class Compressor<BINDING>::impl {
     // state
     bool  use_fallback_codec{false};
     bool  fallback_codec_allocated{false};
+    bool  fused_decode{false};  // the last decompression reconstructed along with Huffman decoding
     BYTE* d_reserved_compressed{nullptr};
+    BYTE* h_reserved_compressed{nullptr};
+    // where the whole pipeline runs
+    cusz_execution_policy policy{CUDA};
+    memory_resource*      mem{default_memory_resource()};
     // profiling
     TimeRecord timerecord;
     // header
@@ -96,7 +105,8 @@ class Compressor<BINDING>::impl {
     Codec*         codec;
     FallbackCodec* fb_codec;
     // variables
-    uint32_t* d_freq;
+    uint32_t* d_freq{nullptr};
+    uint32_t* h_freq{nullptr};
     float     time_hist;
     dim3      data_len3;
 
@@ -105,10 +115,12 @@ class Compressor<BINDING>::impl {
     impl();
 
     // public methods
+    void set_memory_resource(memory_resource*);
     void init(Context* config, bool dbg_print = false);
-    void init(Header* config, bool dbg_print = false);
+    void init(Header* config, bool dbg_print = false, cusz_execution_policy policy = CUDA);
     void compress(Context*, T*, BYTE*&, size_t&, cudaStream_t = nullptr, bool = false);
     void decompress(Header*, BYTE*, T*, cudaStream_t = nullptr, bool = true);
+    void decompress_region(Header*, BYTE*, dim3, dim3, T*);
     void clear_buffer();
 
     // getter
@@ -124,6 +136,8 @@ class Compressor<BINDING>::impl {
     void init_codec(size_t, unsigned int, int, int, bool);
     void collect_compress_timerecord();
     void collect_decompress_timerecord();
+    static size_t lorenzo_band(dim3);
+    static void   check_version(Header const*);
     void encode_with_exception(E*, size_t, uint32_t*, int, int, int, bool, BYTE*&, size_t&, cudaStream_t, bool);
     void subfile_collect(T*, size_t, BYTE*, size_t, BYTE*, size_t, cudaStream_t, bool);
     void destroy();
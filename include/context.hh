@@ -21,6 +21,7 @@
 
 #include "common/configs.hh"
 #include "common/definition.hh"
+#include "cusz/type.h"
 #include "utils/format.hh"
 #include "utils/strhelper.hh"
 
@@ -61,7 +62,7 @@ struct cuszCTX {
         bool write2disk{false}, huffman{false};
     } skip;
     struct {
-        bool time{false}, cr{false}, compressibility{false};
+        bool time{false}, cr{false}, compressibility{false}, memory{false};
     } report;
 
     // filenames
@@ -85,6 +86,20 @@ struct cuszCTX {
     std::string spcodec   = ConfigHelper::get_default_spcodec();    // "cusparse-csr"
     std::string pipeline  = "auto";
 
+#ifdef CUSZ_HOST_ONLY
+    cusz_execution_policy policy{CPU};
+#else
+    cusz_execution_policy policy{CUDA};
+#endif
+
+    cusz_spcodec_valcoding spcodec_valcoding{XorValue};
+
+    // (host) reuse Huffman books across near-identical histograms; off, the output does not depend on earlier inputs
+    bool approx_bookcache{false};
+
+    // streaming (out-of-core) compression when nonzero: uncompressed bytes per segment
+    size_t stream_budget{0};
+
     // sparsity related: init_nnz when setting up Spcodec
     float nz_density{SparseMethodSetup::default_density};
     float nz_density_factor{SparseMethodSetup::default_density_factor};
@@ -133,6 +148,30 @@ struct cuszCTX {
         return *this;
     }
 
+    cuszCTX& set_policy(cusz_execution_policy _)
+    {
+        policy = _;
+        return *this;
+    }
+
+    cuszCTX& set_stream_budget(size_t _)
+    {
+        stream_budget = _;
+        return *this;
+    }
+
+    cuszCTX& set_spcodec_valcoding(cusz_spcodec_valcoding _)
+    {
+        spcodec_valcoding = _;
+        return *this;
+    }
+
+    cuszCTX& set_approx_bookcache(bool _)
+    {
+        approx_bookcache = _;
+        return *this;
+    }
+
     cuszCTX& set_huffbyte(int _)
     {
         huff_bytewidth = _;
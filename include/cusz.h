@@ -9,7 +9,7 @@
  *
  */
 
-#include <cuda_runtime.h>
+#include "cusz/cuda_compat.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -30,7 +30,9 @@ typedef struct cusz_compressor cusz_compressor;
 
 cusz_compressor* cusz_create(cusz_framework* framework, cusz_datatype const type);
 
-cusz_error_status cusz_commit_space(cusz_fixedlen_internal const* fixedlen, cusz_varlen_internal const* varlen);
+/* Allocate for data of reserved_mem ahead of compression, optionally adjusting the framework first. Compressing data
+ * of that shape (and radius) then reuses the buffers instead of allocating them on every call. */
+cusz_error_status cusz_commit_space(cusz_compressor* comp, cusz_len const reserved_mem, cusz_framework* adjusted);
 
 cusz_error_status cusz_release(cusz_compressor* comp);
 
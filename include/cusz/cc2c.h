@@ -12,31 +12,51 @@
 #ifndef CUSZ_CC2C_H
 #define CUSZ_CC2C_H
 
-#include <cuda_runtime.h>
+#include "cuda_compat.h"
 #include "../header.h"
 #include "record.h"
 #include "type.h"
 
 // CC struct
 struct cusz_compressor {
-    void*           compressor;
-    cusz_framework* framework;
+    void*           compressor{nullptr};
+    cusz_framework* framework{nullptr};
     cusz_datatype   type;
     cusz_len        memlen{};
-    cusz_len        datalen;
-    void*           context;
+    cusz_len        datalen{};
+    void*           context{nullptr};
 
     bool default_compressor{true};
 
     bool space_initialized{false};
+    // how many times `compressor` was init(), that is, its buffers allocated
+    size_t num_init{0};
 
-    ~cusz_compressor() = default;
-    cusz_compressor()  = default;
+    // what the buffers of `compressor` are sized for, the same whether compressing or decompressing; they are kept
+    // across calls until it changes (and what a call exposed is released then)
+    struct plan_t {
+        size_t   x{0}, y{0}, z{0};
+        int      radius{0}, pardeg{0};
+        float    nz_density_factor{0};
+        uint32_t codecs_in_use{0};
+        // which compressor `compressor` points to, and where its buffers are
+        cusz_predictortype    predictor{LorenzoI};
+        cusz_execution_policy policy{CUDA};
+
+        bool operator==(plan_t const& o) const
+        {
+            return x == o.x and y == o.y and z == o.z and radius == o.radius and pardeg == o.pardeg and
+                   nz_density_factor == o.nz_density_factor and codecs_in_use == o.codecs_in_use and
+                   predictor == o.predictor and policy == o.policy;
+        }
+    } plan;
+
+    ~cusz_compressor();
+    cusz_compressor() = default;
     cusz_compressor(cusz_framework*, cusz_datatype);
-    cusz_compressor(const cusz_compressor&) = default;
-    cusz_compressor& operator=(const cusz_compressor&) = default;
-    cusz_compressor(cusz_compressor&&)                 = default;
-    cusz_compressor& operator=(cusz_compressor&&) = default;
+    // owns the compressor and its buffers
+    cusz_compressor(const cusz_compressor&) = delete;
+    cusz_compressor& operator=(const cusz_compressor&) = delete;
 
     /* Set size for memory allocation ; optionally adjust the framework */
     cusz_error_status commit_space(cusz_len const reserved_mem, cusz_framework* adjusted);
@@ -62,6 +82,10 @@ struct cusz_compressor {
         cusz_len const decomp_len,
         void*          record,
         cudaStream_t   stream);
+
+   private:
+    // true if the compressor is (re)created for `next` and needs init(); kept as is otherwise
+    bool replan(plan_t const& next);
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,48 @@
+/**
+ * @file cuda_compat.h
+ * @author Jiannan Tian
+ * @brief The CUDA runtime header, or, in a host-only build (CUSZ_HOST_ONLY), the few of its types that the host
+ * interfaces carry along.
+ * @version 0.3
+ * @date 2022-12-30
+ *
+ * (C) 2022 by Indiana University, Argonne National Laboratory
+ *
+ */
+
+#ifndef C4D81E2A_5F3B_4C7E_9A06_B1E8D2F4A957
+#define C4D81E2A_5F3B_4C7E_9A06_B1E8D2F4A957
+
+#ifndef CUSZ_HOST_ONLY
+
+#include <cuda_runtime.h>
+
+#else
+
+// an opaque handle, never dereferenced; host code passes it through as nullptr
+typedef struct CUstream_st* cudaStream_t;
+
+#ifdef __cplusplus
+struct dim3 {
+    unsigned int x, y, z;
+    constexpr dim3(unsigned int vx = 1, unsigned int vy = 1, unsigned int vz = 1) : x(vx), y(vy), z(vz) {}
+};
+#else
+typedef struct dim3 {
+    unsigned int x, y, z;
+} dim3;
+#endif
+
+#ifndef __host__
+#define __host__
+#endif
+#ifndef __device__
+#define __device__
+#endif
+#ifndef __forceinline__
+#define __forceinline__ inline __attribute__((always_inline))
+#endif
+
+#endif
+
+#endif /* C4D81E2A_5F3B_4C7E_9A06_B1E8D2F4A957 */
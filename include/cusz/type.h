@@ -77,10 +77,11 @@ typedef enum cusz_pipelinetype  //
   Sparse = 2 } cusz_pipelinetype;
 
 typedef enum cusz_predictortype  //
-{ Lorenzo0  = 0,
-  LorenzoI  = 1,
-  LorenzoII = 2,
-  Spline3   = 3 } cusz_predictortype;
+{ Lorenzo0   = 0,
+  LorenzoI   = 1,
+  LorenzoII  = 2,
+  Spline3    = 3,
+  Regression = 4 } cusz_predictortype;
 
 typedef enum cusz_preprocessingtype  //
 { FP64toFP32 = 0,
@@ -103,6 +104,10 @@ typedef enum cusz_spcodectype  //
 { SparseMat = 0,
   SparseVec = 1 } cusz_spcodectype;
 
+typedef enum cusz_spcodec_valcoding  //
+{ RawValue = 0,
+  XorValue = 1 } cusz_spcodec_valcoding;
+
 typedef enum cusz_huffman_booktype  //
 { Tree      = 0,
   Canonical = 1 } cusz_huffman_booktype;
@@ -160,8 +165,9 @@ typedef struct cusz_custom_huffman_codec {
 } cusz_custom_huffman_codec;
 
 typedef struct cusz_custom_spcodec {
-    cusz_spcodectype type;
-    float            presumed_density;
+    cusz_spcodectype       type;
+    float                  presumed_density;
+    cusz_spcodec_valcoding value_coding;
 } cusz_custom_spcodec;
 
 ////// wrap-up
@@ -175,6 +181,9 @@ typedef struct cusz_custom_framework {
     // cusz_custom_spcodec      spcodec;
 
     cusz_custom_huffman_codec huffman;
+
+    // Host takes and returns host buffers, and is needed by LorenzoII, Spline3 and Regression; Device (0) otherwise
+    cusz_executiontype execution;
 } cusz_custom_framework;
 
 typedef cusz_custom_framework cusz_framework;
@@ -65,17 +65,44 @@ void core_compress(
  * @param decompressed_alloc_len (host) for checking; >1.03x the original data size to ensure the legal memory access
  * @param stream CUDA stream
  * @param timerecord collected time information for compressor; aquired by a deep copy
+ * @param policy where `compressed` and `decompressed` reside and decompression runs
  */
 template <class Compressor, typename T>
 void core_decompress(
-    Compressor*  compressor,
-    Header*      config,
-    uint8_t*     compressed,
-    size_t       compressed_len,
-    T*           decompressed,
-    size_t       decompressed_alloc_len,
-    cudaStream_t stream     = nullptr,
-    TimeRecord*  timerecord = nullptr);
+    Compressor*           compressor,
+    Header*               config,
+    uint8_t*              compressed,
+    size_t                compressed_len,
+    T*                    decompressed,
+    size_t                decompressed_alloc_len,
+    cudaStream_t          stream     = nullptr,
+    TimeRecord*           timerecord = nullptr,
+    cusz_execution_policy policy     = CUDA);
+
+/**
+ * @brief Decompress a box of the field on host without decoding the whole archive.
+ *
+ * @tparam Compressor predefined Compressor type, accessible via cusz::Framework<T>::XFeaturedCompressor
+ * @tparam T uncompressed data type
+ * @param compressor Compressor instance
+ * @param config (host) cusz::Header as configuration type
+ * @param compressed (host) input compressed array
+ * @param compressed_len (host) input compressed length for checking
+ * @param region_lo3 (host) first corner of the box, inclusive
+ * @param region_hi3 (host) last corner of the box, exclusive
+ * @param decompressed_region (host) output box, x fastest
+ * @param timerecord collected time information for compressor; aquired by a deep copy
+ */
+template <class Compressor, typename T>
+void core_decompress_region(
+    Compressor* compressor,
+    Header*     config,
+    uint8_t*    compressed,
+    size_t      compressed_len,
+    dim3        region_lo3,
+    dim3        region_hi3,
+    T*          decompressed_region,
+    TimeRecord* timerecord = nullptr);
 
 }  // namespace cusz
 
@@ -15,22 +15,39 @@
 #ifndef CUSZ_DEFAULT_PATH_CUH
 #define CUSZ_DEFAULT_PATH_CUH
 
-#include <cuda_runtime.h>
-#include <thrust/device_ptr.h>
-#include <thrust/execution_policy.h>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
+#include <string>
+#include <vector>
 
 #include "component.hh"
 #include "compressor.hh"
 #include "header.h"
+#include "stat/stat.hh"
+
+#ifndef CUSZ_HOST_ONLY
+#include <cuda_runtime.h>
+#include <thrust/device_ptr.h>
+#include <thrust/execution_policy.h>
 #include "kernel/cpplaunch_cuda.hh"
 #include "stat/stat_g.hh"
 #include "utils/cuda_err.cuh"
+#endif
 
 #define DEFINE_DEV(VAR, TYPE) TYPE* d_##VAR{nullptr};
 #define DEFINE_HOST(VAR, TYPE) TYPE* h_##VAR{nullptr};
-#define FREEDEV(VAR) CHECK_CUDA(cudaFree(d_##VAR));
-#define FREEHOST(VAR) CHECK_CUDA(cudaFreeHost(h_##VAR));
+#define FREEDEV(VAR)                               \
+    if (d_##VAR) {                                 \
+        mem->deallocate(d_##VAR, memkind::DEVICE); \
+        d_##VAR = nullptr;                         \
+    }
+#define FREEHOST(VAR)                                     \
+    if (h_##VAR) {                                        \
+        mem->deallocate(h_##VAR, memkind::HOST_PAGEABLE); \
+        h_##VAR = nullptr;                                \
+    }
 
 #define PRINT_ENTRY(VAR) printf("%d %-*s:  %'10u\n", (int)Header::VAR, 14, #VAR, header.entry[Header::VAR]);
 
@@ -41,6 +58,13 @@
         CHECK_CUDA(cudaMemcpyAsync(dst, src, nbyte[Header::FIELD], cudaMemcpyDeviceToDevice, stream)); \
     }
 
+#define HOST2HOST_COPY(VAR, FIELD)                                        \
+    if (nbyte[Header::FIELD] != 0 and VAR != nullptr) {                   \
+        auto dst = h_reserved_compressed + header.entry[Header::FIELD];   \
+        auto src = reinterpret_cast<BYTE*>(VAR);                          \
+        std::memcpy(dst, src, nbyte[Header::FIELD]);                      \
+    }
+
 #define ACCESSOR(SYM, TYPE) reinterpret_cast<TYPE*>(in_compressed + header->entry[Header::SYM])
 
 namespace cusz {
@@ -70,8 +94,25 @@ void IMPL::destroy()
 {
     if (spcodec) delete spcodec;
     if (codec) delete codec;
-    if (fb_codec) delete codec;
+    if (fb_codec) delete fb_codec;
     if (predictor) delete predictor;
+    spcodec = nullptr, codec = nullptr, fb_codec = nullptr, predictor = nullptr;
+
+    FREEHOST(freq);
+    FREEHOST(reserved_compressed);
+    FREEDEV(freq);
+    FREEDEV(reserved_compressed);
+}
+
+TEMPLATE_TYPE
+void IMPL::set_memory_resource(memory_resource* _mem)
+{
+    mem = _mem ? _mem : default_memory_resource();
+
+    (*predictor).set_memory_resource(mem);
+    (*spcodec).set_memory_resource(mem);
+    (*codec).set_memory_resource(mem);
+    (*fb_codec).set_memory_resource(mem);
 }
 
 TEMPLATE_TYPE
@@ -81,17 +122,31 @@ IMPL::~impl() { destroy(); }
 
 // TODO
 TEMPLATE_TYPE
-void IMPL::init(Context* config, bool dbg_print) { init_detail(config, dbg_print); }
+void IMPL::init(Context* config, bool dbg_print)
+{
+    policy = (*config).policy;
+    // only compression picks it; archives record the coding for decompression
+    (*spcodec).set_value_coding((*config).spcodec_valcoding);
+    (*codec).set_approximate_bookcache((*config).approx_bookcache);
+    (*fb_codec).set_approximate_bookcache((*config).approx_bookcache);
+    init_detail(config, dbg_print);
+}
 
 TEMPLATE_TYPE
-void IMPL::init(Header* config, bool dbg_print) { init_detail(config, dbg_print); }
+void IMPL::init(Header* config, bool dbg_print, cusz_execution_policy policy)
+{
+    this->policy = policy;
+    init_detail(config, dbg_print);
+}
 
+#ifndef CUSZ_HOST_ONLY
 template <class T>
 void peek_devdata(T* d_arr, size_t num = 20)
 {
     thrust::for_each(thrust::device, d_arr, d_arr + num, [=] __device__ __host__(const T i) { printf("%u\t", i); });
     printf("\n");
 }
+#endif
 
 TEMPLATE_TYPE
 void IMPL::compress(
@@ -119,20 +174,25 @@ void IMPL::compress(
     data_len3                 = dim3((*config).x, (*config).y, (*config).z);
     auto codec_force_fallback = (*config).codec_force_fallback();
 
+    // padding and unset fields included, so equal inputs give equal archives
+    memset(&header, 0x0, sizeof(header));
     header.codecs_in_use     = codecs_in_use;
     header.nz_density_factor = nz_density_factor;
 
-    T*     d_anchor{nullptr};   // predictor out1
-    E*     d_errctrl{nullptr};  // predictor out2
-    T*     d_outlier{nullptr};  // predictor out3
-    BYTE*  d_spfmt{nullptr};
-    size_t spfmt_outlen{0};
+    T*        d_anchor{nullptr};       // predictor out1
+    E*        d_errctrl{nullptr};      // predictor out2
+    T*        d_outlier{nullptr};      // predictor out3, compacted
+    uint32_t* d_outlier_idx{nullptr};  //
+    uint32_t  num_outliers{0};         //
+    BYTE*     d_spfmt{nullptr};
+    size_t    spfmt_outlen{0};
 
     BYTE*  d_codec_out{nullptr};
     size_t codec_outlen{0};
 
     size_t data_len, errctrl_len, sublen, spcodec_inlen;
     auto   booklen = radius * 2;
+    auto   freq    = policy == CPU ? h_freq : d_freq;
 
     auto derive_lengths_after_prediction = [&]() {
         data_len      = predictor->get_len_data();
@@ -151,6 +211,8 @@ void IMPL::compress(
         header.y          = data_len3.y;
         header.z          = data_len3.z;
         header.radius     = radius;
+        header.predictor  = Predictor::kind;
+        header.set_version();
         header.vle_pardeg = pardeg;
         header.eb         = eb;
         header.byte_vle   = use_fallback_codec ? 8 : 4;
@@ -159,26 +221,40 @@ void IMPL::compress(
     /******************************************************************************/
 
     // Prediction is the dependency of the rest procedures.
-    predictor->construct(LorenzoI, data_len3, uncompressed, &d_anchor, &d_errctrl, &d_outlier, eb, radius, stream);
+    // On host, it also counts the quant-codes as it writes them, saving a pass over d_errctrl.
+    predictor->construct(
+        Predictor::kind, data_len3, uncompressed, &d_anchor, &d_errctrl, &d_outlier, &d_outlier_idx, &num_outliers, eb,
+        radius, stream, policy == CPU ? h_freq : nullptr, booklen);
     // peek_devdata(d_errctrl);
 
     derive_lengths_after_prediction();
     /******************************************************************************/
 
-    asz::stat::histogram<E>(d_errctrl, errctrl_len, d_freq, booklen, &time_hist, stream);
+    if (policy == CPU)
+        time_hist = 0;  // included in the time of prediction
+#ifndef CUSZ_HOST_ONLY
+    else {
+        // the histogram accumulates; reset for consecutive compressions
+        CHECK_CUDA(cudaMemsetAsync(d_freq, 0x0, sizeof(cusz::FREQ) * booklen, stream));
+        asz::stat::histogram<E>(d_errctrl, errctrl_len, d_freq, booklen, &time_hist, stream);
+    }
 
-    /* debug */ CHECK_CUDA(cudaStreamSynchronize(stream));
+    /* debug */ if (policy == CUDA) CHECK_CUDA(cudaStreamSynchronize(stream));
+#endif
 
     // TODO remove duplicate get_frequency inside encode_with_exception()
     encode_with_exception(
-        d_errctrl, errctrl_len,                                 // input
-        d_freq, booklen, sublen, pardeg, codec_force_fallback,  // config
-        d_codec_out, codec_outlen,                              // output
+        d_errctrl, errctrl_len,                               // input
+        freq, booklen, sublen, pardeg, codec_force_fallback,  // config
+        d_codec_out, codec_outlen,                            // output
         stream, dbg_print);
 
-    (*spcodec).encode(d_outlier, spcodec_inlen, d_spfmt, spfmt_outlen, stream, dbg_print);
+    (*spcodec).encode_compacted(
+        d_outlier, d_outlier_idx, num_outliers, spcodec_inlen, d_spfmt, spfmt_outlen, stream, dbg_print);
 
-    /* debug */ CHECK_CUDA(cudaStreamSynchronize(stream));
+#ifndef CUSZ_HOST_ONLY
+    /* debug */ if (policy == CUDA) CHECK_CUDA(cudaStreamSynchronize(stream));
+#endif
 
     /******************************************************************************/
 
@@ -191,7 +267,7 @@ void IMPL::compress(
 
     // output
     compressed_len = ConfigHelper::get_filesize(&header);
-    compressed     = d_reserved_compressed;
+    compressed     = policy == CPU ? h_reserved_compressed : d_reserved_compressed;
 
     collect_compress_timerecord();
 
@@ -213,10 +289,18 @@ void IMPL::decompress(Header* header, BYTE* in_compressed, T* out_decompressed,
     // TODO host having copy of header when compressing
     if (not header) {
         header = new Header;
-        CHECK_CUDA(cudaMemcpyAsync(header, in_compressed, sizeof(Header), cudaMemcpyDeviceToHost, stream));
-        CHECK_CUDA(cudaStreamSynchronize(stream));
+        if (policy == CPU)
+            std::memcpy(header, in_compressed, sizeof(Header));
+#ifndef CUSZ_HOST_ONLY
+        else {
+            CHECK_CUDA(cudaMemcpyAsync(header, in_compressed, sizeof(Header), cudaMemcpyDeviceToHost, stream));
+            CHECK_CUDA(cudaStreamSynchronize(stream));
+        }
+#endif
     }
 
+    check_version(header);
+
     data_len3 = dim3(header->x, header->y, header->z);
 
     use_fallback_codec      = header->byte_vle == 8;
@@ -236,25 +320,55 @@ void IMPL::decompress(Header* header, BYTE* in_compressed, T* out_decompressed,
     auto d_outlier       = out_decompressed;
     auto d_outlier_xdata = out_decompressed;
 
-    auto spcodec_do            = [&]() { (*spcodec).decode(d_sp, d_outlier, stream); };
+    // outliers are scattered onto, and predictions added to, what is in the output; start from zero every time
+    auto clear_output = [&]() {
+        auto const nbyte = sizeof(T) * data_len3.x * data_len3.y * data_len3.z;
+        if (policy == CPU) memset(out_decompressed, 0x0, nbyte);
+#ifndef CUSZ_HOST_ONLY
+        else
+            CHECK_CUDA(cudaMemsetAsync(out_decompressed, 0x0, nbyte, stream));
+#endif
+    };
+    auto spcodec_do       = [&]() { (*spcodec).decode(d_sp, d_outlier, stream); };
+    auto prepare_fb_codec = [&]() {
+        if (not fallback_codec_allocated) {
+            (*fb_codec).init((*predictor).get_len_quant(), radius * 2, vle_pardeg, /*dbg print*/ false, policy);
+            fallback_codec_allocated = true;
+        }
+    };
     auto decode_with_exception = [&]() {
         if (not use_fallback_codec) {  //
             (*codec).decode(d_vle, d_errctrl);
         }
         else {
-            if (not fallback_codec_allocated) {
-                (*fb_codec).init((*predictor).get_len_quant(), radius * 2, vle_pardeg, /*dbg print*/ false);
-                fallback_codec_allocated = true;
-            }
+            prepare_fb_codec();
             (*fb_codec).decode(d_vle, d_errctrl);
         }
     };
     auto predictor_do = [&]() {
-        (*predictor).reconstruct(LorenzoI, data_len3, d_outlier_xdata, d_anchor, d_errctrl, eb, radius, stream);
+        (*predictor).reconstruct(Predictor::kind, data_len3, d_outlier_xdata, d_anchor, d_errctrl, eb, radius, stream);
+    };
+    // (host) reconstruct each Huffman chunk right after it is decoded, if chunks are whole rows of Lorenzo tiles;
+    // the quant-codes then never make it to d_errctrl
+    auto decode_reconstruct_by_slab = [&]() {
+        auto const band = lorenzo_band(data_len3);
+        if (policy != CPU or Predictor::kind != LorenzoI or band == 0) return false;
+
+        auto consume = [&](size_t begin, size_t end, E* quant) {
+            (*predictor).reconstruct_slab(Predictor::kind, data_len3, d_outlier_xdata, quant, eb, radius, begin, end);
+        };
+
+        if (not use_fallback_codec) return (*codec).decode_chunkwise(d_vle, band, consume);
+
+        prepare_fb_codec();
+        return (*fb_codec).decode_chunkwise(d_vle, band, consume);
     };
 
     // process
-    spcodec_do(), decode_with_exception(), predictor_do();
+    clear_output();
+    spcodec_do();
+    fused_decode = decode_reconstruct_by_slab();
+    if (not fused_decode) decode_with_exception(), predictor_do();
 
     collect_decompress_timerecord();
 
@@ -262,6 +376,108 @@ void IMPL::decompress(Header* header, BYTE* in_compressed, T* out_decompressed,
     use_fallback_codec = false;
 }
 
+/**
+ * @brief (host) decompress only the box [region_lo3, region_hi3) of the field.
+ *
+ * The box is widened to whole Lorenzo tiles, which reconstruct independently. Only the Huffman chunks and the
+ * outliers overlapping the rows of the widened box are decoded; the rest of the archive is not touched.
+ *
+ * @param in_compressed (host) archive
+ * @param out_region (host) (hi.x - lo.x) * (hi.y - lo.y) * (hi.z - lo.z) elements, x fastest
+ */
+TEMPLATE_TYPE
+void IMPL::decompress_region(Header* header, BYTE* in_compressed, dim3 region_lo3, dim3 region_hi3, T* out_region)
+{
+    if (policy != CPU) throw std::runtime_error("Region decompression requires the host policy.");
+    if (Predictor::kind != LorenzoI) throw std::runtime_error("Region decompression supports only Lorenzo.");
+
+    Header _header;
+    if (not header) {
+        std::memcpy(&_header, in_compressed, sizeof(Header));
+        header = &_header;
+    }
+    check_version(header);
+
+    data_len3 = dim3(header->x, header->y, header->z);
+
+    auto clamp_hi = [](uint32_t hi, uint32_t len) { return std::min(hi, len); };
+    region_hi3    = dim3(
+        clamp_hi(region_hi3.x, data_len3.x), clamp_hi(region_hi3.y, data_len3.y),
+        clamp_hi(region_hi3.z, data_len3.z));
+    if (region_lo3.x >= region_hi3.x or region_lo3.y >= region_hi3.y or region_lo3.z >= region_hi3.z)
+        throw std::runtime_error("Region is empty or out of the data range.");
+
+    // widen to whole tiles: 256 (1D), 16x16 (2D), 8x8x8 (3D)
+    auto const ndim = data_len3.z != 1 ? 3 : (data_len3.y != 1 ? 2 : 1);
+    auto const tile = ndim == 3 ? dim3(8, 8, 8) : (ndim == 2 ? dim3(16, 16, 1) : dim3(256, 1, 1));
+
+    auto align_lo = [](uint32_t v, uint32_t b) { return v / b * b; };
+    auto align_hi = [](uint32_t v, uint32_t b, uint32_t len) { return std::min((v + b - 1) / b * b, len); };
+
+    auto lo = dim3(align_lo(region_lo3.x, tile.x), align_lo(region_lo3.y, tile.y), align_lo(region_lo3.z, tile.z));
+    auto hi = dim3(
+        align_hi(region_hi3.x, tile.x, data_len3.x), align_hi(region_hi3.y, tile.y, data_len3.y),
+        align_hi(region_hi3.z, tile.z, data_len3.z));
+
+    // [begin, end) linear ranges of the widened box, one per row; rows spanning the whole x extent coalesce. Back to
+    // back, the ranges make up the box, x fastest.
+    std::vector<size_t> ranges;
+    for (auto z = lo.z; z < hi.z; z++) {
+        for (auto y = lo.y; y < hi.y; y++) {
+            size_t row = ((size_t)z * data_len3.y + y) * data_len3.x;
+            if (not ranges.empty() and ranges.back() == row + lo.x)
+                ranges.back() = row + hi.x;
+            else
+                ranges.push_back(row + lo.x), ranges.push_back(row + hi.x);
+        }
+    }
+    auto const nrange = ranges.size() / 2;
+
+    use_fallback_codec  = header->byte_vle == 8;
+    double const eb     = header->eb;
+    int const    radius = header->radius;
+
+    auto h_vle = reinterpret_cast<BYTE*>(in_compressed + header->entry[Header::VLE]);
+    auto h_sp  = reinterpret_cast<BYTE*>(in_compressed + header->entry[Header::SPFMT]);
+
+    // workspaces of the widened box only; decoding region needs no codec buffers, so the fallback codec is not set up
+    auto const box3   = dim3(hi.x - lo.x, hi.y - lo.y, hi.z - lo.z);
+    auto const boxlen = (size_t)box3.x * box3.y * box3.z;
+
+    auto h_errctrl       = (E*)mem->allocate(sizeof(E) * boxlen, memkind::HOST_PAGEABLE);
+    auto h_outlier_xdata = (T*)mem->allocate(sizeof(T) * boxlen, memkind::HOST_PAGEABLE);
+    std::memset(h_outlier_xdata, 0x0, sizeof(T) * boxlen);
+
+    (*spcodec).decode_region(h_sp, ranges.data(), nrange, h_outlier_xdata);
+
+    if (not use_fallback_codec)
+        (*codec).decode_region(h_vle, ranges.data(), nrange, h_errctrl);
+    else
+        (*fb_codec).decode_region(h_vle, ranges.data(), nrange, h_errctrl);
+
+    (*predictor).reconstruct_region(Predictor::kind, data_len3, h_outlier_xdata, h_errctrl, eb, radius, lo, hi);
+
+    auto const out_len3 = dim3(
+        region_hi3.x - region_lo3.x, region_hi3.y - region_lo3.y, region_hi3.z - region_lo3.z);
+
+#pragma omp parallel for collapse(2)
+    for (auto z = 0u; z < out_len3.z; z++) {
+        for (auto y = 0u; y < out_len3.y; y++) {
+            auto src = h_outlier_xdata +
+                       (((size_t)(z + region_lo3.z - lo.z) * box3.y + (y + region_lo3.y - lo.y)) * box3.x +
+                        (region_lo3.x - lo.x));
+            std::memcpy(out_region + ((size_t)z * out_len3.y + y) * out_len3.x, src, sizeof(T) * out_len3.x);
+        }
+    }
+
+    mem->deallocate(h_errctrl, memkind::HOST_PAGEABLE);
+    mem->deallocate(h_outlier_xdata, memkind::HOST_PAGEABLE);
+
+    collect_decompress_timerecord();
+
+    use_fallback_codec = false;
+}
+
 // public getter
 TEMPLATE_TYPE
 void IMPL::export_header(Header& ext_header) { ext_header = header; }
@@ -282,11 +498,11 @@ void IMPL::init_codec(size_t codec_in_len, unsigned int codec_config, int max_bo
     if (codec_config == 0b00) throw std::runtime_error("Argument codec_config must have set bit(s).");
     if (codec_config bitand 0b01) {
         if (dbg_print) LOGGING(LOG_INFO, "allocated 4-byte codec");
-        (*codec).init(codec_in_len, max_booklen, pardeg, dbg_print);
+        (*codec).init(codec_in_len, max_booklen, pardeg, dbg_print, policy);
     }
     if (codec_config bitand 0b10) {
         if (dbg_print) LOGGING(LOG_INFO, "allocated 8-byte (fallback) codec");
-        (*fb_codec).init(codec_in_len, max_booklen, pardeg, dbg_print);
+        (*fb_codec).init(codec_in_len, max_booklen, pardeg, dbg_print, policy);
         fallback_codec_allocated = true;
     }
 };
@@ -306,16 +522,49 @@ void IMPL::init_detail(CONFIG* config, bool dbg_print)
 
     size_t spcodec_in_len, codec_in_len;
 
-    (*predictor).init(LorenzoI, x, y, z, dbg_print);
+    // the device Spline3 kernels keep the quant-codes in padded blocks and leave the outliers in place
+    if (Predictor::kind == Spline3 and policy != CPU) throw std::runtime_error("Spline3 runs only on host for now.");
+    if (Predictor::kind == LorenzoII and policy != CPU) throw std::runtime_error("LorenzoII runs only on host.");
+    if (Predictor::kind == Regression and policy != CPU) throw std::runtime_error("Regression runs only on host.");
+#ifdef CUSZ_HOST_ONLY
+    if (policy != CPU) throw std::runtime_error("This build has no CUDA backend; use the host policy.");
+#endif
+
+    (*predictor).set_outlier_density_factor(density_factor);
+    (*predictor).init(Predictor::kind, x, y, z, dbg_print, policy);
+
+    // so that host decompression can reconstruct chunk by chunk; on either policy, so that host and device archives
+    // of the same input are chunked alike
+    if (Predictor::kind == LorenzoI) {
+        auto const band = lorenzo_band(dim3(x, y, z));
+        (*codec).set_chunk_alignment(band);
+        (*fb_codec).set_chunk_alignment(band);
+    }
 
     spcodec_in_len = (*predictor).get_alloclen_data();
     codec_in_len   = (*predictor).get_alloclen_quant();
 
-    (*spcodec).init(spcodec_in_len, density_factor, dbg_print);
+    (*spcodec).init(spcodec_in_len, density_factor, dbg_print, policy);
+
+    // the archive is taken to be at most half the input, plus what does not shrink with it: the headers, and the
+    // Huffman revbook (of the 8-byte fallback codec, at most) and chunk metadata
+    auto const reserved_nbyte = (*predictor).get_alloclen_data() * sizeof(T) / 2 + 3 * 128 + sizeof(uint64_t) * 128 +
+                                sizeof(E) * cfg_max_booklen + sizeof(uint32_t) * 2 * cfg_pardeg;
 
+    if (policy == CPU) {
+        h_freq = (uint32_t*)mem->allocate(sizeof(cusz::FREQ) * cfg_max_booklen, memkind::HOST_PAGEABLE);
+        std::memset(h_freq, 0x0, sizeof(cusz::FREQ) * cfg_max_booklen);
+
+        init_codec(codec_in_len, codec_config, cfg_max_booklen, cfg_pardeg, dbg_print);
+
+        h_reserved_compressed = (BYTE*)mem->allocate(reserved_nbyte, memkind::HOST_PAGEABLE);
+        return;
+    }
+
+#ifndef CUSZ_HOST_ONLY
     {
         auto bytes = sizeof(cusz::FREQ) * cfg_max_booklen;
-        cudaMalloc(&d_freq, bytes);
+        d_freq     = (uint32_t*)mem->allocate(bytes, memkind::DEVICE);
         cudaMemset(d_freq, 0x0, bytes);
 
         // cudaMalloc(&d_freq_another, bytes);
@@ -324,7 +573,43 @@ void IMPL::init_detail(CONFIG* config, bool dbg_print)
 
     init_codec(codec_in_len, codec_config, cfg_max_booklen, cfg_pardeg, dbg_print);
 
-    CHECK_CUDA(cudaMalloc(&d_reserved_compressed, (*predictor).get_alloclen_data() * sizeof(T) / 2));
+    d_reserved_compressed = (BYTE*)mem->allocate(reserved_nbyte, memkind::DEVICE);
+#endif
+}
+
+/**
+ * @brief Number of elements in one row of Lorenzo tiles, which reconstructs independently of the others: 256 (1D),
+ * 16 rows (2D), 8 planes (3D); 0 if that is too coarse a unit to split the work (and the Huffman chunks) by.
+ */
+TEMPLATE_TYPE
+size_t IMPL::lorenzo_band(dim3 len3)
+{
+    constexpr size_t MAX_BAND = 1 << 20;
+
+    auto const ndim = len3.z != 1 ? 3 : (len3.y != 1 ? 2 : 1);
+    auto const band = ndim == 3 ? 8ul * len3.x * len3.y : (ndim == 2 ? 16ul * len3.x : 256ul);
+    return band <= MAX_BAND ? band : 0;
+}
+
+/**
+ * @brief Whether this compressor reads the archive: a version this build knows, and, where the version records it,
+ * the same predictor. Version-1 archives do not record theirs, so the caller's choice of compressor stands, except
+ * for 1D and 2D Spline3, whose anchors were laid out every 8 points then.
+ */
+TEMPLATE_TYPE
+void IMPL::check_version(Header const* header)
+{
+    auto const version = header->get_version();
+    if (version > Header::VERSION)
+        throw std::runtime_error(
+            "The archive is of version " + std::to_string(version) + ", newer than this build reads (" +
+            std::to_string(Header::VERSION) + ").");
+
+    if (version >= 2 and (cusz_predictortype)header->predictor != Predictor::kind)
+        throw std::runtime_error("The archive was compressed with another predictor than this compressor's.");
+
+    if (version < 2 and Predictor::kind == Spline3 and header->z == 1)
+        throw std::runtime_error("1D and 2D Spline3 archives of version 1 use an anchor layout no longer read.");
 }
 
 TEMPLATE_TYPE
@@ -356,14 +641,15 @@ void IMPL::collect_decompress_timerecord()
 
     COLLECT_TIME("outlier", (*spcodec).get_time_elapsed());
 
+    auto const name = fused_decode ? "huff-dec+predict" : "huff-dec";
     if (not use_fallback_codec) {  //
-        COLLECT_TIME("huff-dec", (*codec).get_time_lossless());
+        COLLECT_TIME(name, (*codec).get_time_lossless());
     }
     else {  //
-        COLLECT_TIME("huff-dec", (*fb_codec).get_time_lossless());
+        COLLECT_TIME(name, (*fb_codec).get_time_lossless());
     }
 
-    COLLECT_TIME("predict", (*predictor).get_time_elapsed());
+    if (not fused_decode) COLLECT_TIME("predict", (*predictor).get_time_elapsed());
 }
 
 TEMPLATE_TYPE
@@ -387,12 +673,14 @@ void IMPL::encode_with_exception(
         use_fallback_codec = true;
         if (not fallback_codec_allocated) {
             LOGGING(LOG_EXCEPTION, "online allocate fallback (8-byte) codec");
-            fb_codec->init(inlen, booklen, pardeg, dbg_print);
+            fb_codec->init(inlen, booklen, pardeg, dbg_print, policy);
             fallback_codec_allocated = true;
         }
     };
 
     /******************************************************************************/
+    // Codeword lengths are capped to fit the 4-byte book, so the fallback codec is reached only when forced or on an
+    // unexpected failure of the 4-byte codec.
     if (not codec_force_fallback) {
         try {
             build_codebook_using(codec);
@@ -452,6 +740,17 @@ void IMPL::subfile_collect(
 
     if (dbg_print) debug_header_entry();
 
+    if (policy == CPU) {
+        std::memcpy(h_reserved_compressed, &header, sizeof(header));
+
+        HOST2HOST_COPY(d_anchor, ANCHOR)
+        HOST2HOST_COPY(d_codec_out, VLE)
+        HOST2HOST_COPY(d_spfmt_out, SPFMT)
+
+        return;
+    }
+
+#ifndef CUSZ_HOST_ONLY
     CHECK_CUDA(cudaMemcpyAsync(d_reserved_compressed, &header, sizeof(header), cudaMemcpyHostToDevice, stream));
 
     DEVICE2DEVICE_COPY(d_anchor, ANCHOR)
@@ -459,6 +758,7 @@ void IMPL::subfile_collect(
     DEVICE2DEVICE_COPY(d_spfmt_out, SPFMT)
 
     /* debug */ CHECK_CUDA(cudaStreamSynchronize(stream));
+#endif
 }
 
 }  // namespace cusz
@@ -468,6 +768,7 @@ void IMPL::subfile_collect(
 #undef DEFINE_DEV
 #undef DEFINE_HOST
 #undef DEVICE2DEVICE_COPY
+#undef HOST2HOST_COPY
 #undef PRINT_ENTRY
 #undef ACCESSOR
 #undef COLLECT_TIME
@@ -14,17 +14,25 @@
 #define CUSZ_COMPONENT_EXTRAP_LORENZO_CUH
 
 #include <clocale>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
 #include <limits>
 #include <numeric>
 #include <stdexcept>
+#include <string>
 
 #include "../common.hh"
 #include "../component/prediction.hh"
-#include "../kernel/cpplaunch_cuda.hh"
 #include "../kernel/lorenzo_all.hh"
+#include "../kernel/regression_cpu.hh"
+#include "../kernel/spline3_cpu.hh"
 #include "../utils.hh"
 
+#ifndef CUSZ_HOST_ONLY
+#include "../kernel/cpplaunch_cuda.hh"
+#endif
+
 #ifdef DPCPP_SHOWCASE
 #include "../kernel/lorenzo_prototype.cuh"
 
@@ -47,25 +55,37 @@ using cusz::prototype::x_lorenzo_3d1l;
 #define CONSTEXPR
 #endif
 
-#define ALLOCDEV(VAR, SYM, NBYTE)                    \
-    if (NBYTE != 0) {                                \
-        CHECK_CUDA(cudaMalloc(&d_##VAR, NBYTE));     \
-        CHECK_CUDA(cudaMemset(d_##VAR, 0x0, NBYTE)); \
+#define ALLOCDEV(VAR, SYM, NBYTE)                                                             \
+    if (NBYTE != 0) {                                                                         \
+        d_##VAR = reinterpret_cast<decltype(d_##VAR)>(mem->allocate(NBYTE, memkind::DEVICE)); \
+        CHECK_CUDA(cudaMemset(d_##VAR, 0x0, NBYTE));                                          \
+    }
+
+#define ALLOCDEV2(VAR, TYPE, LEN)                                            \
+    if (LEN != 0) {                                                          \
+        d_##VAR = (TYPE*)mem->allocate(sizeof(TYPE) * LEN, memkind::DEVICE); \
+        CHECK_CUDA(cudaMemset(d_##VAR, 0x0, sizeof(TYPE) * LEN));            \
     }
 
-#define ALLOCDEV2(VAR, TYPE, LEN)                                 \
-    if (LEN != 0) {                                               \
-        CHECK_CUDA(cudaMalloc(&d_##VAR, sizeof(TYPE) * LEN));     \
-        CHECK_CUDA(cudaMemset(d_##VAR, 0x0, sizeof(TYPE) * LEN)); \
+#define FREE_DEV_ARRAY(VAR)                        \
+    if (d_##VAR) {                                 \
+        mem->deallocate(d_##VAR, memkind::DEVICE); \
+        d_##VAR = nullptr;                         \
     }
 
-#define FREE_DEV_ARRAY(VAR)            \
-    if (d_##VAR) {                     \
-        CHECK_CUDA(cudaFree(d_##VAR)); \
-        d_##VAR = nullptr;             \
+// pageable on purpose: the host policy must work without a device
+#define ALLOCHOST2(VAR, TYPE, LEN)                                                  \
+    if (LEN != 0) {                                                                 \
+        h_##VAR = (TYPE*)mem->allocate(sizeof(TYPE) * LEN, memkind::HOST_PAGEABLE); \
+        memset(h_##VAR, 0x0, sizeof(TYPE) * LEN);                                   \
+    }
+
+#define FREE_HOST_ARRAY(VAR)                              \
+    if (h_##VAR) {                                        \
+        mem->deallocate(h_##VAR, memkind::HOST_PAGEABLE); \
+        h_##VAR = nullptr;                                \
     }
 
-#define DEFINE_ARRAY(VAR, TYPE) TYPE* d_##VAR{nullptr};
 #define THE_TYPE template <typename T, typename E, typename FP>
 #define IMPL PredictionUnified<T, E, FP>::impl
 
@@ -80,39 +100,88 @@ IMPL::~impl()
     FREE_DEV_ARRAY(anchor);
     FREE_DEV_ARRAY(errctrl);
     FREE_DEV_ARRAY(outlier);
+    FREE_DEV_ARRAY(outlier_idx);
+    FREE_DEV_ARRAY(outlier_num);
+
+    FREE_HOST_ARRAY(anchor);
+    FREE_HOST_ARRAY(errctrl);
+    FREE_HOST_ARRAY(outlier);
+    FREE_HOST_ARRAY(outlier_idx);
 }
 
 THE_TYPE
-void IMPL::clear_buffer() { cudaMemset(d_errctrl, 0x0, sizeof(E) * this->rtlen.assigned.quant); }
+void IMPL::set_memory_resource(memory_resource* _mem) { mem = _mem ? _mem : default_memory_resource(); }
 
 THE_TYPE
-void IMPL::init(cusz_predictortype predictor, size_t x, size_t y, size_t z, bool dbg_print)
+void IMPL::set_outlier_density_factor(int factor)
+{
+    if (factor < 1) throw std::runtime_error("Outlier density factor must be at least 1.");
+    outlier_density_factor = factor;
+}
+
+THE_TYPE
+void IMPL::clear_buffer()
+{
+    if (policy == CPU)
+        memset(h_errctrl, 0x0, sizeof(E) * this->rtlen.assigned.quant);
+#ifndef CUSZ_HOST_ONLY
+    else
+        cudaMemset(d_errctrl, 0x0, sizeof(E) * this->rtlen.assigned.quant);
+#endif
+}
+
+THE_TYPE
+void IMPL::init(
+    cusz_predictortype    predictor,
+    size_t                x,
+    size_t                y,
+    size_t                z,
+    bool                  dbg_print,
+    cusz_execution_policy policy)
 {
     auto len3 = dim3(x, y, z);
-    init(predictor, len3, dbg_print);
+    init(predictor, len3, dbg_print, policy);
 }
 
 THE_TYPE
-void IMPL::init(cusz_predictortype predictor, dim3 xyz, bool dbg_print)
+void IMPL::init(cusz_predictortype predictor, dim3 xyz, bool dbg_print, cusz_execution_policy policy)
 {
+    this->policy = policy;
     this->derive_alloclen(predictor, xyz);
 
+    // outliers are compacted as they are found, so only a fraction of the data length is reserved for them
+    outlier_cap = this->alloclen.assigned.outlier / outlier_density_factor;
+
     // allocate
-    ALLOCDEV2(anchor, T, this->alloclen.assigned.anchor);
-    ALLOCDEV2(errctrl, E, this->alloclen.assigned.quant);
-    ALLOCDEV2(outlier, T, this->alloclen.assigned.outlier);
+    if (policy == CPU) {
+        ALLOCHOST2(anchor, T, this->alloclen.assigned.anchor);
+        ALLOCHOST2(errctrl, E, this->alloclen.assigned.quant);
+        ALLOCHOST2(outlier, T, outlier_cap);
+        ALLOCHOST2(outlier_idx, uint32_t, outlier_cap);
+    }
+    else {
+#ifndef CUSZ_HOST_ONLY
+        ALLOCDEV2(anchor, T, this->alloclen.assigned.anchor);
+        ALLOCDEV2(errctrl, E, this->alloclen.assigned.quant);
+        ALLOCDEV2(outlier, T, outlier_cap);
+        ALLOCDEV2(outlier_idx, uint32_t, outlier_cap);
+        ALLOCDEV2(outlier_num, uint32_t, 1);
+#else
+        throw std::runtime_error("PredictionUnified: built without CUDA; use the host policy.");
+#endif
+    }
 
     if (dbg_print) this->debug_list_alloclen<T, E, FP>();
 }
 
 THE_TYPE
-E* IMPL::expose_quant() const { return d_errctrl; }
+E* IMPL::expose_quant() const { return policy == CPU ? h_errctrl : d_errctrl; }
 THE_TYPE
-E* IMPL::expose_errctrl() const { return d_errctrl; }
+E* IMPL::expose_errctrl() const { return policy == CPU ? h_errctrl : d_errctrl; }
 THE_TYPE
-T* IMPL::expose_anchor() const { return d_anchor; }
+T* IMPL::expose_anchor() const { return policy == CPU ? h_anchor : d_anchor; }
 THE_TYPE
-T* IMPL::expose_outlier() const { return d_outlier; }
+T* IMPL::expose_outlier() const { return policy == CPU ? h_outlier : d_outlier; }
 
 THE_TYPE
 void IMPL::construct(
@@ -122,36 +191,117 @@ void IMPL::construct(
     T**                ptr_anchor,
     E**                ptr_errctrl,
     T**                ptr_outlier,
+    uint32_t**         ptr_outlier_idx,
+    uint32_t*          num_outliers,
     double const       eb,
     int const          radius,
-    cudaStream_t       stream)
+    cudaStream_t       stream,
+    uint32_t*          out_freq,
+    int const          nbin)
 {
-    *ptr_anchor  = d_anchor;
-    *ptr_errctrl = d_errctrl;
-    *ptr_outlier = d_outlier;
+#ifdef CUSZ_HOST_ONLY
+    (void)stream;  // no device kernels to launch on it
+#endif
+
+    *ptr_anchor      = expose_anchor();
+    *ptr_errctrl     = expose_errctrl();
+    *ptr_outlier     = expose_outlier();
+    *ptr_outlier_idx = policy == CPU ? h_outlier_idx : d_outlier_idx;
+    *num_outliers    = 0;
 
     if (predictor == LorenzoI) {
         derive_rtlen(LorenzoI, len3);
         this->check_rtlen();
 
         // ad hoc placeholder
-        auto      anchor_len3  = dim3(0, 0, 0);
-        auto      errctrl_len3 = dim3(0, 0, 0);
-        uint32_t* outlier_idx  = nullptr;
+        auto anchor_len3  = dim3(0, 0, 0);
+        auto errctrl_len3 = dim3(0, 0, 0);
+
+        if (policy == CPU) {
+            compress_predict_lorenzo_i_cpu<T, E, FP>(
+                data, len3, eb, radius,                                              //
+                h_errctrl, errctrl_len3, h_anchor, anchor_len3,                      //
+                h_outlier, h_outlier_idx, num_outliers, outlier_cap, &time_elapsed,  //
+                out_freq, nbin);
+        }
+#ifndef CUSZ_HOST_ONLY
+        else {
+            compress_predict_lorenzo_i<T, E, FP>(
+                data, len3, eb, radius,                                               //
+                d_errctrl, errctrl_len3, d_anchor, anchor_len3,                       //
+                d_outlier, d_outlier_idx, d_outlier_num, outlier_cap, &time_elapsed,  //
+                stream);
+            CHECK_CUDA(cudaMemcpy(num_outliers, d_outlier_num, sizeof(uint32_t), cudaMemcpyDeviceToHost));
+        }
+#endif
 
-        compress_predict_lorenzo_i<T, E, FP>(
-            data, len3, eb, radius,                                                           //
-            d_errctrl, errctrl_len3, d_anchor, anchor_len3, d_outlier, outlier_idx, nullptr,  //
-            &time_elapsed, stream);
+        if (*num_outliers > outlier_cap)
+            throw std::runtime_error(
+                "Found " + std::to_string(*num_outliers) + " outliers, more than the " + std::to_string(outlier_cap) +
+                " reserved; lower the density factor.");
+    }
+    else if (predictor == LorenzoII) {
+        if (policy != CPU) throw std::runtime_error("LorenzoII runs only on host.");
+
+        derive_rtlen(LorenzoII, len3);
+        this->check_rtlen();
+
+        auto status = compress_predict_lorenzo_ii_cpu<T, E, FP>(
+            data, len3, eb, radius, h_errctrl,                                   //
+            h_outlier, h_outlier_idx, num_outliers, outlier_cap, &time_elapsed,  //
+            out_freq, nbin);
+
+        if (status != CUSZ_SUCCESS)
+            throw std::runtime_error(
+                "LorenzoII residuals are not exact in the data type at this error bound; use a larger one, or "
+                "LorenzoI.");
+        if (*num_outliers > outlier_cap)
+            throw std::runtime_error(
+                "Found " + std::to_string(*num_outliers) + " outliers, more than the " + std::to_string(outlier_cap) +
+                " reserved; lower the density factor.");
+    }
+    else if (predictor == Regression) {
+        if (policy != CPU) throw std::runtime_error("Regression runs only on host.");
+
+        this->derive_rtlen(Regression, len3);
+        this->check_rtlen();
+
+        auto status = compress_predict_regression_cpu<T, E, FP>(
+            data, len3, eb, radius, h_errctrl, h_anchor,                         //
+            h_outlier, h_outlier_idx, num_outliers, outlier_cap, &time_elapsed,  //
+            out_freq, nbin);
+
+        if (status != CUSZ_SUCCESS)
+            throw std::runtime_error(
+                "Lorenzo residuals are not exact in the data type at this error bound; use a larger one.");
+        if (*num_outliers > outlier_cap)
+            throw std::runtime_error(
+                "Found " + std::to_string(*num_outliers) + " outliers, more than the " + std::to_string(outlier_cap) +
+                " reserved; lower the density factor.");
     }
     else if (predictor == Spline3) {
         this->derive_rtlen(Spline3, len3);
         this->check_rtlen();
 
+        if (policy == CPU) {
+            compress_predict_spline3_cpu<T, E, FP>(
+                data, len3, eb, radius, h_errctrl, h_anchor, this->rtlen.anchor.len3,  //
+                h_outlier, h_outlier_idx, num_outliers, outlier_cap, &time_elapsed,    //
+                out_freq, nbin);
+
+            if (*num_outliers > outlier_cap)
+                throw std::runtime_error(
+                    "Found " + std::to_string(*num_outliers) + " outliers, more than the " +
+                    std::to_string(outlier_cap) + " reserved; lower the density factor.");
+            return;
+        }
+
+#ifndef CUSZ_HOST_ONLY
         cusz::cpplaunch_construct_Spline3<T, E, FP>(
             true,  //
             data, len3, d_anchor, this->rtlen.anchor.len3, d_errctrl, this->rtlen.aligned.len3, eb, radius,
             &time_elapsed, stream);
+#endif
     }
 }
 
@@ -166,6 +316,10 @@ void IMPL::reconstruct(
     int const          radius,
     cudaStream_t       stream)
 {
+#ifdef CUSZ_HOST_ONLY
+    (void)stream;  // no device kernels to launch on it
+#endif
+
     if (predictor == LorenzoI) {
         this->derive_rtlen(LorenzoI, len3);
         this->check_rtlen();
@@ -179,31 +333,112 @@ void IMPL::reconstruct(
 
         auto xdata_len3 = len3;
 
-        decompress_predict_lorenzo_i<T, E, FP>(
-            errctrl, errctrl_len3, anchor, anchor_len3, outlier, outlier_idx, 0, eb, radius,  //
-            xdata, xdata_len3,                                                                //
-            &time_elapsed, stream);
+        if (policy == CPU)
+            decompress_predict_lorenzo_i_cpu<T, E, FP>(
+                errctrl, errctrl_len3, anchor, anchor_len3, outlier, outlier_idx, 0, eb, radius,  //
+                xdata, xdata_len3,                                                                //
+                &time_elapsed);
+#ifndef CUSZ_HOST_ONLY
+        else
+            decompress_predict_lorenzo_i<T, E, FP>(
+                errctrl, errctrl_len3, anchor, anchor_len3, outlier, outlier_idx, 0, eb, radius,  //
+                xdata, xdata_len3,                                                                //
+                &time_elapsed, stream);
+#endif
+    }
+    else if (predictor == LorenzoII) {
+        if (policy != CPU) throw std::runtime_error("LorenzoII runs only on host.");
+
+        this->derive_rtlen(LorenzoII, len3);
+        this->check_rtlen();
+
+        decompress_predict_lorenzo_ii_cpu<T, E, FP>(errctrl, eb, radius, outlier_xdata, len3, &time_elapsed);
+    }
+    else if (predictor == Regression) {
+        if (policy != CPU) throw std::runtime_error("Regression runs only on host.");
+
+        this->derive_rtlen(Regression, len3);
+        this->check_rtlen();
+
+        decompress_predict_regression_cpu<T, E, FP>(errctrl, anchor, eb, radius, outlier_xdata, len3, &time_elapsed);
     }
     else if (predictor == Spline3) {
         this->derive_rtlen(Spline3, len3);
         this->check_rtlen();
         // this->debug_list_rtlen<T, E, FP>(true);
 
+        if (policy == CPU) {
+            decompress_predict_spline3_cpu<T, E, FP>(
+                errctrl, anchor, this->rtlen.anchor.len3, eb, radius, outlier_xdata, len3, &time_elapsed);
+            return;
+        }
+
+#ifndef CUSZ_HOST_ONLY
         // launch_reconstruct_Spline3<T, E, FP>(
         cusz::cpplaunch_reconstruct_Spline3<T, E, FP>(
             outlier_xdata, len3, anchor, this->rtlen.anchor.len3, errctrl, this->rtlen.aligned.len3, eb, radius,
             &time_elapsed, stream);
+#endif
     }
 }
 
+/**
+ * @brief (host) reconstruct the box [region_lo3, region_hi3), on Lorenzo tile boundaries, in place; errctrl and
+ * outlier_xdata hold the box only, x fastest
+ */
+THE_TYPE
+void IMPL::reconstruct_region(
+    cusz_predictortype predictor,
+    dim3               len3,
+    T*                 outlier_xdata,
+    E*                 errctrl,
+    double const       eb,
+    int const          radius,
+    dim3               region_lo3,
+    dim3               region_hi3)
+{
+    if (predictor != LorenzoI) throw std::runtime_error("Region decompression supports only Lorenzo.");
+    if (policy != CPU) throw std::runtime_error("Region decompression runs only on host.");
+
+    this->derive_rtlen(LorenzoI, len3);
+    this->check_rtlen();
+
+    decompress_predict_lorenzo_i_region_cpu<T, E, FP>(
+        errctrl, outlier_xdata, eb, radius, outlier_xdata, len3, region_lo3, region_hi3, &time_elapsed);
+}
+
+/**
+ * @brief (host) reconstruct elements [begin, end), a whole number of rows of Lorenzo tiles, in place; errctrl holds
+ * the codes of those elements only. It touches no state of the predictor (nor its timing), so disjoint slabs can be
+ * reconstructed concurrently, e.g., each right after its quant-codes are decoded.
+ */
+THE_TYPE
+void IMPL::reconstruct_slab(
+    cusz_predictortype predictor,
+    dim3               len3,
+    T*                 outlier_xdata,
+    E*                 errctrl,
+    double const       eb,
+    int const          radius,
+    size_t const       begin,
+    size_t const       end)
+{
+    if (predictor != LorenzoI) throw std::runtime_error("Slab reconstruction supports only Lorenzo.");
+    if (policy != CPU) throw std::runtime_error("Slab reconstruction runs only on host.");
+
+    decompress_predict_lorenzo_i_slab_cpu<T, E, FP>(errctrl, outlier_xdata, eb, radius, outlier_xdata, len3, begin, end);
+}
+
 THE_TYPE
 float IMPL::get_time_elapsed() const { return time_elapsed; }
 
 }  // namespace cusz
 
 #undef ALLOCDEV
+#undef ALLOCDEV2
+#undef ALLOCHOST2
 #undef FREE_DEV_ARRAY
-#undef DEFINE_ARRAY
+#undef FREE_HOST_ARRAY
 
 #undef THE_TYPE
 #undef IMPL
@@ -12,31 +12,60 @@
 #ifndef CUSZ_COMPONENT_SPVEC_CUH
 #define CUSZ_COMPONENT_SPVEC_CUH
 
+#include <stdexcept>
+#include <string>
+
+#ifndef CUSZ_HOST_ONLY
 #include <thrust/count.h>
 #include <thrust/device_vector.h>
 #include <thrust/execution_policy.h>
+#endif
 
 #include "../common.hh"
 #include "../component/spcodec_vec.hh"
-#include "../kernel/spv_gpu.hh"
+#include "../kernel/spv_cpu.hh"
+#include "../kernel/spv_idx.hh"
 // #include "../kernel/launch_spv.cuh"
 
+#ifndef CUSZ_HOST_ONLY
+#include "../kernel/spv_gpu.hh"
 #include "utils/cuda_err.cuh"
+#endif
 
-#define SPVEC_ALLOCDEV(VAR, SYM)                           \
-    CHECK_CUDA(cudaMalloc(&d_##VAR, rte.nbyte[RTE::SYM])); \
+#define SPVEC_ALLOC(VAR, SYM, KIND) \
+    VAR = reinterpret_cast<decltype(VAR)>(mem->allocate(rte.nbyte[RTE::SYM], memkind::KIND));
+
+#define SPVEC_ALLOCDEV(VAR, SYM)       \
+    SPVEC_ALLOC(d_##VAR, SYM, DEVICE); \
     CHECK_CUDA(cudaMemset(d_##VAR, 0x0, rte.nbyte[RTE::SYM]));
 
-#define SPVEC_FREEDEV(VAR)             \
-    if (d_##VAR) {                     \
-        CHECK_CUDA(cudaFree(d_##VAR)); \
-        d_##VAR = nullptr;             \
+#define SPVEC_FREEDEV(VAR)                         \
+    if (d_##VAR) {                                 \
+        mem->deallocate(d_##VAR, memkind::DEVICE); \
+        d_##VAR = nullptr;                         \
+    }
+
+#define SPVEC_ALLOCHOST(VAR, SYM)             \
+    SPVEC_ALLOC(h_##VAR, SYM, HOST_PAGEABLE); \
+    memset(h_##VAR, 0x0, rte.nbyte[RTE::SYM]);
+
+#define SPVEC_FREEHOST(VAR)                               \
+    if (h_##VAR) {                                        \
+        mem->deallocate(h_##VAR, memkind::HOST_PAGEABLE); \
+        h_##VAR = nullptr;                                \
+    }
+
+#define SPVEC_H2HCPY(SRC, FIELD)                          \
+    {                                                     \
+        auto dst = h_spfmt + header.entry[Header::FIELD]; \
+        auto src = reinterpret_cast<BYTE*>(SRC);          \
+        memcpy(dst, src, nbyte[Header::FIELD]);           \
     }
 
-#define SPVEC_D2DCPY(VAR, FIELD)                                                                       \
+#define SPVEC_D2DCPY(SRC, FIELD)                                                                       \
     {                                                                                                  \
         auto dst = d_spfmt + header.entry[Header::FIELD];                                              \
-        auto src = reinterpret_cast<BYTE*>(d_##VAR);                                                   \
+        auto src = reinterpret_cast<BYTE*>(SRC);                                                       \
         CHECK_CUDA(cudaMemcpyAsync(dst, src, nbyte[Header::FIELD], cudaMemcpyDeviceToDevice, stream)); \
     }
 
@@ -48,26 +77,53 @@ SpcodecVec<T, M>::impl::~impl()
     SPVEC_FREEDEV(spfmt);
     SPVEC_FREEDEV(idx);
     SPVEC_FREEDEV(val);
+
+    SPVEC_FREEHOST(spfmt);
+    SPVEC_FREEHOST(idx);
+    SPVEC_FREEHOST(val);
 }
 
 // public methods
 
 template <typename T, typename M>
-void SpcodecVec<T, M>::impl::init(size_t const len, int density_factor, bool dbg_print)
+void SpcodecVec<T, M>::impl::set_memory_resource(memory_resource* _mem)
+{
+    mem = _mem ? _mem : default_memory_resource();
+}
+
+template <typename T, typename M>
+void SpcodecVec<T, M>::impl::set_value_coding(cusz_spcodec_valcoding coding)
+{
+    val_coding = (accsz::spv_valcoding)coding;
+}
+
+template <typename T, typename M>
+void SpcodecVec<T, M>::impl::init(size_t const len, int density_factor, bool dbg_print, cusz_execution_policy policy)
 {
-    auto max_bytes = [&]() { return len / density_factor * sizeof(T); };
-    auto init_nnz  = [&]() { return len / density_factor; };
+    auto init_nnz = [&]() { return len / density_factor; };
 
     memset(rte.nbyte, 0, sizeof(uint32_t) * RTE::END);
     rte.nnz = init_nnz();
 
-    rte.nbyte[RTE::SPFMT] = max_bytes();
     rte.nbyte[RTE::IDX]   = rte.nnz * sizeof(int);
     rte.nbyte[RTE::VAL]   = rte.nnz * sizeof(T);
+    // see subfile_collect; packed idx is padded to 8 bytes, and coded val is never shorter than raw
+    rte.nbyte[RTE::SPFMT] =
+        128 + accsz::spv_idx_layout::max_nbyte(rte.nnz) + 8 + accsz::spv_val_layout<T>::max_nbyte(rte.nnz);
 
-    SPVEC_ALLOCDEV(spfmt, SPFMT);
-    SPVEC_ALLOCDEV(idx, IDX);
-    SPVEC_ALLOCDEV(val, VAL);
+    this->policy = policy;
+
+    // idx and val are allocated on the first encode() of a dense input; compacted input comes with its own
+    if (policy == CPU) {
+        SPVEC_ALLOCHOST(spfmt, SPFMT);
+    }
+    else {
+#ifndef CUSZ_HOST_ONLY
+        SPVEC_ALLOCDEV(spfmt, SPFMT);
+#else
+        throw std::runtime_error("SpcodecVec: built without CUDA; use the host policy.");
+#endif
+    }
 
     // if (dbg_print) debug();
 }
@@ -83,10 +139,53 @@ void SpcodecVec<T, M>::impl::encode(
 {
     Header header;
 
-    accsz::spv_gather<T, M>(in, in_len, this->d_val, this->d_idx, &rte.nnz, &milliseconds, stream);
+    if (policy == CPU) {
+        if (not h_idx) {
+            SPVEC_ALLOCHOST(idx, IDX);
+            SPVEC_ALLOCHOST(val, VAL);
+        }
+        accsz::spv_gather_cpu<T, M>(in, in_len, this->h_val, this->h_idx, &rte.nnz, &milliseconds);
+        subfile_collect(header, in_len, h_val, h_idx, stream, dbg_print);
+    }
+    else {
+#ifndef CUSZ_HOST_ONLY
+        if (not d_idx) {
+            SPVEC_ALLOCDEV(idx, IDX);
+            SPVEC_ALLOCDEV(val, VAL);
+        }
+        accsz::spv_gather<T, M>(in, in_len, this->d_val, this->d_idx, &rte.nnz, &milliseconds, stream);
+        subfile_collect(header, in_len, d_val, d_idx, stream, dbg_print);
+#endif
+    }
 
-    subfile_collect(header, in_len, stream, dbg_print);
-    out     = d_spfmt;
+    out     = policy == CPU ? h_spfmt : d_spfmt;
+    out_len = header.subfile_size();
+}
+
+template <typename T, typename M>
+void SpcodecVec<T, M>::impl::encode_compacted(
+    T*           val,
+    uint32_t*    idx,
+    int const    nnz,
+    size_t const len,
+    BYTE*&       out,
+    size_t&      out_len,
+    cudaStream_t stream,
+    bool         dbg_print)
+{
+    Header header;
+
+    // the format keeps idx ascending (see decode_region), which compaction does not
+    rte.nnz = nnz;
+    if (policy == CPU)
+        accsz::spv_sort_cpu<T, M>(val, idx, nnz, &milliseconds);
+#ifndef CUSZ_HOST_ONLY
+    else
+        accsz::spv_sort<T, M>(val, idx, nnz, &milliseconds, stream);
+#endif
+
+    subfile_collect(header, len, val, idx, stream, dbg_print);
+    out     = policy == CPU ? h_spfmt : d_spfmt;
     out_len = header.subfile_size();
 }
 
@@ -94,22 +193,78 @@ template <typename T, typename M>
 void SpcodecVec<T, M>::impl::decode(BYTE* coded, T* decoded, cudaStream_t stream)
 {
     header_t header;
-    CHECK_CUDA(cudaMemcpyAsync(&header, coded, sizeof(header), cudaMemcpyDeviceToHost, stream));
+    if (policy == CPU)
+        memcpy(&header, coded, sizeof(header));
+#ifndef CUSZ_HOST_ONLY
+    else {
+        CHECK_CUDA(cudaMemcpyAsync(&header, coded, sizeof(header), cudaMemcpyDeviceToHost, stream));
+        CHECK_CUDA(cudaStreamSynchronize(stream));
+    }
+#endif
+    check_version(header);
 
 #define ACCESSOR(SYM, TYPE) reinterpret_cast<TYPE*>(coded + header.entry[Header::SYM])
     auto d_idx = ACCESSOR(IDX, uint32_t);
-    auto d_val = ACCESSOR(VAL, T);
+    auto d_val = ACCESSOR(VAL, uint8_t);
 #undef ACCESSOR
 
-    accsz::spv_scatter<T, M>(d_val, d_idx, header.nnz, decoded, &milliseconds, stream);
+    if (header.get_version() == 1) {
+        if (policy == CPU)
+            accsz::spv_scatter_cpu<T, M>((T*)d_val, d_idx, header.nnz, decoded, &milliseconds);
+#ifndef CUSZ_HOST_ONLY
+        else
+            accsz::spv_scatter<T, M>((T*)d_val, d_idx, header.nnz, decoded, &milliseconds, stream);
+#endif
+        return;
+    }
+
+    auto coding = (accsz::spv_valcoding)header.val_coding;
+    if (policy == CPU)
+        accsz::spv_scatter_packed_cpu<T, M>(d_val, coding, d_idx, header.nnz, decoded, &milliseconds);
+#ifndef CUSZ_HOST_ONLY
+    else
+        accsz::spv_scatter_packed<T, M>(d_val, coding, d_idx, header.nnz, decoded, &milliseconds, stream);
+#endif
+}
+
+// idx is stored in ascending order (gathered in order, or sorted), so blocks of it are located by binary search
+template <typename T, typename M>
+void SpcodecVec<T, M>::impl::decode_region(BYTE* coded, size_t const* ranges, size_t const nrange, T* decoded)
+{
+    header_t header;
+    memcpy(&header, coded, sizeof(header));
+    check_version(header);
+
+#define ACCESSOR(SYM, TYPE) reinterpret_cast<TYPE*>(coded + header.entry[Header::SYM])
+    auto h_idx = ACCESSOR(IDX, uint32_t);
+    auto h_val = ACCESSOR(VAL, uint8_t);
+#undef ACCESSOR
+
+    if (header.get_version() == 1) {
+        accsz::spv_scatter_ranges_cpu<T, M>((T*)h_val, h_idx, header.nnz, ranges, nrange, decoded, &milliseconds);
+        return;
+    }
+
+    auto coding = (accsz::spv_valcoding)header.val_coding;
+    accsz::spv_scatter_packed_ranges_cpu<T, M>(
+        h_val, coding, h_idx, header.nnz, ranges, nrange, decoded, &milliseconds);
 }
 
 template <typename T, typename M>
 void SpcodecVec<T, M>::impl::clear_buffer()
 {
+    if (policy == CPU) {
+        memset(h_spfmt, 0x0, rte.nbyte[RTE::SPFMT]);
+        if (h_idx) memset(h_idx, 0x0, rte.nbyte[RTE::IDX]);
+        if (h_val) memset(h_val, 0x0, rte.nbyte[RTE::VAL]);
+        return;
+    }
+
+#ifndef CUSZ_HOST_ONLY
     cudaMemset(d_spfmt, 0x0, rte.nbyte[RTE::SPFMT]);
-    cudaMemset(d_idx, 0x0, rte.nbyte[RTE::IDX]);
-    cudaMemset(d_val, 0x0, rte.nbyte[RTE::VAL]);
+    if (d_idx) cudaMemset(d_idx, 0x0, rte.nbyte[RTE::IDX]);
+    if (d_val) cudaMemset(d_val, 0x0, rte.nbyte[RTE::VAL]);
+#endif
 }
 
 // getter
@@ -122,20 +277,67 @@ float SpcodecVec<T, M>::impl::get_time_elapsed() const
 // helper
 
 template <typename T, typename M>
-void SpcodecVec<T, M>::impl::subfile_collect(Header& header, size_t len, cudaStream_t stream, bool dbg_print)
+void SpcodecVec<T, M>::impl::check_version(Header const& header)
+{
+    auto const version = header.get_version();
+    if (version > Header::VERSION)
+        throw std::runtime_error(
+            "SpcodecVec: subfile version " + std::to_string(version) + " is newer than this build reads (" +
+            std::to_string(Header::VERSION) + ").");
+
+    auto const coding = (accsz::spv_valcoding)header.val_coding;
+    if (version > 1 and coding != accsz::spv_valcoding::RAW and coding != accsz::spv_valcoding::XOR)
+        throw std::runtime_error("SpcodecVec: unknown value coding " + std::to_string(header.val_coding) + ".");
+}
+
+template <typename T, typename M>
+void SpcodecVec<T, M>::impl::subfile_collect(
+    Header&      header,
+    size_t       len,
+    T*           val,
+    uint32_t*    idx,
+    cudaStream_t stream,
+    bool         dbg_print)
 {
+#ifdef CUSZ_HOST_ONLY
+    (void)stream;  // no device copies to order on it
+#endif
+
+    memset(&header, 0x0, sizeof(Header));  // padding included, so equal inputs give equal bytes
     header.header_nbyte     = sizeof(Header);
     header.uncompressed_len = len;
     header.nnz              = rte.nnz;
+    header.version          = Header::VERSION;
+    header.val_coding       = (int)val_coding;
 
-    // update (redundant here)
-    rte.nbyte[RTE::IDX] = sizeof(int) * rte.nnz;
-    rte.nbyte[RTE::VAL] = sizeof(T) * rte.nnz;
+    // idx and val are coded in place, idx right after the header and val after it, 8-byte aligned
+    auto  spfmt      = policy == CPU ? h_spfmt : d_spfmt;
+    auto  packed_idx = reinterpret_cast<uint32_t*>(spfmt + 128);
+    float ms_idx, ms_val{0};
 
+    // rte.nbyte keeps the allocated sizes
     MetadataT nbyte[Header::END];
     nbyte[Header::HEADER] = 128;
-    nbyte[Header::IDX]    = rte.nbyte[RTE::IDX];
-    nbyte[Header::VAL]    = rte.nbyte[RTE::VAL];
+    if (policy == CPU)
+        nbyte[Header::IDX] = accsz::spv_idx_pack_cpu(idx, rte.nnz, packed_idx, &ms_idx);
+#ifndef CUSZ_HOST_ONLY
+    else
+        nbyte[Header::IDX] = accsz::spv_idx_pack(idx, rte.nnz, packed_idx, &ms_idx, stream);
+#endif
+    nbyte[Header::IDX] = (nbyte[Header::IDX] + 7) / 8 * 8;
+
+    auto coded_val     = spfmt + 128 + nbyte[Header::IDX];
+    nbyte[Header::VAL] = sizeof(T) * rte.nnz;
+    if (val_coding == accsz::spv_valcoding::XOR) {
+        if (policy == CPU)
+            nbyte[Header::VAL] = accsz::spv_val_xor_cpu<T, M>(val, rte.nnz, coded_val, &ms_val);
+#ifndef CUSZ_HOST_ONLY
+        else
+            nbyte[Header::VAL] = accsz::spv_val_xor<T, M>(val, rte.nnz, coded_val, &ms_val, stream);
+#endif
+    }
+
+    milliseconds += ms_idx + ms_val;
 
     header.entry[0] = 0;
     // *.END + 1; need to knwo the ending position
@@ -157,14 +359,23 @@ void SpcodecVec<T, M>::impl::subfile_collect(Header& header, size_t len, cudaStr
     };
     if (dbg_print) debug_header_entry();
 
+    if (policy == CPU) {
+        memcpy(h_spfmt, &header, sizeof(header));
+
+        if (val_coding == accsz::spv_valcoding::RAW) SPVEC_H2HCPY(val, VAL)
+
+        return;
+    }
+
+#ifndef CUSZ_HOST_ONLY
     CHECK_CUDA(cudaMemcpyAsync(d_spfmt, &header, sizeof(header), cudaMemcpyHostToDevice, stream));
 
     /* debug */ CHECK_CUDA(cudaStreamSynchronize(stream));
 
-    SPVEC_D2DCPY(idx, IDX)
-    SPVEC_D2DCPY(val, VAL)
+    if (val_coding == accsz::spv_valcoding::RAW) SPVEC_D2DCPY(val, VAL)
 
     /* debug */ CHECK_CUDA(cudaStreamSynchronize(stream));
+#endif
 }
 
 }  // namespace cusz
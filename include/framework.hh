@@ -42,11 +42,15 @@ struct PredefinedCombination {
     struct CompressorTemplate;
 
     /* Predictor */
-    using PredictionUnified = typename cusz::PredictionUnified<DATA, ERRCTRL, FP>;
-    // using PredictorSpline3 = typename cusz::PredictorSpline3<DATA, ERRCTRL, FP>;
+    using PredictionUnified   = typename cusz::PredictionUnified<DATA, ERRCTRL, FP>;
+    using PredictorLorenzoII  = typename cusz::PredictorLorenzoII<DATA, ERRCTRL, FP>;
+    using PredictorRegression = typename cusz::PredictorRegression<DATA, ERRCTRL, FP>;
+    using PredictorSpline3    = typename cusz::PredictorSpline3<DATA, ERRCTRL, FP>;
 
     /* Lossless Spcodec */
+#ifndef CUSZ_HOST_ONLY
     using SpcodecMat = typename cusz::SpcodecCSR<DATA, Meta4>;
+#endif
     using SpcodecVec = typename cusz::SpcodecVec<DATA, Meta4>;
 
     /* Lossless Codec*/
@@ -54,9 +58,11 @@ struct PredefinedCombination {
     using CodecHuffman64 = cusz::LosslessCodec<ERRCTRL, Huff8, Meta4>;
 
     /* Predefined Combination */
-    using LorenzoFeatured = CompressorTemplate<PredictionUnified, SpcodecVec, CodecHuffman32, CodecHuffman64>;
+    using LorenzoFeatured    = CompressorTemplate<PredictionUnified, SpcodecVec, CodecHuffman32, CodecHuffman64>;
     // using LorenzoFeatured = CompressorTemplate<PredictionUnified, SpcodecMat, CodecHuffman32, CodecHuffman64>;
-    // using Spline3Featured = CompressorTemplate<PredictorSpline3, SpcodecVec, CodecHuffman32, CodecHuffman64>;
+    using LorenzoIIFeatured  = CompressorTemplate<PredictorLorenzoII, SpcodecVec, CodecHuffman32, CodecHuffman64>;
+    using RegressionFeatured = CompressorTemplate<PredictorRegression, SpcodecVec, CodecHuffman32, CodecHuffman64>;
+    using Spline3Featured    = CompressorTemplate<PredictorSpline3, SpcodecVec, CodecHuffman32, CodecHuffman64>;
 };
 
 template <typename InputDataType>
@@ -110,10 +116,12 @@ struct PredefinedCombination<InputDataType>::CompressorTemplate {
 template <typename DATA = float>
 struct Framework {
     /* Usable Compressor */
-    using DefaultCompressor         = class Compressor<typename PredefinedCombination<DATA>::LorenzoFeatured>;
-    using LorenzoFeaturedCompressor = class Compressor<typename PredefinedCombination<DATA>::LorenzoFeatured>;
-    // in progress
-    // using Spline3FeaturedCompressor = class Compressor<typename PredefinedCombination<DATA>::Spline3Featured>;
+    using DefaultCompressor            = class Compressor<typename PredefinedCombination<DATA>::LorenzoFeatured>;
+    using LorenzoFeaturedCompressor    = class Compressor<typename PredefinedCombination<DATA>::LorenzoFeatured>;
+    // host only, for now
+    using LorenzoIIFeaturedCompressor  = class Compressor<typename PredefinedCombination<DATA>::LorenzoIIFeatured>;
+    using RegressionFeaturedCompressor = class Compressor<typename PredefinedCombination<DATA>::RegressionFeatured>;
+    using Spline3FeaturedCompressor    = class Compressor<typename PredefinedCombination<DATA>::Spline3Featured>;
 };
 
 }  // namespace cusz
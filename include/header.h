@@ -21,6 +21,7 @@ extern "C" {
 #include <stddef.h>
 #include <stdint.h>
 #include <stdlib.h>
+#include <string.h>
 
 typedef struct alignas(128) cusz_header {
     static const int HEADER = 0;
@@ -29,6 +30,9 @@ typedef struct alignas(128) cusz_header {
     static const int SPFMT  = 3;
     static const int END    = 4;
 
+    // 2: adds `predictor`, and Spline3 anchors every spline3_anchor_stride() points in 1D and 2D (every 8 before)
+    static const uint32_t VERSION = 2;
+
     uint32_t header_nbyte : 8;
     uint32_t fp : 1;
     uint32_t byte_uncompressed : 4;  // T; 1, 2, 4, 8
@@ -47,9 +51,17 @@ typedef struct alignas(128) cusz_header {
     size_t   data_len;
     size_t   errctrl_len;
     uint32_t radius : 16;
+    uint32_t predictor : 4;  // cusz_predictortype; since version 2
 
     uint32_t entry[END + 1];
 
+    // since version 2; version-1 writers left these bytes unset, so a header without the magic is of version 1
+    char     magic[4];  // "CUSZ"
+    uint32_t version;
+
+    void     set_version() { memcpy(magic, "CUSZ", 4), version = VERSION; }
+    uint32_t get_version() const { return memcmp(magic, "CUSZ", 4) == 0 ? version : 1; }
+
 } cusz_header;
 
 typedef cusz_header cuszHEADER;
@@ -12,11 +12,15 @@
 #ifndef CUSZ_COMPONENT_CODECS_HH
 #define CUSZ_COMPONENT_CODECS_HH
 
-#include <cuda_runtime.h>
+#include "cusz/cuda_compat.h"
 #include <cstdint>
+#include <functional>
 #include <memory>
 
+#include "cusz/type.h"
+#include "hf/hf_bookcache.hh"
 #include "hf/hf_struct.h"
+#include "utils/mempool.hh"
 
 #define DEFINE_ARRAY(VAR, TYPE) \
     TYPE* d_##VAR{nullptr};     \
@@ -47,10 +51,20 @@ class LosslessCodec
     LosslessCodec(LosslessCodec&&);                  // move ctor
     LosslessCodec& operator=(LosslessCodec&&);       // move assign
 
-    void init(size_t const, int const, int const, bool dbg_print = false);
+    // before init(); buffers come from the default memory resource otherwise
+    void set_memory_resource(memory_resource*);
+    // before init(); each chunk but the last then holds a multiple of this many symbols
+    void set_chunk_alignment(size_t const);
+    // (host) reuse a cached book for a near-identical histogram, not only for the same one; see hf_bookcache
+    void set_approximate_bookcache(bool const);
+    void init(size_t const, int const, int const, bool dbg_print = false, cusz_execution_policy = CUDA);
     void build_codebook(uint32_t*, int const, cudaStream_t = nullptr);
     void encode(T*, size_t const, BYTE*&, size_t&, cudaStream_t = nullptr);
     void decode(BYTE*, T*, cudaStream_t = nullptr, bool = true);
+    // (host) decode only the chunks overlapping the ascending [begin, end) element ranges; out holds the ranges only
+    void decode_region(BYTE*, size_t const*, size_t const, T*);
+    // (host) hand each decoded chunk to a consumer; false, with nothing decoded, if chunks are not aligned as asked
+    bool decode_chunkwise(BYTE*, size_t const, std::function<void(size_t, size_t, T*)> const&);
     void clear_buffer();
 
     float get_time_elapsed() const;
@@ -130,10 +144,18 @@ class LosslessCodec<T, H, M>::impl {
     float milliseconds{0.0};
     float time_hist{0.0}, time_book{0.0}, time_lossless{0.0};
 
-    hf_book*      book_desc;
-    hf_chunk*     chunk_desc_d;
-    hf_chunk*     chunk_desc_h;
-    hf_bitstream* bitstream_desc;
+    // of init(); on host, chunk_desc_d and chunk_desc_h are one
+    hf_book*      book_desc{nullptr};
+    hf_chunk*     chunk_desc_d{nullptr};
+    hf_chunk*     chunk_desc_h{nullptr};
+    hf_bitstream* bitstream_desc{nullptr};
+
+    cusz_execution_policy policy{CUDA};
+    memory_resource*      mem{default_memory_resource()};
+    size_t                chunk_align{1};
+
+    // (host) skips book construction for a histogram seen recently
+    asz::hf_bookcache bookcache;
 
    public:
     ~impl();  // dtor
@@ -152,10 +174,15 @@ class LosslessCodec<T, H, M>::impl {
     // compile-time
     constexpr bool can_overlap_input_and_firstphase_encode();
     // public methods
-    void init(size_t const, int const, int const, bool dbg_print = false);
+    void set_memory_resource(memory_resource*);
+    void set_chunk_alignment(size_t const);
+    void set_approximate_bookcache(bool const);
+    void init(size_t const, int const, int const, bool dbg_print = false, cusz_execution_policy = CUDA);
     void build_codebook(uint32_t*, int const, cudaStream_t = nullptr);
     void encode(T*, size_t const, BYTE*&, size_t&, cudaStream_t = nullptr);
     void decode(BYTE*, T*, cudaStream_t = nullptr, bool = true);
+    void decode_region(BYTE*, size_t const*, size_t const, T*);
+    bool decode_chunkwise(BYTE*, size_t const, std::function<void(size_t, size_t, T*)> const&);
     void clear_buffer();
 
    private:
@@ -0,0 +1,42 @@
+/**
+ * @file hf_book_cpu.hh
+ * @author Jiannan Tian
+ * @brief Host counterpart of the parallel Huffman codebook construction.
+ * @version 0.3
+ * @date 2022-12-08
+ *
+ * (C) 2022 by Indiana University, Argonne National Laboratory
+ *
+ */
+
+#ifndef E0C1B7D6_3A59_4F0E_8C71_2B9E5D4F6A83
+#define E0C1B7D6_3A59_4F0E_8C71_2B9E5D4F6A83
+
+#include <cstdint>
+
+namespace asz {
+
+/**
+ * @brief get codebook and reverse codebook on host; the layouts of both are identical to `hf_buildbook_g`
+ *
+ * @tparam T input type
+ * @tparam H codebook type
+ * @param freq input host array; frequency (not modified)
+ * @param booksize dictionary size; len of freq or codebook
+ * @param codebook output host array; codebook for encoding
+ * @param reverse_codebook output host array; reverse codebook for decoding
+ * @param revbook_nbyte size of reverse_codebook in bytes
+ * @param time_book the returned time
+ */
+template <typename T, typename H>
+void hf_buildbook_cpu(
+    uint32_t* freq,
+    int const booksize,
+    H*        codebook,
+    uint8_t*  reverse_codebook,
+    int const revbook_nbyte,
+    float*    time_book);
+
+}  // namespace asz
+
+#endif /* E0C1B7D6_3A59_4F0E_8C71_2B9E5D4F6A83 */
@@ -0,0 +1,93 @@
+/**
+ * @file hf_bookcache.hh
+ * @author Jiannan Tian
+ * @brief LRU cache of Huffman codebooks keyed by the histogram.
+ * @version 0.3
+ * @date 2022-12-12
+ *
+ * (C) 2022 by Indiana University, Argonne National Laboratory
+ *
+ */
+
+#ifndef A3F8D1C2_7E4B_4C6A_9B05_D2E61F7C8A49
+#define A3F8D1C2_7E4B_4C6A_9B05_D2E61F7C8A49
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <vector>
+
+namespace asz {
+
+/**
+ * @brief Codebooks of recently seen histograms. By default the key is the exact histogram, so a hit returns the very
+ * book the builder would have produced and the output does not depend on what was compressed before. Lookups compare
+ * the full histogram; the hash only skips entries early.
+ *
+ * In approximate mode (opt-in), the key is the power-of-two magnitude of each bin, and an entry matches if no bin
+ * differs by more than one magnitude, so near-identical histograms, e.g. of consecutive timesteps, hit however their
+ * bins straddle powers of two. A hit is taken only if the cached book has a codeword for every nonzero bin: the book
+ * is then valid but not necessarily optimal, and the output depends on what was compressed before.
+ */
+class hf_bookcache {
+   public:
+    using fingerprint_t = std::vector<uint32_t>;
+
+    explicit hf_bookcache(size_t capacity = 8) : capacity(capacity) {}
+
+    // entries are keyed by mode, so switching it empties the cache
+    void set_approximate(bool const);
+    bool is_approximate() const { return approximate; }
+
+    void fingerprint(uint32_t const* freq, int const booklen, fingerprint_t& fp, uint64_t& hash) const;
+
+    /**
+     * @brief on hit, copy the cached book and revbook out and mark the entry most recently used; in approximate mode,
+     * entries are scanned in full rather than skipped by hash
+     * @param freq the histogram `fp` was taken from; in approximate mode, checked against the cached book
+     * @return true on hit
+     */
+    bool lookup(
+        uint32_t const*      freq,
+        fingerprint_t const& fp,
+        uint64_t const       hash,
+        uint8_t*             book,
+        size_t const         book_nbyte,
+        uint8_t*             revbook,
+        size_t const         revbook_nbyte);
+
+    // insert as the most recently used entry; the least recently used one is evicted when full
+    void insert(
+        fingerprint_t const& fp,
+        uint64_t const       hash,
+        uint8_t const*       book,
+        size_t const         book_nbyte,
+        uint8_t const*       revbook,
+        size_t const         revbook_nbyte);
+
+    void   clear() { entries.clear(); }
+    size_t size() const { return entries.size(); }
+    size_t get_hits() const { return hits; }
+    size_t get_misses() const { return misses; }
+
+   private:
+    struct entry {
+        uint64_t             hash;
+        fingerprint_t        fp;
+        std::vector<uint8_t> book, revbook;
+    };
+
+    std::list<entry> entries;  // front is the most recently used
+    size_t           capacity;
+    size_t           hits{0}, misses{0};
+    bool             approximate{false};
+
+    // whether no bin of two approximate fingerprints differs by more than one magnitude
+    static bool close(fingerprint_t const&, fingerprint_t const&);
+    // whether `book` has a codeword for every symbol of nonzero frequency
+    static bool covers(uint8_t const* book, size_t const book_nbyte, uint32_t const* freq, size_t const booklen);
+};
+
+}  // namespace asz
+
+#endif /* A3F8D1C2_7E4B_4C6A_9B05_D2E61F7C8A49 */
@@ -16,6 +16,10 @@
 #ifndef PAR_HUFFMAN_H
 #define PAR_HUFFMAN_H
 
+namespace cusz {
+class memory_resource;
+}
+
 // Parallel huffman global memory and kernels
 namespace asz {
 
@@ -29,6 +33,7 @@ namespace asz {
  * @param dict_size dictionary size; len of freq or codebook
  * @param reverse_codebook output device array; reverse codebook for decoding
  * @param time_book the returned time
+ * @param mem where the device workspace comes from; the default memory resource if null
  */
 template <typename T, typename H>
 void hf_buildbook_g(
@@ -38,7 +43,8 @@ void hf_buildbook_g(
     uint8_t*  reverse_codebook,
     int const revbook_nbyte,
     float*    time_book,
-    cudaStream_t = nullptr);
+    cudaStream_t           = nullptr,
+    cusz::memory_resource* = nullptr);
 
 }  // namespace asz
 
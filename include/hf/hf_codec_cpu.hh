@@ -0,0 +1,78 @@
+/**
+ * @file hf_codec_cpu.hh
+ * @author Jiannan Tian
+ * @brief Host counterpart of the coarse-grained Huffman encoder and decoder.
+ * @version 0.3
+ * @date 2022-12-08
+ *
+ * (C) 2022 by Indiana University, Argonne National Laboratory
+ *
+ */
+
+#ifndef F3A8D2B1_7C64_4E19_A5B0_9D1E6C4F2B37
+#define F3A8D2B1_7C64_4E19_A5B0_9D1E6C4F2B37
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <functional>
+
+#include "hf_struct.h"
+
+namespace asz {
+
+/**
+ * @brief encode on host; all descriptors point to host arrays. The bitstream is identical to that of
+ * `hf_encode_coarse_rev1` given the same codebook, sublen and pardeg.
+ * @param out_compressed, out_compressed_len unused, as in hf_encode_coarse_rev1; the caller collects the subfile
+ */
+template <typename T, typename H, typename M>
+void hf_encode_coarse_cpu(
+    T*            uncompressed,
+    size_t const  len,
+    hf_book*      book_desc,
+    hf_bitstream* bitstream_desc,
+    uint8_t*&     out_compressed,
+    size_t&       out_compressed_len,
+    float&        time_lossless);
+
+/**
+ * @brief decode on host, one chunk per thread; codewords are resolved by a prefix lookup table built from revbook
+ * @param revbook_nbyte unused; revbook is laid out by its codebook width alone
+ */
+template <typename T, typename H, typename M>
+void hf_decode_coarse_cpu(
+    H*        bitstream,
+    uint8_t*  revbook,
+    int const revbook_nbyte,
+    M*        par_nbit,
+    M*        par_entry,
+    int const sublen,
+    int const pardeg,
+    T*        out_decompressed,
+    float&    time_lossless);
+
+/**
+ * @brief decode on host chunk by chunk into a per-thread buffer, handing each chunk to `consume` right after it is
+ * decoded instead of writing the full-length output
+ * @param consume called concurrently as consume(begin, end, quant), quant holding the symbols of elements
+ * [begin, end); the buffer is reused once it returns
+ * @param revbook_nbyte unused, as in hf_decode_coarse_cpu
+ * @param chunk_mask optional (len of pardeg); when given, only chunks with a nonzero flag are decoded
+ */
+template <typename T, typename H, typename M>
+void hf_decode_chunkwise_cpu(
+    H*                                             bitstream,
+    uint8_t*                                       revbook,
+    int const                                      revbook_nbyte,
+    M*                                             par_nbit,
+    M*                                             par_entry,
+    int const                                      sublen,
+    int const                                      pardeg,
+    size_t const                                   len,
+    std::function<void(size_t, size_t, T*)> const& consume,
+    float&                                         time_elapsed,
+    uint8_t const*                                 chunk_mask = nullptr);
+
+}  // namespace asz
+
+#endif /* F3A8D2B1_7C64_4E19_A5B0_9D1E6C4F2B37 */
@@ -15,21 +15,25 @@
 #include <stdint.h>
 #include "cusz/type.h"
 
+// given outlier_idx and num_outliers (device), the outliers are compacted into (outlier_idx, outlier) of
+// max_outliers entries, in no particular order; num_outliers counts them all, also those that did not fit;
+// otherwise, outlier is a dense array of the data length
 template <typename T, typename E, typename FP>
 cusz_error_status compress_predict_lorenzo_i(
-    T* const     data,          // input
-    dim3 const   data_len3,     //
-    double const eb,            // input (config)
-    int const    radius,        //
-    E* const     eq,            // output
-    dim3 const   eq_len3,       //
-    T* const     anchor,        //
-    dim3 const   anchor_len3,   //
-    T*           outlier,       //
-    uint32_t*    outlier_idx,   //
-    uint32_t*    num_outliers,  //
-    float*       time_elapsed,  // optional
-    cudaStream_t stream);       //
+    T* const       data,          // input
+    dim3 const     data_len3,     //
+    double const   eb,            // input (config)
+    int const      radius,        //
+    E* const       eq,            // output
+    dim3 const     eq_len3,       //
+    T* const       anchor,        //
+    dim3 const     anchor_len3,   //
+    T*             outlier,       //
+    uint32_t*      outlier_idx,   //
+    uint32_t*      num_outliers,  //
+    uint32_t const max_outliers,  //
+    float*         time_elapsed,  // optional
+    cudaStream_t   stream);       //
 
 template <typename T, typename E, typename FP>
 cusz_error_status decompress_predict_lorenzo_i(
@@ -47,6 +51,96 @@ cusz_error_status decompress_predict_lorenzo_i(
     float*         time_elapsed,  // optional
     cudaStream_t   stream);
 
+// host (OpenMP) counterparts; same tiling, same output as the CUDA version
+// the outliers are always compacted (num_outliers in host memory)
+// given out_freq, the histogram of eq (nbin bins) is counted along with prediction
+template <typename T, typename E, typename FP>
+cusz_error_status compress_predict_lorenzo_i_cpu(
+    T* const       data,                // input
+    dim3 const     data_len3,           //
+    double const   eb,                  // input (config)
+    int const      radius,              //
+    E* const       eq,                  // output
+    dim3 const     eq_len3,             //
+    T* const       anchor,              //
+    dim3 const     anchor_len3,         //
+    T*             outlier,             //
+    uint32_t*      outlier_idx,         //
+    uint32_t*      num_outliers,        //
+    uint32_t const max_outliers,        //
+    float*         time_elapsed,        // optional
+    uint32_t*      out_freq = nullptr,  // optional
+    int const      nbin     = 0);       //
+
+template <typename T, typename E, typename FP>
+cusz_error_status decompress_predict_lorenzo_i_cpu(
+    E*             eq,             // input
+    dim3 const     eq_len3,        //
+    T*             anchor,         //
+    dim3 const     anchor_len3,    //
+    T*             outlier,        //
+    uint32_t*      outlier_idx,    //
+    uint32_t const num_outliers,   //
+    double const   eb,             // input (config)
+    int const      radius,         //
+    T*             xdata,          // output
+    dim3 const     xdata_len3,     //
+    float*         time_elapsed);  // optional
+
+// reconstruct the box [region_lo3, region_hi3) of a field of xdata_len3, the box starting on tile boundaries; eq,
+// outlier and xdata hold the box only, x fastest
+template <typename T, typename E, typename FP>
+cusz_error_status decompress_predict_lorenzo_i_region_cpu(
+    E*           eq,             // input
+    T*           outlier,        //
+    double const eb,             // input (config)
+    int const    radius,         //
+    T*           xdata,          // output
+    dim3 const   xdata_len3,     //
+    dim3 const   region_lo3,     //
+    dim3 const   region_hi3,     //
+    float*       time_elapsed);  // optional
+
+// reconstruct elements [begin, end) of the field, a whole number of tile rows (1D: 256, 2D: 16 rows, 3D: 8 planes),
+// from eq holding only their codes; untimed, and safe to call concurrently on disjoint rows of tiles
+template <typename T, typename E, typename FP>
+cusz_error_status decompress_predict_lorenzo_i_slab_cpu(
+    E*           eq,          // input
+    T*           outlier,     //
+    double const eb,          // input (config)
+    int const    radius,      //
+    T*           xdata,       // output
+    dim3 const   xdata_len3,  //
+    size_t const begin,       //
+    size_t const end);        //
+
+// second-order (2-layer) Lorenzo, host only; eq, outliers and histogram as for compress_predict_lorenzo_i_cpu;
+// CUSZ_FAIL_UNSUPPORTED_PRECISION if some outlier is beyond the integers exact in T (too small an error bound)
+template <typename T, typename E, typename FP>
+cusz_error_status compress_predict_lorenzo_ii_cpu(
+    T* const       data,                // input
+    dim3 const     data_len3,           //
+    double const   eb,                  // input (config)
+    int const      radius,              //
+    E* const       eq,                  // output
+    T*             outlier,             //
+    uint32_t*      outlier_idx,         //
+    uint32_t*      num_outliers,        //
+    uint32_t const max_outliers,        //
+    float*         time_elapsed,        // optional
+    uint32_t*      out_freq = nullptr,  // optional
+    int const      nbin     = 0);       //
+
+// xdata holds the scattered outliers on entry
+template <typename T, typename E, typename FP>
+cusz_error_status decompress_predict_lorenzo_ii_cpu(
+    E*           eq,             // input
+    double const eb,             // input (config)
+    int const    radius,         //
+    T*           xdata,          // output
+    dim3 const   xdata_len3,     //
+    float*       time_elapsed);  // optional
+
 namespace asz {
 namespace experimental {
 
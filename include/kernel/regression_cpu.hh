@@ -0,0 +1,71 @@
+/**
+ * @file regression_cpu.hh
+ * @author Jiannan Tian
+ * @brief
+ * @version 0.3
+ * @date 2022-12-28
+ *
+ * (C) 2022 by Indiana University, Argonne National Laboratory
+ *
+ */
+
+#ifndef F2B7C941_6E0A_4D3B_A85C_1E9D4F7B2C63
+#define F2B7C941_6E0A_4D3B_A85C_1E9D4F7B2C63
+
+#include "cusz/cuda_compat.h"
+#include <stdint.h>
+#include "cusz/type.h"
+
+// the block a hyperplane is fit to: 6x6x6 in 3D, 16x16 in 2D, 64 in 1D
+inline dim3 regression_block3(dim3 const len3)
+{
+    if (len3.z > 1) return dim3(6, 6, 6);
+    if (len3.y > 1) return dim3(16, 16, 1);
+    return dim3(64, 1, 1);
+}
+
+inline dim3 regression_nblock3(dim3 const len3)
+{
+    auto const b = regression_block3(len3);
+    return dim3((len3.x - 1) / b.x + 1, (len3.y - 1) / b.y + 1, (len3.z - 1) / b.z + 1);
+}
+
+// in T (at least 4 bytes): 4 coefficients per block, then the selector bitmap, a bit per block (set for regression)
+inline size_t regression_anchor_len(dim3 const len3)
+{
+    auto const nblock3 = regression_nblock3(len3);
+    auto const nblock  = (size_t)nblock3.x * nblock3.y * nblock3.z;
+    return 4 * nblock + (nblock - 1) / 32 + 1;
+}
+
+// Each block is predicted either by Lorenzo or by a hyperplane fit to its prequantized values, whichever errs less on
+// a sample of it. The coefficients (in quant-steps, rounded to 1/256) and the selection go to anchor, of
+// regression_anchor_len(); otherwise as compress_predict_lorenzo_ii_cpu, including CUSZ_FAIL_UNSUPPORTED_PRECISION.
+template <typename T, typename E, typename FP>
+cusz_error_status compress_predict_regression_cpu(
+    T* const       data,                // input
+    dim3 const     data_len3,           //
+    double const   eb,                  // input (config)
+    int const      radius,              //
+    E* const       eq,                  // output
+    T* const       anchor,              //
+    T*             outlier,             //
+    uint32_t*      outlier_idx,         //
+    uint32_t*      num_outliers,        //
+    uint32_t const max_outliers,        //
+    float*         time_elapsed,        // optional
+    uint32_t*      out_freq = nullptr,  // optional
+    int const      nbin     = 0);       //
+
+// xdata holds the scattered outliers on entry, as for Lorenzo
+template <typename T, typename E, typename FP>
+cusz_error_status decompress_predict_regression_cpu(
+    E*           eq,             // input
+    T*           anchor,         //
+    double const eb,             // input (config)
+    int const    radius,         //
+    T*           xdata,          // output
+    dim3 const   xdata_len3,     //
+    float*       time_elapsed);  // optional
+
+#endif /* F2B7C941_6E0A_4D3B_A85C_1E9D4F7B2C63 */
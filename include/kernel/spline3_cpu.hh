@@ -0,0 +1,62 @@
+/**
+ * @file spline3_cpu.hh
+ * @author Jiannan Tian
+ * @brief
+ * @version 0.3
+ * @date 2022-12-26
+ *
+ * (C) 2022 by Indiana University, Argonne National Laboratory
+ *
+ */
+
+#ifndef D4A1C6E2_5B7F_4E93_8C20_9F3E1A6B7D58
+#define D4A1C6E2_5B7F_4E93_8C20_9F3E1A6B7D58
+
+#include "cusz/cuda_compat.h"
+#include <stdint.h>
+#include "cusz/type.h"
+
+// the anchor stride: 8 in 3D (as the device kernels), 32 in 2D and 512 in 1D, so that the anchors, kept as they are,
+// stay about a thousandth of the field or less
+inline int spline3_anchor_stride(dim3 const len3)
+{
+    if (len3.z > 1) return 8;
+    if (len3.y > 1) return 32;
+    return 512;
+}
+
+// Anchors (every spline3_anchor_stride() points in each dimension) are kept as prequantized values, of anchor_len3 =
+// ceil(data_len3 / stride); the rest is interpolated from them level by level, in strides of a half, a quarter... of
+// it down to 1. eq is of the data length, as for Lorenzo. The outliers are compacted into (outlier_idx, outlier) of
+// max_outliers entries, in no particular order; given out_freq, the histogram of eq (nbin bins) is counted along with
+// prediction.
+template <typename T, typename E, typename FP>
+cusz_error_status compress_predict_spline3_cpu(
+    T* const       data,                // input
+    dim3 const     data_len3,           //
+    double const   eb,                  // input (config)
+    int const      radius,              //
+    E* const       eq,                  // output
+    T* const       anchor,              //
+    dim3 const     anchor_len3,         //
+    T*             outlier,             //
+    uint32_t*      outlier_idx,         //
+    uint32_t*      num_outliers,        //
+    uint32_t const max_outliers,        //
+    float*         time_elapsed,        // optional
+    uint32_t*      out_freq = nullptr,  // optional
+    int const      nbin     = 0);       //
+
+// xdata holds the scattered outliers on entry, as for Lorenzo
+template <typename T, typename E, typename FP>
+cusz_error_status decompress_predict_spline3_cpu(
+    E*           eq,             // input
+    T*           anchor,         //
+    dim3 const   anchor_len3,    //
+    double const eb,             // input (config)
+    int const    radius,         //
+    T*           xdata,          // output
+    dim3 const   xdata_len3,     //
+    float*       time_elapsed);  // optional
+
+#endif /* D4A1C6E2_5B7F_4E93_8C20_9F3E1A6B7D58 */
@@ -0,0 +1,77 @@
+/**
+ * @file spv_cpu.hh
+ * @author Jiannan Tian
+ * @brief
+ * @version 0.3
+ * @date 2022-12-08
+ *
+ * (C) 2022 by Indiana University, Argonne National Laboratory
+ *
+ */
+
+#ifndef B2F6E0A4_8D17_4C3B_9A52_6E1D7C8B3F05
+#define B2F6E0A4_8D17_4C3B_9A52_6E1D7C8B3F05
+
+#include <cstddef>
+#include <cstdint>
+
+#include "spv_val.hh"
+
+namespace accsz {
+
+// host counterparts of spv_gather/spv_scatter; nonzeros are kept in ascending index order
+template <typename T, typename M>
+void spv_gather_cpu(T* in, size_t const in_len, T* h_val, uint32_t* h_idx, int* nnz, float* milliseconds);
+
+template <typename T, typename M>
+void spv_scatter_cpu(T* h_val, uint32_t* h_idx, int const nnz, T* decoded, float* milliseconds);
+
+// as spv_scatter_cpu, but only the nonzeros falling in the [begin, end) index ranges, into `decoded` holding the
+// ranges back to back; h_idx need not be ordered
+template <typename T, typename M>
+void spv_scatter_ranges_cpu(
+    T*            h_val,
+    uint32_t*     h_idx,
+    int const     nnz,
+    size_t const* ranges,
+    size_t const  nrange,
+    T*            decoded,
+    float*        milliseconds);
+
+// order (h_idx, h_val) by ascending index, for outliers compacted in no particular order
+template <typename T, typename M>
+void spv_sort_cpu(T* h_val, uint32_t* h_idx, int const nnz, float* milliseconds);
+
+// bit-pack the ascending h_idx into `out` as laid out in spv_idx_layout; returns the bytes written
+size_t spv_idx_pack_cpu(uint32_t const* h_idx, int const nnz, uint32_t* out, float* milliseconds);
+
+// XOR-code h_val into `out` as laid out in spv_val_layout; returns the bytes written
+template <typename T, typename M>
+size_t spv_val_xor_cpu(T const* h_val, int const nnz, uint8_t* out, float* milliseconds);
+
+// values as stored with `coding`, indices as packed by spv_idx_pack_cpu
+template <typename T, typename M>
+void spv_scatter_packed_cpu(
+    uint8_t const*      coded_val,
+    spv_valcoding const coding,
+    uint32_t const*     packed_idx,
+    int const           nnz,
+    T*                  decoded,
+    float*              milliseconds);
+
+// scatter only the nonzeros falling in the [begin, end) index ranges (2 * nrange values), into `decoded` holding the
+// ranges back to back; blocks are located by binary search over their first indices
+template <typename T, typename M>
+void spv_scatter_packed_ranges_cpu(
+    uint8_t const*      coded_val,
+    spv_valcoding const coding,
+    uint32_t const*     packed_idx,
+    int const           nnz,
+    size_t const*       ranges,
+    size_t const        nrange,
+    T*                  decoded,
+    float*              milliseconds);
+
+}  // namespace accsz
+
+#endif /* B2F6E0A4_8D17_4C3B_9A52_6E1D7C8B3F05 */
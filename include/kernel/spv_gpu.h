@@ -24,7 +24,22 @@ extern "C" {
         T* in, size_t const in_len, T* d_val, uint32_t* d_idx, int* nnz, float* milliseconds, cudaStream_t stream); \
                                                                                                                     \
     void spv_scatter_T##Tliteral##_M##Mliteral(                                                                     \
-        T* d_val, uint32_t* d_idx, int const nnz, T* decoded, float* milliseconds, cudaStream_t stream);
+        T* d_val, uint32_t* d_idx, int const nnz, T* decoded, float* milliseconds, cudaStream_t stream);            \
+                                                                                                                    \
+    void spv_sort_T##Tliteral##_M##Mliteral(                                                                        \
+        T* d_val, uint32_t* d_idx, int const nnz, float* milliseconds, cudaStream_t stream);                        \
+                                                                                                                    \
+    size_t spv_val_xor_T##Tliteral##_M##Mliteral(                                                                   \
+        T const* d_val, int const nnz, uint8_t* d_out, float* milliseconds, cudaStream_t stream);                   \
+                                                                                                                    \
+    void spv_scatter_packed_T##Tliteral##_M##Mliteral(                                                              \
+        uint8_t const*  coded_val,                                                                                  \
+        int const       coding,                                                                                     \
+        uint32_t const* packed_idx,                                                                                 \
+        int const       nnz,                                                                                        \
+        T*              decoded,                                                                                    \
+        float*          milliseconds,                                                                               \
+        cudaStream_t    stream);
 
 SPV(ui8, ui32, uint8_t, uint32_t)
 SPV(ui16, ui32, uint16_t, uint32_t)
@@ -35,6 +50,9 @@ SPV(fp64, ui32, double, uint32_t)
 
 #undef SPV
 
+size_t spv_idx_pack_Mui32(
+    uint32_t const* d_idx, int const nnz, uint32_t* d_out, float* milliseconds, cudaStream_t stream);
+
 #ifdef __cplusplus
 }
 #endif
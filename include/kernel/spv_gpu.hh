@@ -13,6 +13,8 @@
 #define A54D2009_1D4F_4113_9E26_9695A3669224
 #include <cstdint>
 
+#include "spv_val.hh"
+
 namespace accsz {
 
 template <typename T, typename M>
@@ -28,6 +30,28 @@ void spv_gather(
 template <typename T, typename M>
 void spv_scatter(T* d_val, uint32_t* d_idx, int const nnz, T* decoded, float* milliseconds, cudaStream_t stream);
 
+// order (d_idx, d_val) by ascending index, for outliers compacted in no particular order
+template <typename T, typename M>
+void spv_sort(T* d_val, uint32_t* d_idx, int const nnz, float* milliseconds, cudaStream_t stream);
+
+// bit-pack the ascending d_idx into d_out as laid out in spv_idx_layout; returns the bytes written
+size_t spv_idx_pack(uint32_t const* d_idx, int const nnz, uint32_t* d_out, float* milliseconds, cudaStream_t stream);
+
+// XOR-code d_val into d_out as laid out in spv_val_layout; returns the bytes written
+template <typename T, typename M>
+size_t spv_val_xor(T const* d_val, int const nnz, uint8_t* d_out, float* milliseconds, cudaStream_t stream);
+
+// values as stored with `coding`, indices as packed by spv_idx_pack
+template <typename T, typename M>
+void spv_scatter_packed(
+    uint8_t const*      coded_val,
+    spv_valcoding const coding,
+    uint32_t const*     packed_idx,
+    int const           nnz,
+    T*                  decoded,
+    float*              milliseconds,
+    cudaStream_t        stream);
+
 }  // namespace accsz
 
 #endif /* A54D2009_1D4F_4113_9E26_9695A3669224 */
@@ -0,0 +1,160 @@
+/**
+ * @file spv_idx.hh
+ * @author Jiannan Tian
+ * @brief Layout of the bit-packed (delta) outlier indices, shared by the host and device codecs.
+ * @version 0.3
+ * @date 2022-12-23
+ *
+ * (C) 2022 by Indiana University, Argonne National Laboratory
+ *
+ */
+
+#ifndef C5E19B07_4A2D_4F36_8B1E_7D90A3F6C214
+#define C5E19B07_4A2D_4F36_8B1E_7D90A3F6C214
+
+#include "cusz/cuda_compat.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace accsz {
+
+/**
+ * @brief Ascending indices, in blocks of BLOCK, as 32-bit words:
+ *
+ *     first[nblock]        the first index of each block
+ *     start[nblock + 1]    where the packed gaps of each block begin (start[0] = 0)
+ *     packed[start[nblock]]
+ *
+ * Block b packs the gaps idx[i] - idx[i - 1] - 1 of its elements (0 for its first one), LSB first, at the widest
+ * width that fits its start[b + 1] - start[b] words. Blocks decode independently of each other.
+ */
+struct spv_idx_layout {
+    static const int BLOCK = 128;
+
+    __host__ __device__ static size_t nblock(int const nnz) { return (nnz + BLOCK - 1) / BLOCK; }
+    __host__ __device__ static int count(int const nnz, size_t const b)
+    {
+        return nnz - b * BLOCK < BLOCK ? int(nnz - b * BLOCK) : BLOCK;
+    }
+
+    __host__ __device__ static uint32_t nword(int const count, int const width) { return (count * width + 31) / 32; }
+    __host__ __device__ static int      width(int const count, uint32_t const nword)
+    {
+        auto w = count == 0 ? 0 : nword * 32 / count;
+        return w < 32 ? w : 32;
+    }
+
+    __host__ __device__ static size_t start_offset(int const nnz) { return nblock(nnz); }
+    __host__ __device__ static size_t packed_offset(int const nnz) { return 2 * nblock(nnz) + 1; }
+    // with every gap taking 32 bits
+    static size_t max_nbyte(int const nnz) { return sizeof(uint32_t) * (packed_offset(nnz) + nblock(nnz) * BLOCK); }
+};
+
+__host__ __device__ inline int spv_bit_width(uint64_t const v)
+{
+#ifdef __CUDA_ARCH__
+    return 64 - __clzll(v);
+#else
+    return v == 0 ? 0 : 64 - __builtin_clzll(v);
+#endif
+}
+
+// of a nonzero v
+__host__ __device__ inline int spv_trailing_zeros(uint64_t const v)
+{
+#ifdef __CUDA_ARCH__
+    return __ffsll(v) - 1;
+#else
+    return __builtin_ctzll(v);
+#endif
+}
+
+// appends values of up to 64 bits to a stream of 32-bit words, LSB first
+struct spv_bit_writer {
+    uint32_t* word;
+    uint64_t  buf{0};
+    int       nbit{0};
+
+    __host__ __device__ spv_bit_writer(uint32_t* word) : word(word) {}
+
+    __host__ __device__ void put(uint64_t const v, int const width)
+    {
+        if (width > 32) {
+            put32(v & 0xffffffffu, 32);
+            put32(v >> 32, width - 32);
+        }
+        else
+            put32(v, width);
+    }
+    __host__ __device__ void flush()
+    {
+        if (nbit > 0) *word = buf;
+    }
+
+   private:
+    __host__ __device__ void put32(uint64_t const v, int const width)
+    {
+        buf |= v << nbit;
+        nbit += width;
+        if (nbit >= 32) {
+            *word++ = buf;
+            buf >>= 32;
+            nbit -= 32;
+        }
+    }
+};
+
+struct spv_bit_reader {
+    uint32_t const* word;
+    uint64_t        buf{0};
+    int             nbit{0};
+
+    __host__ __device__ spv_bit_reader(uint32_t const* word) : word(word) {}
+
+    __host__ __device__ uint64_t get(int const width)
+    {
+        if (width > 32) {
+            auto lo = get32(32);
+            return lo | get32(width - 32) << 32;
+        }
+        return get32(width);
+    }
+
+   private:
+    __host__ __device__ uint64_t get32(int const width)
+    {
+        if (nbit < width) {
+            buf |= (uint64_t)*word++ << nbit;
+            nbit += 32;
+        }
+        auto v = buf & ((1ull << width) - 1);
+        buf >>= width;
+        nbit -= width;
+        return v;
+    }
+};
+
+// the indices of block b, in order
+class spv_idx_cursor {
+    spv_bit_reader gaps;
+    uint32_t       idx;
+    int            width;
+
+   public:
+    int const count;
+
+    __host__ __device__ spv_idx_cursor(uint32_t const* packed_idx, int const nnz, size_t const b) :
+        gaps(packed_idx + spv_idx_layout::packed_offset(nnz) + packed_idx[spv_idx_layout::start_offset(nnz) + b]),
+        idx(packed_idx[b] - 1),  // so that the first gap (0) lands on first[b]
+        count(spv_idx_layout::count(nnz, b))
+    {
+        auto start = packed_idx + spv_idx_layout::start_offset(nnz);
+        width      = spv_idx_layout::width(count, start[b + 1] - start[b]);
+    }
+
+    __host__ __device__ uint32_t next() { return idx += gaps.get(width) + 1; }
+};
+
+}  // namespace accsz
+
+#endif /* C5E19B07_4A2D_4F36_8B1E_7D90A3F6C214 */
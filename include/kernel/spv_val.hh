@@ -0,0 +1,143 @@
+/**
+ * @file spv_val.hh
+ * @author Jiannan Tian
+ * @brief Layout of the XOR-coded outlier values, shared by the host and device codecs.
+ * @version 0.3
+ * @date 2022-12-23
+ *
+ * (C) 2022 by Indiana University, Argonne National Laboratory
+ *
+ */
+
+#ifndef E7B3D148_2C9A_4F5E_A061_3B8D5C2F9E70
+#define E7B3D148_2C9A_4F5E_A061_3B8D5C2F9E70
+
+#include "cusz/cuda_compat.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "spv_idx.hh"
+
+namespace accsz {
+
+// how SpcodecVec stores the values; same as cusz_spcodec_valcoding
+enum class spv_valcoding : int { RAW = 0, XOR = 1 };
+
+template <int NBYTE>
+struct spv_uint;
+template <>
+struct spv_uint<1> {
+    using type = uint8_t;
+};
+template <>
+struct spv_uint<2> {
+    using type = uint16_t;
+};
+template <>
+struct spv_uint<4> {
+    using type = uint32_t;
+};
+template <>
+struct spv_uint<8> {
+    using type = uint64_t;
+};
+
+/**
+ * @brief Values in the blocks of spv_idx_layout, each XOR-ed (as bits) with the previous one in its block:
+ *
+ *     first[nblock]         (T) the first value of each block, as is
+ *     start[nblock + 1]     (uint32_t) where the packed residuals of each block begin, in 32-bit words
+ *     shape[nblock][2]      (uint8_t) trailing zeros shared by the residuals of the block, and their width without
+ *                           them
+ *     packed[start[nblock]] (uint32_t) residuals, LSB first
+ *
+ * Neighboring outliers tend to share sign, exponent and high mantissa bits, and integral ones (as prequantized
+ * deltas are) end in zeros; dropping both ends leaves narrow residuals.
+ */
+template <typename T>
+struct spv_val_layout {
+    using UInt = typename spv_uint<sizeof(T)>::type;
+
+    static const int BLOCK = spv_idx_layout::BLOCK;
+    static const int NBIT  = sizeof(T) * 8;
+
+    __host__ __device__ static size_t nblock(int const nnz) { return spv_idx_layout::nblock(nnz); }
+    __host__ __device__ static size_t start_offset(int const nnz) { return align4(sizeof(T) * nblock(nnz)); }
+    __host__ __device__ static size_t shape_offset(int const nnz)
+    {
+        return start_offset(nnz) + sizeof(uint32_t) * (nblock(nnz) + 1);
+    }
+    __host__ __device__ static size_t packed_offset(int const nnz)
+    {
+        return align4(shape_offset(nnz) + 2 * nblock(nnz));
+    }
+    // in bytes, as are the offsets; with every residual at full width
+    static size_t max_nbyte(int const nnz)
+    {
+        return packed_offset(nnz) + sizeof(uint32_t) * nblock(nnz) * spv_idx_layout::nword(BLOCK, NBIT);
+    }
+
+    __host__ __device__ static UInt to_bits(T const v)
+    {
+        UInt u;
+        memcpy(&u, &v, sizeof(T));
+        return u;
+    }
+    __host__ __device__ static T from_bits(UInt const u)
+    {
+        T v;
+        memcpy(&v, &u, sizeof(T));
+        return v;
+    }
+
+   private:
+    __host__ __device__ static size_t align4(size_t const n) { return (n + 3) / 4 * 4; }
+};
+
+// the values of block b, in order, as stored with `coding`
+template <typename T>
+class spv_val_cursor {
+    using L    = spv_val_layout<T>;
+    using UInt = typename L::UInt;
+
+    T const*       raw{nullptr};
+    spv_bit_reader residual{nullptr};
+    UInt           bits{0};
+    int            tz{0}, width{0};
+    bool           head{true};
+
+   public:
+    __host__ __device__
+    spv_val_cursor(uint8_t const* coded_val, spv_valcoding const coding, int const nnz, size_t const b)
+    {
+        if (coding == spv_valcoding::RAW) {
+            raw = reinterpret_cast<T const*>(coded_val) + b * L::BLOCK;
+            return;
+        }
+
+        auto start  = reinterpret_cast<uint32_t const*>(coded_val + L::start_offset(nnz));
+        auto shape  = coded_val + L::shape_offset(nnz) + 2 * b;
+        auto packed = reinterpret_cast<uint32_t const*>(coded_val + L::packed_offset(nnz));
+
+        bits     = L::to_bits(reinterpret_cast<T const*>(coded_val)[b]);
+        tz       = shape[0];
+        width    = shape[1];
+        residual = spv_bit_reader(packed + start[b]);
+    }
+
+    __host__ __device__ T next()
+    {
+        if (raw) return *raw++;
+
+        if (head)
+            head = false;
+        else
+            bits ^= UInt(residual.get(width) << tz);
+        return L::from_bits(bits);
+    }
+};
+
+}  // namespace accsz
+
+#endif /* E7B3D148_2C9A_4F5E_A061_3B8D5C2F9E70 */
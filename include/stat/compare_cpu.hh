@@ -27,24 +27,25 @@ void cppstd_assess_quality(cusz_stats* s, T* xdata, T* odata, size_t const len);
 
 }  // namespace parsz
 
-#define CPPSTD_COMPARE_LOSSLESS(Tliteral, T)                          \
-    template <>                                                       \
-    bool parsz::cppstd_identical<T>(T * d1, T * d2, size_t const len) \
-    {                                                                 \
-        return cppstd_identical_T##Tliteral(d1, d2, len);             \
+#define CPPSTD_COMPARE_LOSSLESS(Tliteral, T)                                 \
+    template <>                                                              \
+    inline bool parsz::cppstd_identical<T>(T * d1, T * d2, size_t const len) \
+    {                                                                        \
+        return cppstd_identical_T##Tliteral(d1, d2, len);                    \
     }
 
-#define CPPSTD_COMPARE_LOSSY(Tliteral, T)                                                                          \
-    template <>                                                                                                    \
-    bool parsz::cppstd_error_bounded<T>(T * a, T * b, size_t const len, double const eb, size_t* first_faulty_idx) \
-    {                                                                                                              \
-        return cppstd_error_bounded_T##Tliteral(a, b, len, eb, first_faulty_idx);                                  \
-    }                                                                                                              \
-                                                                                                                   \
-    template <>                                                                                                    \
-    void parsz::cppstd_assess_quality<T>(cusz_stats * s, T * xdata, T * odata, size_t const len)                   \
-    {                                                                                                              \
-        cppstd_assess_quality_T##Tliteral(s, xdata, odata, len);                                                   \
+#define CPPSTD_COMPARE_LOSSY(Tliteral, T)                                                               \
+    template <>                                                                                         \
+    inline bool parsz::cppstd_error_bounded<T>(                                                         \
+        T * a, T * b, size_t const len, double const eb, size_t* first_faulty_idx)                      \
+    {                                                                                                   \
+        return cppstd_error_bounded_T##Tliteral(a, b, len, eb, first_faulty_idx);                       \
+    }                                                                                                   \
+                                                                                                        \
+    template <>                                                                                         \
+    inline void parsz::cppstd_assess_quality<T>(cusz_stats * s, T * xdata, T * odata, size_t const len) \
+    {                                                                                                   \
+        cppstd_assess_quality_T##Tliteral(s, xdata, odata, len);                                        \
     }
 
 CPPSTD_COMPARE_LOSSLESS(fp32, float)
@@ -12,4 +12,77 @@
 #ifndef B005D07B_D92D_4DF0_90D0_87A7B7C310C9
 #define B005D07B_D92D_4DF0_90D0_87A7B7C310C9
 
+#include <omp.h>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "cusz/type.h"
+
+namespace asz {
+namespace stat {
+
+/**
+ * @brief Get frequency on host, counterpart of asz::stat::histogram
+ *
+ * @tparam T input type
+ * @param in_data input host array
+ * @param in_len input host var; len of in_data
+ * @param out_freq output host array, overwritten
+ * @param nbin input host var; len of out_freq
+ * @param milliseconds output time elapsed
+ */
+template <typename T>
+cusz_error_status histogram_cpu(
+    T*           in_data,
+    size_t const in_len,
+    uint32_t*    out_freq,
+    int const    nbin,
+    float*       milliseconds);
+
+/**
+ * @brief Per-thread histograms for a producer that counts the values as it writes them (e.g., prediction), instead
+ * of a separate pass over its output. Each calling thread counts into its own rows; merge() sums them up.
+ *
+ * Consecutive values are spread over NREPLICA sub-histograms per thread: quant codes pile up in the `radius` bin,
+ * and a single copy would make every increment wait for the store of the previous one.
+ */
+class histogram_cpu_private {
+   public:
+    static const int NREPLICA = 2;
+
+    // for the parallel regions of up to `nthread` threads that follow
+    explicit histogram_cpu_private(int const nbin, int const nthread = omp_get_max_threads());
+
+    // values outside [0, nbin) are not counted
+    template <typename T>
+    inline void count(T const* in, size_t const len)
+    {
+        auto const row0 = (size_t)omp_get_thread_num() * NREPLICA;
+
+        uint32_t* h[NREPLICA];
+        for (auto r = 0; r < NREPLICA; r++) h[r] = local.data() + (row0 + r) * stride;
+
+        auto in_range = [&](T v) { return (uint64_t)v < (uint64_t)nbin; };
+
+        size_t i = 0;
+        for (; i + NREPLICA <= len; i += NREPLICA)
+            for (auto r = 0; r < NREPLICA; r++)
+                if (in_range(in[i + r])) h[r][(int64_t)in[i + r]] += 1;
+        for (; i < len; i++)
+            if (in_range(in[i])) h[0][(int64_t)in[i]] += 1;
+    }
+
+    // out_freq (len of nbin) is overwritten
+    void merge(uint32_t* out_freq);
+
+   private:
+    int                   nbin;
+    int                   stride;  // rows start on their own cache line
+    int                   nrow;
+    std::vector<uint32_t> local;
+};
+
+}  // namespace stat
+}  // namespace asz
+
 #endif /* B005D07B_D92D_4DF0_90D0_87A7B7C310C9 */
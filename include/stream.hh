@@ -0,0 +1,102 @@
+/**
+ * @file stream.hh
+ * @author Jiannan Tian
+ * @brief Out-of-core (streaming) compression: the field is cut into segments along the slowest dimension, each
+ * compressed as an ordinary archive, and the segments are collected into one multi-segment archive.
+ * @version 0.3
+ * @date 2022-12-15
+ *
+ * (C) 2022 by Indiana University, Argonne National Laboratory
+ *
+ */
+
+#ifndef C5A09E3B_2D7F_4E1C_8B64_F19D3A7E0C25
+#define C5A09E3B_2D7F_4E1C_8B64_F19D3A7E0C25
+
+#include "cusz/cuda_compat.h"
+#include <cstdint>
+#include <string>
+
+#include "context.hh"
+#include "cusz/type.h"
+
+namespace cusz {
+
+/**
+ * on-disk layout of a multi-segment archive
+ *
+ *   | StreamHeader | segment 0 (.cusza) | segment 1 (.cusza) | ... | StreamSegment[nseg] |
+ *
+ * Segment boundaries are multiples of the Lorenzo tile size along the slowest dimension (8 in 3D, 16 in 2D, 256 in
+ * 1D). The Lorenzo kernels treat neighbors outside a tile as zero, so a segment needs no halo from its predecessor:
+ * its quant-codes equal those of the same slabs compressed in the whole field, and it can be decoded on its own.
+ */
+struct alignas(64) StreamHeader {
+    char     magic[8];  // "CUSZSTRM"
+    uint32_t version;
+    uint32_t ndim;
+    uint32_t x, y, z;
+    uint32_t byte_uncompressed;
+    uint32_t nseg;
+    uint32_t seg_nslab;  // number of slabs (along the slowest dimension) per segment, except the last one
+    uint64_t index_offset;
+    double   eb;  // absolute error bound shared by all segments
+};
+
+struct StreamSegment {
+    uint64_t offset;  // position of the segment archive in the file
+    uint64_t nbyte;
+    uint32_t slab_begin, nslab;
+};
+
+struct StreamHelper {
+    static constexpr uint32_t VERSION = 1;
+
+    static bool is_stream_archive(std::string const& fname);
+
+    /**
+     * @brief number of slabs per segment for a given budget of uncompressed bytes, rounded down to a multiple of the
+     * Lorenzo tile size (and at least one tile)
+     */
+    static uint32_t get_seg_nslab(Context* ctx, size_t const type_nbyte, size_t const budget_nbyte);
+};
+
+/**
+ * @brief compress a file in segments; at most one segment (plus the one being read ahead) is resident
+ *
+ * @tparam Compressor predefined Compressor type, accessible via cusz::Framework<T>::XFeaturedCompressor
+ * @tparam T uncompressed data type
+ * @param config (host) configuration; with "r2r" mode, the value range is found in an extra streaming pass
+ * @param in_fname uncompressed input file
+ * @param out_fname multi-segment archive to write
+ * @param budget_nbyte uncompressed bytes per segment
+ * @param stream CUDA stream; unused with the host policy
+ * @return size of the archive in bytes
+ */
+template <class Compressor, typename T>
+size_t stream_compress(
+    Context*           config,
+    std::string const& in_fname,
+    std::string const& out_fname,
+    size_t const       budget_nbyte,
+    cudaStream_t       stream = nullptr);
+
+/**
+ * @brief decompress a multi-segment archive segment by segment
+ *
+ * @param in_fname multi-segment archive
+ * @param out_fname decompressed output; nothing is written when empty
+ * @param policy where decompression runs
+ * @param stream CUDA stream; unused with the host policy
+ * @return number of decompressed elements
+ */
+template <class Compressor, typename T>
+size_t stream_decompress(
+    std::string const&    in_fname,
+    std::string const&    out_fname,
+    cusz_execution_policy policy = CUDA,
+    cudaStream_t          stream = nullptr);
+
+}  // namespace cusz
+
+#endif /* C5A09E3B_2D7F_4E1C_8B64_F19D3A7E0C25 */
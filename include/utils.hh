@@ -12,8 +12,10 @@
 #ifndef UTILS_HH
 #define UTILS_HH
 
+#ifndef CUSZ_HOST_ONLY
 #include "utils/cuda_err.cuh"
 #include "utils/cuda_mem.cuh"
+#endif
 #include "utils/format.hh"
 #include "utils/io.hh"
 #include "utils/strhelper.hh"
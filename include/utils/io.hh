@@ -14,8 +14,19 @@
  *
  */
 
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
 #include <fstream>
 #include <iostream>
+#include <stdexcept>
+#include <string>
+#include <utility>
 
 namespace io {
 
@@ -54,6 +65,110 @@ void write_array_to_binary(const std::string& fname, T* const _a, size_t const d
     ofs.close();
 }
 
+/**
+ * @brief A file mapped into memory, unmapped on destruction.
+ *
+ * Read mode maps an existing file read-only, so an archive is accessed in place and its pages are backed by the
+ * page cache rather than by a private copy. Write mode creates (or truncates) the file, sizes it, and maps it
+ * shared: whatever is written to `data()` ends up in the file, and written-back pages can be reclaimed by the
+ * kernel, which keeps the resident set of large outputs bounded.
+ */
+class mapped_file {
+   private:
+    int    fd{-1};
+    void*  addr{nullptr};
+    size_t len{0};
+    bool   writable{false};
+
+    [[noreturn]] void fail(std::string const& what, std::string const& fname)
+    {
+        auto msg = "[io::mapped_file] " + what + " \"" + fname + "\": " + std::strerror(errno);
+        if (fd >= 0) ::close(fd);
+        fd = -1, addr = nullptr, len = 0;
+        throw std::runtime_error(msg);
+    }
+
+   public:
+    mapped_file() = default;
+
+    // read-only mapping of an existing file
+    static mapped_file open_read(std::string const& fname, int advice = MADV_WILLNEED)
+    {
+        mapped_file f;
+
+        f.fd = ::open(fname.c_str(), O_RDONLY);
+        if (f.fd < 0) f.fail("fail to open", fname);
+
+        struct stat st;
+        if (::fstat(f.fd, &st) != 0) f.fail("fail to stat", fname);
+        f.len = st.st_size;
+
+        if (f.len != 0) {
+            f.addr = ::mmap(nullptr, f.len, PROT_READ, MAP_SHARED, f.fd, 0);
+            if (f.addr == MAP_FAILED) f.fail("fail to map", fname);
+            ::madvise(f.addr, f.len, advice);
+        }
+        return f;
+    }
+
+    // writable mapping of a new file of `nbyte` bytes
+    static mapped_file create(std::string const& fname, size_t nbyte, int advice = MADV_SEQUENTIAL)
+    {
+        mapped_file f;
+        f.len      = nbyte;
+        f.writable = true;
+
+        f.fd = ::open(fname.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+        if (f.fd < 0) f.fail("fail to create", fname);
+        if (::ftruncate(f.fd, f.len) != 0) f.fail("fail to resize", fname);
+
+        if (f.len != 0) {
+            f.addr = ::mmap(nullptr, f.len, PROT_READ | PROT_WRITE, MAP_SHARED, f.fd, 0);
+            if (f.addr == MAP_FAILED) f.fail("fail to map", fname);
+            ::madvise(f.addr, f.len, advice);
+        }
+        return f;
+    }
+
+    mapped_file(mapped_file const&) = delete;
+    mapped_file& operator=(mapped_file const&) = delete;
+
+    mapped_file(mapped_file&& other) { *this = std::move(other); }
+    mapped_file& operator=(mapped_file&& other)
+    {
+        if (this != &other) {
+            close();
+            std::swap(fd, other.fd), std::swap(addr, other.addr);
+            std::swap(len, other.len), std::swap(writable, other.writable);
+        }
+        return *this;
+    }
+
+    ~mapped_file() { close(); }
+
+    template <typename T = uint8_t>
+    T* data() const
+    {
+        return reinterpret_cast<T*>(addr);
+    }
+
+    size_t nbyte() const { return len; }
+
+    /**
+     * @brief unmap and close; a writable file is cut to `keep_nbyte` (when smaller than the mapping), which lets the
+     * mapping carry trailing workspace that is not part of the file
+     */
+    void close(size_t keep_nbyte = SIZE_MAX)
+    {
+        if (addr) ::munmap(addr, len);
+        if (fd >= 0) {
+            if (writable and keep_nbyte < len) (void)::ftruncate(fd, keep_nbyte);
+            ::close(fd);
+        }
+        fd = -1, addr = nullptr, len = 0, writable = false;
+    }
+};
+
 }  // namespace io
 
 #endif  // IO_HH
@@ -0,0 +1,115 @@
+/**
+ * @file mempool.hh
+ * @author Jiannan Tian
+ * @brief Pluggable memory resources for component buffers.
+ * @version 0.3
+ * @date 2022-12-20
+ *
+ * (C) 2022 by Indiana University, Argonne National Laboratory
+ *
+ */
+
+#ifndef E3A7C5D2_9B14_4F60_8D2E_6A1F4C8B7D03
+#define E3A7C5D2_9B14_4F60_8D2E_6A1F4C8B7D03
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <unordered_map>
+
+namespace cusz {
+
+enum class memkind : int { DEVICE = 0, HOST_PINNED = 1, HOST_PAGEABLE = 2 };
+
+/**
+ * @brief Where Compressor, LosslessCodec, SpcodecVec and PredictionUnified get their buffers from.
+ *
+ * allocate/deallocate keep the bookkeeping (bytes in use, peak, number of system allocations) and are thread-safe;
+ * derived resources only implement how memory is obtained and given back.
+ */
+class memory_resource {
+   public:
+    static const int NKIND = 3;
+
+    struct stat {
+        size_t inuse_nbyte{0};
+        size_t peak_nbyte{0};
+        size_t reserved_nbyte{0};  // held from the system, in use or cached
+        size_t nalloc_system{0};   // allocations that reached cudaMalloc/cudaMallocHost/malloc
+        size_t nalloc{0};
+    };
+
+    virtual ~memory_resource() = default;
+
+    void* allocate(size_t nbyte, memkind kind);
+    void  deallocate(void* ptr, memkind kind);
+
+    stat get_stat(memkind kind) const;
+    void reset_peak();
+    void print_stat() const;
+
+   protected:
+    // returns the block and the number of bytes reserved from the system for it (0 if it is reused)
+    virtual void* do_allocate(size_t nbyte, memkind kind, size_t& nbyte_system) = 0;
+    // returns the number of bytes given back to the system (0 if it is kept)
+    virtual size_t do_deallocate(void* ptr, size_t nbyte, memkind kind) = 0;
+
+    static void* system_allocate(size_t nbyte, memkind kind);
+    static void  system_deallocate(void* ptr, memkind kind);
+
+    // for blocks given back to the system outside of do_deallocate; the lock must be held
+    void note_system_release(size_t nbyte, memkind kind);
+
+    mutable std::mutex mtx;
+
+   private:
+    std::unordered_map<void*, size_t> live;  // block -> requested size
+    stat                              stats[NKIND];
+};
+
+/**
+ * @brief Forwards every request to the system, i.e., the behavior before memory resources.
+ */
+class direct_resource : public memory_resource {
+   protected:
+    void*  do_allocate(size_t nbyte, memkind kind, size_t& nbyte_system) override;
+    size_t do_deallocate(void* ptr, size_t nbyte, memkind kind) override;
+};
+
+/**
+ * @brief Keeps freed blocks and hands them out again, so that re-initializing a component with the same (or a
+ * slightly smaller) configuration does not reach the system allocator.
+ *
+ * A request is served by the smallest cached block that is at least as large and at most 1/8 larger, which bounds
+ * the waste without pinning a huge block to a small request.
+ */
+class caching_pool : public memory_resource {
+   public:
+    ~caching_pool() override;
+
+    // give all cached (not in use) blocks back to the system
+    void release();
+
+   protected:
+    void*  do_allocate(size_t nbyte, memkind kind, size_t& nbyte_system) override;
+    size_t do_deallocate(void* ptr, size_t nbyte, memkind kind) override;
+
+   private:
+    static const size_t GRANULARITY = 256;
+
+    void drop_cached(memkind kind);
+
+    std::unordered_map<void*, size_t> block_nbyte;    // block -> reserved size
+    std::multimap<size_t, void*>      cached[NKIND];  // reserved size -> free block
+};
+
+/**
+ * @brief The resource components use unless one is given to them; a process-wide caching_pool by default.
+ */
+memory_resource* default_memory_resource();
+void             set_default_memory_resource(memory_resource*);
+
+}  // namespace cusz
+
+#endif /* E3A7C5D2_9B14_4F60_8D2E_6A1F4C8B7D03 */
@@ -68,6 +68,13 @@ double         asz_cudastreamtime_elapsed(asz_cudatimer* t);
 
 #define TIME_ELAPSED_CUDAEVENT(PTR_MILLISEC) cudaEventElapsedTime(PTR_MILLISEC, a, b);
 
+// host timing snippet, counterpart of the CUDA one
+#define CREATE_CPU_TIMER asz_timer* t_cpu = asz_cputimer_create();
+#define DESTROY_CPU_TIMER asz_cputimer_destroy(t_cpu);
+#define START_CPU_TIMER asz_cputimer_start(t_cpu);
+#define STOP_CPU_TIMER asz_cputimer_end(t_cpu);
+#define TIME_ELAPSED_CPU_TIMER(PTR_MILLISEC) *(PTR_MILLISEC) = asz_cputime_elapsed(t_cpu) * 1000;
+
 // 22-11-01 HIP timing snippet instead
 #define CREATE_HIPEVENT_PAIR \
     hipEvent_t a, b;         \
@@ -0,0 +1,255 @@
+/**
+ * @file batch.cc
+ * @author Jiannan Tian
+ * @brief
+ * @version 0.3
+ * @date 2022-12-18
+ *
+ * (C) 2022 by Indiana University, Argonne National Laboratory
+ *
+ */
+
+#include "batch.hh"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <future>
+#include <memory>
+#include <stdexcept>
+
+#include "compressor.hh"
+#include "framework.hh"
+#include "header.h"
+
+#ifndef CUSZ_HOST_ONLY
+#include "utils/cuda_err.cuh"
+#endif
+
+namespace {
+
+constexpr char   BATCH_MAGIC[8] = {'C', 'U', 'S', 'Z', 'B', 'T', 'C', 'H'};
+constexpr size_t FIELD_ALIGN    = 64;  // field archives start aligned, as they would in a fresh buffer
+
+// what a compressor's allocation depends on; fields with the same key share one
+using shape_key = std::array<size_t, 4>;
+
+template <class Compressor>
+struct lane {
+    std::unique_ptr<Compressor> compressor;
+    shape_key                   key{};
+    cusz::Context               ctx;
+    cudaStream_t                stream{nullptr};
+    uint8_t*                    compressed{nullptr};
+    size_t                      compressed_len{0};
+};
+
+}  // namespace
+
+bool cusz::BatchHelper::is_batch_archive(uint8_t const* archive, size_t const archive_len)
+{
+    if (archive == nullptr or archive_len < sizeof(BatchHeader)) return false;
+
+    BatchHeader header;
+    memcpy(&header, archive, sizeof(header));
+    if (memcmp(header.magic, BATCH_MAGIC, sizeof(BATCH_MAGIC)) != 0) return false;
+
+    return header.total_nbyte <= archive_len and
+           header.toc_offset + sizeof(BatchEntry) * header.nfield <= header.total_nbyte;
+}
+
+uint32_t cusz::BatchHelper::get_nfield(uint8_t const* archive)
+{
+    return reinterpret_cast<BatchHeader const*>(archive)->nfield;
+}
+
+cusz::BatchEntry const* cusz::BatchHelper::get_toc(uint8_t const* archive)
+{
+    return reinterpret_cast<BatchEntry const*>(archive + reinterpret_cast<BatchHeader const*>(archive)->toc_offset);
+}
+
+template <class Compressor, typename T>
+size_t cusz::compress_batch(
+    Context*              configs,
+    T**                   fields,
+    size_t const          nfield,
+    std::vector<uint8_t>& archive,
+    cudaStream_t          stream)
+{
+    if (configs == nullptr or fields == nullptr or nfield == 0)
+        throw std::runtime_error("[batch] `configs` and `fields` must hold at least one field.");
+
+    auto const policy = configs[0].policy;
+
+    // on CUDA, two lanes run concurrently on their own streams, the first on the caller's if given; on host, one
+    // compression already takes all of the caller's OpenMP threads, so a single lane runs in the calling thread when
+    // its result is collected, and fields are compressed one after another
+    lane<Compressor> lanes[2];
+    auto const       nlane         = policy == CPU ? 1u : 2u;
+    auto const       launch_policy = policy == CPU ? std::launch::deferred : std::launch::async;
+#ifndef CUSZ_HOST_ONLY
+    bool own_stream[2] = {false, false};
+    if (policy == CUDA)
+        for (auto k = 0u; k < nlane; k++) {
+            if (k == 0 and stream != nullptr) {
+                lanes[k].stream = stream;
+                continue;
+            }
+            CHECK_CUDA(cudaStreamCreate(&lanes[k].stream));
+            own_stream[k] = true;
+        }
+#else
+    (void)stream;
+#endif
+
+    auto launch = [&](size_t i) {
+        return std::async(launch_policy, [&, i]() {
+            auto& l = lanes[i % nlane];
+
+            if (fields[i] == nullptr) throw std::runtime_error("[batch] input field cannot be null.");
+
+            l.ctx        = configs[i];
+            l.ctx.policy = policy;
+            CompressorHelper::autotune_coarse_parvle(&l.ctx);
+
+            auto key = shape_key{l.ctx.x, l.ctx.y, l.ctx.z, (size_t)l.ctx.radius};
+            if (not l.compressor or key != l.key) {
+                l.compressor.reset(new Compressor);
+                l.compressor->init(&l.ctx);
+                l.key = key;
+            }
+
+            l.compressor->compress(&l.ctx, fields[i], l.compressed, l.compressed_len, l.stream);
+#ifndef CUSZ_HOST_ONLY
+            if (policy == CUDA) CHECK_CUDA(cudaStreamSynchronize(l.stream));
+#endif
+        });
+    };
+
+    std::vector<BatchEntry> toc(nfield);
+
+    archive.assign(sizeof(BatchHeader), 0);
+
+    // append field i; its lane is then free for field i + nlane
+    auto collect = [&](size_t i) {
+        auto& l      = lanes[i % nlane];
+        auto  offset = (archive.size() + FIELD_ALIGN - 1) / FIELD_ALIGN * FIELD_ALIGN;
+        archive.resize(offset + l.compressed_len);
+
+#ifndef CUSZ_HOST_ONLY
+        if (policy == CUDA)
+            CHECK_CUDA(cudaMemcpy(archive.data() + offset, l.compressed, l.compressed_len, cudaMemcpyDeviceToHost));
+        else
+#endif
+            memcpy(archive.data() + offset, l.compressed, l.compressed_len);
+
+        toc[i] = BatchEntry{offset, l.compressed_len, {0}};
+        strncpy(toc[i].name, configs[i].fname.fname.c_str(), sizeof(toc[i].name) - 1);
+    };
+
+    std::future<void> pending[2];
+    for (size_t i = 0; i < std::min<size_t>(nlane, nfield); i++) pending[i] = launch(i);
+
+    for (size_t i = 0; i < nfield; i++) {
+        pending[i % nlane].get();
+        collect(i);
+        if (i + nlane < nfield) pending[i % nlane] = launch(i + nlane);
+    }
+
+    BatchHeader header{};
+    memcpy(header.magic, BATCH_MAGIC, sizeof(BATCH_MAGIC));
+    header.version    = BatchHelper::VERSION;
+    header.nfield     = nfield;
+    header.toc_offset = archive.size();
+
+    archive.insert(
+        archive.end(), reinterpret_cast<uint8_t*>(toc.data()), reinterpret_cast<uint8_t*>(toc.data() + nfield));
+
+    header.total_nbyte = archive.size();
+    memcpy(archive.data(), &header, sizeof(header));
+
+#ifndef CUSZ_HOST_ONLY
+    for (auto k = 0u; k < nlane; k++)
+        if (own_stream[k]) cudaStreamDestroy(lanes[k].stream);
+#endif
+
+    return archive.size();
+}
+
+template <class Compressor, typename T>
+void cusz::decompress_batch(
+    uint8_t*              archive,
+    size_t const          archive_len,
+    T**                   fields,
+    cusz_execution_policy policy,
+    cudaStream_t          stream)
+{
+    if (not BatchHelper::is_batch_archive(archive, archive_len))
+        throw std::runtime_error("[batch] input is not a multi-field archive.");
+
+    auto const nfield = BatchHelper::get_nfield(archive);
+    auto const toc    = BatchHelper::get_toc(archive);
+
+#ifndef CUSZ_HOST_ONLY
+    uint8_t* d_in{nullptr};
+    if (policy == CUDA) {
+        size_t max_nbyte = 0;
+        for (auto i = 0u; i < nfield; i++) max_nbyte = std::max<size_t>(max_nbyte, toc[i].nbyte);
+        CHECK_CUDA(cudaMalloc(&d_in, max_nbyte));
+    }
+#endif
+
+    std::unique_ptr<Compressor> compressor;
+    shape_key                   key{};
+
+    for (auto i = 0u; i < nfield; i++) {
+        if (fields[i] == nullptr) continue;
+
+        auto in = archive + toc[i].offset;
+
+        Header header;
+        memcpy(&header, in, sizeof(Header));
+
+        auto _key = shape_key{header.x, header.y, header.z, (size_t)header.radius};
+        if (not compressor or _key != key) {
+            compressor.reset(new Compressor);
+            compressor->init(&header, false, policy);
+            key = _key;
+        }
+
+#ifndef CUSZ_HOST_ONLY
+        if (policy == CUDA) {
+            CHECK_CUDA(cudaMemcpy(d_in, in, toc[i].nbyte, cudaMemcpyHostToDevice));
+            in = d_in;
+        }
+#endif
+        compressor->decompress(&header, in, fields[i], stream, false);
+    }
+
+#ifndef CUSZ_HOST_ONLY
+    if (d_in) cudaFree(d_in);
+#endif
+}
+
+namespace cusz {
+
+using fp32lorenzo    = Framework<float>::LorenzoFeaturedCompressor;
+using fp32lorenzoii  = Framework<float>::LorenzoIIFeaturedCompressor;
+using fp32regression = Framework<float>::RegressionFeaturedCompressor;
+using fp32spline3    = Framework<float>::Spline3FeaturedCompressor;
+
+// clang-format off
+template size_t compress_batch<fp32lorenzo, float>(Context*, float**, size_t const, std::vector<uint8_t>&, cudaStream_t);
+template void decompress_batch<fp32lorenzo, float>(uint8_t*, size_t const, float**, cusz_execution_policy, cudaStream_t);
+
+template size_t compress_batch<fp32lorenzoii, float>(Context*, float**, size_t const, std::vector<uint8_t>&, cudaStream_t);
+template void decompress_batch<fp32lorenzoii, float>(uint8_t*, size_t const, float**, cusz_execution_policy, cudaStream_t);
+
+template size_t compress_batch<fp32regression, float>(Context*, float**, size_t const, std::vector<uint8_t>&, cudaStream_t);
+template void decompress_batch<fp32regression, float>(uint8_t*, size_t const, float**, cusz_execution_policy, cudaStream_t);
+
+template size_t compress_batch<fp32spline3, float>(Context*, float**, size_t const, std::vector<uint8_t>&, cudaStream_t);
+template void decompress_batch<fp32spline3, float>(uint8_t*, size_t const, float**, cusz_execution_policy, cudaStream_t);
+// clang-format on
+
+}  // namespace cusz
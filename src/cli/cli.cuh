@@ -12,6 +12,8 @@
 #ifndef CLI_CUH
 #define CLI_CUH
 
+#include <algorithm>
+#include <fstream>
 #include <string>
 #include <type_traits>
 
@@ -20,6 +22,9 @@
 #include "cli/query.hh"
 #include "cli/timerecord_viewer.hh"
 #include "cuszapi.hh"
+#include "stream.hh"
+#include "utils/io.hh"
+#include "utils/mempool.hh"
 
 namespace cusz {
 
@@ -62,9 +67,17 @@ class CLI {
     }
 
    private:
-    void write_compressed_to_disk(std::string compressed_name, BYTE* compressed, size_t compressed_len)
+    void write_compressed_to_disk(
+        std::string           compressed_name,
+        BYTE*                 compressed,
+        size_t                compressed_len,
+        cusz_execution_policy policy = CUDA)
     {
         Capsule<BYTE> file("cusza");
+        if (policy == CPU) {
+            file.set_len(compressed_len).template set<HOST>(compressed).template to_file<HOST>(compressed_name);
+            return;
+        }
         file.set_len(compressed_len)
             .template set<DEVICE>(compressed)
             .template alloc<HOST>()
@@ -73,22 +86,60 @@ class CLI {
             .template free<HOST_DEVICE>();
     }
 
-    void try_write_decompressed_to_disk(Capsule<T>& xdata, std::string basename, bool skip_write)
+    void try_write_decompressed_to_disk(
+        Capsule<T>&           xdata,
+        std::string           basename,
+        bool                  skip_write,
+        cusz_execution_policy policy = CUDA)
+    {
+        if (skip_write) return;
+        if (policy == CUDA) xdata.device2host();
+        xdata.template to_file<HOST>(basename + ".cuszx");
+    }
+
+    template <typename compressor_t>
+    void construct_stream(context_t ctx, cudaStream_t stream)
     {
-        if (not skip_write) xdata.device2host().template to_file<HOST>(basename + ".cuszx");
+        using Compressor = typename std::remove_pointer<compressor_t>::type;
+
+        auto basename       = (*ctx).fname.fname;
+        auto compressed_len =
+            stream_compress<Compressor, T>(ctx, basename, basename + ".cusza", (*ctx).stream_budget, stream);
+
+        if (ctx->report.cr) printf("(stream) compression ratio: %.2f\n", 1.0 * (*ctx).get_len() * sizeof(T) / compressed_len);
+    }
+
+    template <typename compressor_t>
+    void reconstruct_stream(context_t ctx, cudaStream_t stream)
+    {
+        using Compressor = typename std::remove_pointer<compressor_t>::type;
+
+        auto basename = (*ctx).fname.fname;
+        auto xname    = (*ctx).skip.write2disk ? std::string("") : basename + ".cuszx";
+        stream_decompress<Compressor, T>(basename + ".cusza", xname, (*ctx).policy, stream);
+
+        if ((*ctx).fname.origin_cmp != "")
+            LOGGING(LOG_WARN, "comparing to the origin is not supported for multi-segment archives; skipped");
     }
 
     template <typename compressor_t>
     void construct(context_t ctx, compressor_t compressor, cudaStream_t stream)
     {
+        if ((*ctx).stream_budget != 0) return construct_stream<compressor_t>(ctx, stream);
+
         Capsule<T> input("uncompressed");
         BYTE*      compressed;
         size_t     compressed_len;
         Header     header;
         auto       len      = (*ctx).get_len();
         auto       basename = (*ctx).fname.fname;
+        auto       policy   = (*ctx).policy;
 
         auto load_uncompressed = [&](std::string fname) {
+            if (policy == CPU) {
+                input.set_len(len).template alloc<HOST>(1.03).template from_file<HOST>(fname);
+                return;
+            }
             input
                 .set_len(len)  //
                 .template alloc<HOST_DEVICE>(1.03)
@@ -97,7 +148,13 @@ class CLI {
         };
 
         auto adjust_eb = [&]() {
-            if ((*ctx).mode == "r2r") (*ctx).eb *= input.prescan().get_rng();
+            if ((*ctx).mode != "r2r") return;
+            if (policy == CPU) {
+                auto res = std::minmax_element(input.hptr, input.hptr + len);
+                (*ctx).eb *= (*res.second - *res.first);
+            }
+            else
+                (*ctx).eb *= input.prescan().get_rng();
         };
 
         /******************************************************************************/
@@ -107,22 +164,38 @@ class CLI {
 
         TimeRecord timerecord;
 
-        core_compress(compressor, ctx, input.dptr, len * 1.03, compressed, compressed_len, header, stream, &timerecord);
+        auto uncompressed = policy == CPU ? input.hptr : input.dptr;
+        core_compress(
+            compressor, ctx, uncompressed, len * 1.03, compressed, compressed_len, header, stream, &timerecord);
 
         if (ctx->report.time) TimeRecordViewer::view_compression(&timerecord, input.nbyte(), compressed_len);
-        write_compressed_to_disk(basename + ".cusza", compressed, compressed_len);
+        if (ctx->report.memory) default_memory_resource()->print_stat();
+        write_compressed_to_disk(basename + ".cusza", compressed, compressed_len, policy);
     }
 
     template <typename compressor_t>
     void reconstruct(context_t ctx, compressor_t compressor, cudaStream_t stream)
     {
-        Capsule<BYTE> compressed("compressed");
-        Capsule<T>    decompressed("decompressed"), original("cmp");
-        auto          header   = new Header;
-        auto          basename = (*ctx).fname.fname;
+        if (StreamHelper::is_stream_archive((*ctx).fname.fname + ".cusza"))
+            return reconstruct_stream<compressor_t>(ctx, stream);
+
+        Capsule<BYTE>   compressed("compressed");
+        Capsule<T>      decompressed("decompressed"), original("cmp");
+        Header*         header;
+        auto            basename = (*ctx).fname.fname;
+        auto            policy   = (*ctx).policy;
+        io::mapped_file archive, xfile;  // host policy: the archive is read in place, the output written in place
+        size_t          archive_nbyte;
 
         auto load_compressed = [&](std::string compressed_name) {
+            if (policy == CPU) {
+                archive       = io::mapped_file::open_read(compressed_name);
+                archive_nbyte = archive.nbyte();
+                compressed.set_len(archive_nbyte).template set<HOST>(archive.data());
+                return;
+            }
             auto compressed_len = ConfigHelper::get_filesize(compressed_name);
+            archive_nbyte       = compressed_len;
             compressed.set_len(compressed_len)
                 .template alloc<HOST_DEVICE>()
                 .template from_file<HOST>(compressed_name)
@@ -132,38 +205,100 @@ class CLI {
         /******************************************************************************/
 
         load_compressed(basename + ".cusza");
-        memcpy(header, compressed.hptr, sizeof(Header));
+        // a truncated or corrupt archive is refused before anything past the header is read
+        if (archive_nbyte < sizeof(Header)) throw std::runtime_error("The archive is shorter than its header.");
+        if (policy == CPU)
+            header = archive.data<Header>();
+        else {
+            header = new Header;
+            memcpy(header, compressed.hptr, sizeof(Header));
+        }
+        if (ConfigHelper::get_filesize(header) != archive_nbyte)
+            throw std::runtime_error("The archive size mismatches the description in its header.");
+        for (auto i = 0; i < Header::END; i++)
+            if (header->entry[i] > header->entry[i + 1])
+                throw std::runtime_error("The archive header is corrupt: subfile offsets are not in order.");
         auto len = ConfigHelper::get_uncompressed_len(header);
 
-        decompressed  //
-            .set_len(len)
-            .template alloc<HOST_DEVICE>(1.03);
+        decompressed.set_len(len);
+        if (policy == CPU and not(*ctx).skip.write2disk) {
+            // sized with the 1.03x workspace; cut to the data size once done
+            xfile = io::mapped_file::create(basename + ".cuszx", (size_t)(sizeof(T) * len * 1.03) + sizeof(T));
+            decompressed.template set<HOST>(xfile.data<T>());
+        }
+        else if (policy == CPU)
+            decompressed.template alloc<HOST>(1.03);
+        else
+            decompressed.template alloc<HOST_DEVICE>(1.03);
         original.set_len(len);
 
         TimeRecord timerecord;
 
         core_decompress(
-            compressor, header, compressed.dptr, ConfigHelper::get_filesize(header), decompressed.dptr, len * 1.03,
-            stream, &timerecord);
+            compressor, header, policy == CPU ? compressed.hptr : compressed.dptr, archive_nbyte,
+            policy == CPU ? decompressed.hptr : decompressed.dptr, len * 1.03, stream, &timerecord, policy);
 
         if (ctx->report.time) TimeRecordViewer::view_decompression(&timerecord, decompressed.nbyte());
-        QualityViewer::view(header, decompressed, original, (*ctx).fname.origin_cmp);
-        try_write_decompressed_to_disk(decompressed, basename, (*ctx).skip.write2disk);
+        if (ctx->report.memory) default_memory_resource()->print_stat();
+        QualityViewer::view(header, decompressed, original, (*ctx).fname.origin_cmp, policy == CPU);
+        if (xfile.data())
+            xfile.close(sizeof(T) * len);
+        else
+            try_write_decompressed_to_disk(decompressed, basename, (*ctx).skip.write2disk, policy);
+    }
+
+    // as recorded in the archive (the first segment of a multi-segment one); `otherwise` if it cannot be read
+    static std::string archived_predictor(std::string const& fname, std::string const& otherwise)
+    {
+        std::ifstream ifs(fname, std::ios::binary);
+        size_t        offset = 0;
+
+        if (StreamHelper::is_stream_archive(fname)) {
+            StreamHeader  stream_header;
+            StreamSegment first;
+            ifs.read(reinterpret_cast<char*>(&stream_header), sizeof(StreamHeader));
+            ifs.seekg(stream_header.index_offset);
+            ifs.read(reinterpret_cast<char*>(&first), sizeof(StreamSegment));
+            offset = first.offset;
+        }
+
+        Header header;
+        ifs.seekg(offset);
+        ifs.read(reinterpret_cast<char*>(&header), sizeof(Header));
+        if (not ifs) return otherwise;
+
+        // version-1 archives do not record the predictor; Lorenzo was the only one then
+        if (header.get_version() < 2) return "lorenzo";
+        if (header.predictor == Spline3) return "spline3";
+        if (header.predictor == LorenzoII) return "lorenzoii";
+        if (header.predictor == Regression) return "regression";
+        return "lorenzo";
     }
 
    public:
-    // TODO determine dtype & predictor in here
+    // TODO determine dtype in here
     void dispatch(context_t ctx)
     {
         auto predictor = (*ctx).predictor;
+        // decompression alone follows the archive
+        if ((*ctx).cli_task.reconstruct and not(*ctx).cli_task.construct)
+            predictor = archived_predictor((*ctx).fname.fname + ".cusza", predictor);
+
         if (predictor == "lorenzo") {
             using Compressor = typename Framework<Data>::LorenzoFeaturedCompressor;
             dispatch_task<Compressor>(ctx);
         }
+        else if (predictor == "lorenzoii") {
+            using Compressor = typename Framework<Data>::LorenzoIIFeaturedCompressor;
+            dispatch_task<Compressor>(ctx);
+        }
+        else if (predictor == "regression") {
+            using Compressor = typename Framework<Data>::RegressionFeaturedCompressor;
+            dispatch_task<Compressor>(ctx);
+        }
         else if (predictor == "spline3") {
-            // using Compressor = typename Framework<Data>::Spline3FeaturedCompressor;
-            throw std::runtime_error("Spline3 based compressor is not ready.");
-            // dispatch_task<Compressor>(ctx);
+            using Compressor = typename Framework<Data>::Spline3FeaturedCompressor;
+            dispatch_task<Compressor>(ctx);
         }
         else {
             using Compressor = typename Framework<Data>::DefaultCompressor;
@@ -178,8 +313,8 @@ class CLI {
         using Predictor = typename Compressor::Predictor;
         auto compressor = new Compressor;
 
-        cudaStream_t stream;
-        CHECK_CUDA(cudaStreamCreate(&stream));
+        cudaStream_t stream{nullptr};
+        if ((*ctx).policy == CUDA) CHECK_CUDA(cudaStreamCreate(&stream));
 
         if ((*ctx).cli_task.dryrun) dryrun<Predictor>(ctx);
 
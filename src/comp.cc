@@ -11,9 +11,6 @@
 
 #include <stdexcept>
 
-#include <thrust/device_ptr.h>
-#include <thrust/extrema.h>
-
 #include "component.hh"
 #include "cusz.h"
 #include "cusz/cc2c.h"
@@ -25,11 +22,7 @@ cusz_compressor* cusz_create(cusz_framework* framework, cusz_datatype type)
 
 cusz_error_status cusz_commit_space(cusz_compressor* comp, cusz_len const reserved_mem, cusz_framework* adjusted)
 {
-    if (adjusted)
-        return comp->commit_space(reserved_mem, adjusted);
-    else {
-    }
-    return CUSZ_SUCCESS;
+    return comp->commit_space(reserved_mem, adjusted);
 }
 
 cusz_error_status cusz_release(cusz_compressor* comp)
@@ -49,15 +49,27 @@ PREDICTION& PREDICTION::operator=(PREDICTION&&) = default;
 //------------------------------------------------------------------------------
 
 THE_TYPE
-void PREDICTION::init(cusz_predictortype predictor, size_t x, size_t y, size_t z, bool dbg_print)
+void PREDICTION::set_memory_resource(memory_resource* mem) { pimpl->set_memory_resource(mem); }
+
+THE_TYPE
+void PREDICTION::set_outlier_density_factor(int factor) { pimpl->set_outlier_density_factor(factor); }
+
+THE_TYPE
+void PREDICTION::init(
+    cusz_predictortype    predictor,
+    size_t                x,
+    size_t                y,
+    size_t                z,
+    bool                  dbg_print,
+    cusz_execution_policy policy)
 {
-    pimpl->init(predictor, x, y, z, dbg_print);
+    pimpl->init(predictor, x, y, z, dbg_print, policy);
 }
 
 THE_TYPE
-void PREDICTION::init(cusz_predictortype predictor, dim3 xyz, bool dbg_print)
+void PREDICTION::init(cusz_predictortype predictor, dim3 xyz, bool dbg_print, cusz_execution_policy policy)
 {
-    pimpl->init(predictor, xyz, dbg_print);
+    pimpl->init(predictor, xyz, dbg_print, policy);
 }
 
 THE_TYPE
@@ -68,11 +80,17 @@ void PREDICTION::construct(
     T**                out_anchor,
     E**                out_errctrl,
     T**                out_outlier,
+    uint32_t**         out_outlier_idx,
+    uint32_t*          out_num_outliers,
     double const       eb,
     int const          radius,
-    cudaStream_t       stream)
+    cudaStream_t       stream,
+    uint32_t*          out_freq,
+    int const          nbin)
 {
-    pimpl->construct(predictor, len3, in_data, out_anchor, out_errctrl, out_outlier, eb, radius, stream);
+    pimpl->construct(
+        predictor, len3, in_data, out_anchor, out_errctrl, out_outlier, out_outlier_idx, out_num_outliers, eb, radius,
+        stream, out_freq, nbin);
 }
 
 THE_TYPE
@@ -90,6 +108,34 @@ void PREDICTION::reconstruct(
     pimpl->reconstruct(predictor, len3, in_outlier__out_xdata, in_anchor, in_errctrl, eb, radius, stream);
 }
 
+THE_TYPE
+void PREDICTION::reconstruct_region(
+    cusz_predictortype predictor,
+    dim3               len3,
+    T*                 in_outlier__out_xdata,
+    E*                 in_errctrl,
+    double const       eb,
+    int const          radius,
+    dim3               region_lo3,
+    dim3               region_hi3)
+{
+    pimpl->reconstruct_region(predictor, len3, in_outlier__out_xdata, in_errctrl, eb, radius, region_lo3, region_hi3);
+}
+
+THE_TYPE
+void PREDICTION::reconstruct_slab(
+    cusz_predictortype predictor,
+    dim3               len3,
+    T*                 in_outlier__out_xdata,
+    E*                 in_errctrl,
+    double const       eb,
+    int const          radius,
+    size_t const       begin,
+    size_t const       end)
+{
+    pimpl->reconstruct_slab(predictor, len3, in_outlier__out_xdata, in_errctrl, eb, radius, begin, end);
+}
+
 THE_TYPE
 void PREDICTION::clear_buffer() { pimpl->clear_buffer(); }
 
@@ -130,8 +176,17 @@ template struct cusz::PredictionUnified<float, uint16_t, float>;
 template struct cusz::PredictionUnified<float, uint32_t, float>;
 template struct cusz::PredictionUnified<float, float, float>;
 
-// template struct cusz::PredictorSpline3<float, uint32_t, float>;
-// template struct cusz::PredictorSpline3<float, float, float>;
+template struct cusz::PredictorLorenzoII<float, uint16_t, float>;
+template struct cusz::PredictorLorenzoII<float, uint32_t, float>;
+template struct cusz::PredictorLorenzoII<float, float, float>;
+
+template struct cusz::PredictorRegression<float, uint16_t, float>;
+template struct cusz::PredictorRegression<float, uint32_t, float>;
+template struct cusz::PredictorRegression<float, float, float>;
+
+template struct cusz::PredictorSpline3<float, uint16_t, float>;
+template struct cusz::PredictorSpline3<float, uint32_t, float>;
+template struct cusz::PredictorSpline3<float, float, float>;
 
 #undef THE_TYPE
 #undef IMPL
\ No newline at end of file
@@ -10,7 +10,7 @@
  */
 
 #include "component/spcodec_vec.hh"
-#include <cuda_runtime.h>
+#include "cusz/cuda_compat.h"
 
 namespace cusz {
 
@@ -52,9 +52,21 @@ SpcodecVec<T, M>& SpcodecVec<T, M>::operator=(SpcodecVec<T, M>&&) = default;
 //------------------------------------------------------------------------------
 
 template <typename T, typename M>
-void SpcodecVec<T, M>::init(size_t const len, int density_factor, bool dbg_print)
+void SpcodecVec<T, M>::set_memory_resource(memory_resource* mem)
 {
-    pimpl->init(len, density_factor, dbg_print);
+    pimpl->set_memory_resource(mem);
+}
+
+template <typename T, typename M>
+void SpcodecVec<T, M>::set_value_coding(cusz_spcodec_valcoding coding)
+{
+    pimpl->set_value_coding(coding);
+}
+
+template <typename T, typename M>
+void SpcodecVec<T, M>::init(size_t const len, int density_factor, bool dbg_print, cusz_execution_policy policy)
+{
+    pimpl->init(len, density_factor, dbg_print, policy);
 }
 
 template <typename T, typename M>
@@ -69,12 +81,32 @@ void SpcodecVec<T, M>::encode(
     pimpl->encode(in, in_len, out, out_len, stream, dbg_print);
 }
 
+template <typename T, typename M>
+void SpcodecVec<T, M>::encode_compacted(
+    T*           val,
+    uint32_t*    idx,
+    int const    nnz,
+    size_t const len,
+    BYTE*&       out,
+    size_t&      out_len,
+    cudaStream_t stream,
+    bool         dbg_print)
+{
+    pimpl->encode_compacted(val, idx, nnz, len, out, out_len, stream, dbg_print);
+}
+
 template <typename T, typename M>
 void SpcodecVec<T, M>::decode(BYTE* coded, T* decoded, cudaStream_t stream)
 {
     pimpl->decode(coded, decoded, stream);
 }
 
+template <typename T, typename M>
+void SpcodecVec<T, M>::decode_region(BYTE* coded, size_t const* ranges, size_t const nrange, T* decoded)
+{
+    pimpl->decode_region(coded, ranges, nrange, decoded);
+}
+
 template <typename T, typename M>
 void SpcodecVec<T, M>::clear_buffer()
 {
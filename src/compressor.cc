@@ -46,6 +46,12 @@ Compressor<B>& Compressor<B>::operator=(Compressor<B>&&) = default;
 
 //------------------------------------------------------------------------------
 
+template <class B>
+void Compressor<B>::set_memory_resource(memory_resource* mem)
+{
+    pimpl->set_memory_resource(mem);
+}
+
 template <class B>
 void Compressor<B>::init(Context* config, bool dbg_print)
 {
@@ -53,9 +59,9 @@ void Compressor<B>::init(Context* config, bool dbg_print)
 }
 
 template <class B>
-void Compressor<B>::init(Header* config, bool dbg_print)
+void Compressor<B>::init(Header* config, bool dbg_print, cusz_execution_policy policy)
 {
-    pimpl->init(config, dbg_print);
+    pimpl->init(config, dbg_print, policy);
 }
 
 template <class B>
@@ -81,6 +87,17 @@ void Compressor<B>::decompress(
     pimpl->decompress(config, compressed, decompressed, stream, dbg_print);
 }
 
+template <class B>
+void Compressor<B>::decompress_region(
+    Header*           config,
+    BYTE*             compressed,
+    dim3              region_lo3,
+    dim3              region_hi3,
+    Compressor<B>::T* decompressed_region)
+{
+    pimpl->decompress_region(config, compressed, region_lo3, region_hi3, decompressed_region);
+}
+
 template <class B>
 void Compressor<B>::clear_buffer()
 {
@@ -114,6 +131,7 @@ namespace cusz {
 
 int CompressorHelper::autotune_coarse_parvle(Context* ctx)
 {
+#ifndef CUSZ_HOST_ONLY
     auto tune_coarse_huffman_sublen = [](size_t len) {
         int current_dev = 0;
         cudaSetDevice(current_dev);
@@ -136,9 +154,11 @@ int CompressorHelper::autotune_coarse_parvle(Context* ctx)
     };
 
     // TODO should be move to somewhere else, e.g., cusz::par_optmizer
-    if (ctx->use.autotune_vle_pardeg)
+    // no device to query on host; the given sublen is kept as is
+    if (ctx->use.autotune_vle_pardeg and ctx->policy == CUDA)
         get_coarse_pardeg(ctx->data_len, ctx->vle_sublen, ctx->vle_pardeg);
     else
+#endif
         ctx->vle_pardeg = ConfigHelper::get_npart(ctx->data_len, ctx->vle_sublen);
 
     return ctx->vle_pardeg;
@@ -147,4 +167,6 @@ int CompressorHelper::autotune_coarse_parvle(Context* ctx)
 }  // namespace cusz
 
 template class cusz::Compressor<cusz::PredefinedCombination<float>::LorenzoFeatured>;
-// template class cusz::Compressor<cusz::PredefinedCombination<float>::Spline3Featured>;
+template class cusz::Compressor<cusz::PredefinedCombination<float>::LorenzoIIFeatured>;
+template class cusz::Compressor<cusz::PredefinedCombination<float>::RegressionFeatured>;
+template class cusz::Compressor<cusz::PredefinedCombination<float>::Spline3Featured>;
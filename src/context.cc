@@ -29,6 +29,20 @@ const int   COMPATIBILITY = 0;
 
 namespace {
 
+cusz_execution_policy parse_policy(std::string const& v)
+{
+    if (v == "cpu" or v == "host") return CPU;
+    if (v == "cuda" or v == "gpu" or v == "device") return CUDA;
+    throw std::runtime_error("Unknown execution policy \"" + v + "\"; use cpu or cuda.");
+}
+
+cusz_spcodec_valcoding parse_spcodec_valcoding(std::string const& v)
+{
+    if (v == "raw") return RawValue;
+    if (v == "xor") return XorValue;
+    throw std::runtime_error("Unknown outlier value coding \"" + v + "\"; use raw or xor.");
+}
+
 void set_preprocess(cusz::context_t ctx, const char* in_str)
 {
     str_list opts;
@@ -54,6 +68,8 @@ void set_report(cusz::context_t ctx, const char* in_str)
                 ctx->report.compressibility = kv.second;
             else if (kv.first == "time")
                 ctx->report.time = kv.second;
+            else if (kv.first == "memory")
+                ctx->report.memory = kv.second;
         }
         else {
             if (o == "cr")
@@ -62,6 +78,8 @@ void set_report(cusz::context_t ctx, const char* in_str)
                 ctx->report.compressibility = true;
             else if (o == "time")
                 ctx->report.time = true;
+            else if (o == "memory")
+                ctx->report.memory = true;
         }
     }
 }
@@ -148,6 +166,15 @@ void set_config(cusz::context_t ctx, const char* in_str, bool dbg_print = false)
         else if (optmatch({"pipeline"})) {
             ctx->pipeline = v;
         }
+        else if (optmatch({"policy"})) {
+            ctx->policy = parse_policy(v);
+        }
+        else if (optmatch({"stream", "streambudget"})) {  // in MiB
+            ctx->stream_budget = StrHelper::str2int(v) * (1ul << 20);
+        }
+        else if (optmatch({"spval"})) {
+            ctx->spcodec_valcoding = parse_spcodec_valcoding(v);
+        }
         else if (optmatch({"density"})) {  // refer to `SparseMethodSetup` in `config.hh`
             ctx->nz_density        = StrHelper::str2fp(v);
             ctx->nz_density_factor = 1 / ctx->nz_density;
@@ -277,6 +304,14 @@ void set_from_cli_input(cusz::context_t ctx, int const argc, char** const argv)
                 check_next();
                 ctx->pipeline = std::string(argv[++i]);
             }
+            else if (optmatch({"--policy"})) {
+                check_next();
+                ctx->policy = parse_policy(std::string(argv[++i]));
+            }
+            else if (optmatch({"--stream"})) {  // in MiB
+                check_next();
+                ctx->stream_budget = StrHelper::str2int(argv[++i]) * (1ul << 20);
+            }
             else if (optmatch({"--demo"})) {
                 check_next();
                 ctx->use.predefined_demo = true;
@@ -9,6 +9,8 @@
  *
  */
 
+#include <type_traits>
+
 #include "cusz/cc2c.h"
 #include "compressor.hh"
 #include "context.hh"
@@ -25,26 +27,115 @@ cusz_error_status cusz_compressor::commit_framework(cusz_framework* _framework)
     return CUSZ_SUCCESS;
 }
 
+namespace {
+
+// the compressor (of FP32) follows the predictor; f gets `compressor` as one
+template <class FUNC>
+void with_compressor(cusz_predictortype predictor, void* compressor, FUNC&& f)
+{
+    if (predictor == LorenzoII)
+        f(static_cast<cusz::Framework<float>::LorenzoIIFeaturedCompressor*>(compressor));
+    else if (predictor == Spline3)
+        f(static_cast<cusz::Framework<float>::Spline3FeaturedCompressor*>(compressor));
+    else if (predictor == Regression)
+        f(static_cast<cusz::Framework<float>::RegressionFeaturedCompressor*>(compressor));
+    else
+        f(static_cast<cusz::Framework<float>::DefaultCompressor*>(compressor));
+}
+
+// Lorenzo0 is not implemented, and an archive of before the field says 0 for LorenzoI
+cusz_predictortype usable(cusz_predictortype predictor) { return predictor == Lorenzo0 ? LorenzoI : predictor; }
+
+cusz_predictortype predictor_of(cusz_framework* framework)
+{
+    return framework ? usable(framework->predictor.type) : LorenzoI;
+}
+
+cusz_execution_policy policy_of(cusz_framework* framework)
+{
+    return framework and framework->execution == Host ? CPU : CUDA;
+}
+
+// what Compressor::init() sizes the buffers by, from a context (compression) or a header (decompression)
+template <class CONFIG>
+cusz_compressor::plan_t plan_of(CONFIG* config, cusz_predictortype predictor, cusz_execution_policy policy)
+{
+    cusz_compressor::plan_t plan;
+    plan.x                 = (*config).x;
+    plan.y                 = (*config).y;
+    plan.z                 = (*config).z;
+    plan.radius            = (*config).radius;
+    plan.pardeg            = (*config).vle_pardeg;
+    plan.nz_density_factor = (*config).nz_density_factor;
+    plan.codecs_in_use     = (*config).codecs_in_use;
+    plan.predictor         = predictor;
+    plan.policy            = policy;
+    return plan;
+}
+
+}  // namespace
+
 cusz_compressor::cusz_compressor(cusz_framework* _framework, cusz_datatype _type) : type(_type)
 {
     framework = _framework;
 
     if (type == FP32) {
-        using DATA       = float;
-        using Compressor = cusz::Framework<DATA>::DefaultCompressor;
-
-        this->compressor = new Compressor();
+        plan.predictor = predictor_of(framework);
+        with_compressor(plan.predictor, nullptr, [&](auto* _) { this->compressor = new std::decay_t<decltype(*_)>(); });
     }
     else {
         throw std::runtime_error("Type is not supported.");
     }
+
+    context = new cusz_context();
+}
+
+cusz_compressor::~cusz_compressor()
+{
+    if (type == FP32) with_compressor(plan.predictor, compressor, [](auto* c) { delete c; });
+    delete static_cast<cusz_context*>(context);
+}
+
+bool cusz_compressor::replan(plan_t const& next)
+{
+    if (space_initialized and next == plan) return false;
+
+    if (type == FP32) {
+        // init() does not release what a previous one allocated; a predictor needs a compressor of its own
+        if (space_initialized or next.predictor != plan.predictor) {
+            with_compressor(plan.predictor, compressor, [](auto* c) { delete c; });
+            with_compressor(next.predictor, nullptr, [&](auto* _) { compressor = new std::decay_t<decltype(*_)>(); });
+        }
+    }
+    else {
+        throw std::runtime_error(std::string(__FUNCTION__) + ": Type is not supported.");
+    }
+
+    plan              = next;
+    space_initialized = true;
+    num_init++;
+    return true;
 }
 
 cusz_error_status cusz_compressor::commit_space(cusz_len const reserved_mem, cusz_framework* adjusted)
 {
-    // TODO adjust framework here
+    if (adjusted) commit_framework(adjusted);
+
+    auto ctx = static_cast<cusz_context*>(context);
+    ctx->set_len(reserved_mem.x, reserved_mem.y, reserved_mem.z, reserved_mem.w);
+    if (framework) ctx->set_radius(framework->quantization.radius);
+    cusz::CompressorHelper::autotune_coarse_parvle(ctx);
+
+    if (type == FP32) {
+        auto next = plan_of(ctx, predictor_of(framework), policy_of(framework));
+        ctx->set_policy(next.policy);
+        if (replan(next)) with_compressor(plan.predictor, compressor, [&](auto* c) { c->init(ctx); });
+    }
+    else {
+        throw std::runtime_error(std::string(__FUNCTION__) + ": Type is not supported.");
+    }
+    memlen = datalen = reserved_mem;
 
-    // end of adjusting framework
     return CUSZ_SUCCESS;
 }
 
@@ -72,30 +163,35 @@ cusz_error_status cusz_compressor::compress(
 {
     // cusz::TimeRecord cpp_record;
 
-    context = new cusz_context();
-    static_cast<cusz_context*>(context)
-        ->set_len(uncomp_len.x, uncomp_len.y, uncomp_len.z, uncomp_len.w)
-        .set_eb(config->eb)
-        .set_control_string(config->eb == Rel ? "mode=r2r" : "mode=abs");
+    auto ctx = static_cast<cusz_context*>(context);
 
-    // Be cautious of autotuning! The default value of pardeg is not robust.
-    cusz::CompressorHelper::autotune_coarse_parvle(static_cast<cusz_context*>(context));
+    auto same_len = [](cusz_len const& a, cusz_len const& b) {
+        return a.x == b.x and a.y == b.y and a.z == b.z and a.w == b.w;
+    };
 
-    // TODO how to check effectively?
-    size_t len1d = uncomp_len.x * uncomp_len.y * uncomp_len.z * uncomp_len.factor;
+    // the shape decides the plan; autotuning (device query included) is redone only when it changes
+    if (not space_initialized or not same_len(uncomp_len, datalen)) {
+        ctx->set_len(uncomp_len.x, uncomp_len.y, uncomp_len.z, uncomp_len.w);
+        // Be cautious of autotuning! The default value of pardeg is not robust.
+        cusz::CompressorHelper::autotune_coarse_parvle(ctx);
+        datalen = uncomp_len;
+    }
+    if (framework) ctx->set_radius(framework->quantization.radius);
+    ctx->set_eb(config->eb).set_control_string(config->mode == Rel ? "mode=r2r" : "mode=abs");
 
     if (type == FP32) {
-        using DATA       = float;
-        using Compressor = cusz::Framework<DATA>::DefaultCompressor;
-
-        // TODO add memlen & datalen comparison
-        static_cast<Compressor*>(this->compressor)->init(static_cast<cusz_context*>(context));
-        static_cast<Compressor*>(this->compressor)
-            ->compress(
-                static_cast<cusz_context*>(context), static_cast<DATA*>(uncompressed), *compressed, *comp_bytes,
-                stream);
-        static_cast<Compressor*>(this->compressor)->export_header(*header);
-        static_cast<Compressor*>(this->compressor)->export_timerecord((cusz::TimeRecord*)record);
+        using DATA = float;
+
+        auto next = plan_of(ctx, predictor_of(framework), policy_of(framework));
+        ctx->set_policy(next.policy);
+        auto fresh = replan(next);
+
+        with_compressor(plan.predictor, compressor, [&](auto* c) {
+            if (fresh) c->init(ctx);
+            c->compress(ctx, static_cast<DATA*>(uncompressed), *compressed, *comp_bytes, stream);
+            c->export_header(*header);
+            c->export_timerecord((cusz::TimeRecord*)record);
+        });
     }
     else {
         throw std::runtime_error(std::string(__FUNCTION__) + ": Type is not supported.");
@@ -116,13 +212,19 @@ cusz_error_status cusz_compressor::decompress(
     // cusz::TimeRecord cpp_record;
 
     if (type == FP32) {
-        using DATA       = float;
-        using Compressor = cusz::Framework<DATA>::DefaultCompressor;
-
-        static_cast<Compressor*>(this->compressor)->init(header);
-        static_cast<Compressor*>(this->compressor)
-            ->decompress(header, compressed, static_cast<DATA*>(decompressed), stream);
-        static_cast<Compressor*>(this->compressor)->export_timerecord((cusz::TimeRecord*)record);
+        using DATA = float;
+
+        // the predictor is what the archive was compressed with; before version 2, only Lorenzo wrote archives, and
+        // whatever was left in `predictor` is not read
+        auto predictor = header->get_version() < 2 ? LorenzoI : usable((cusz_predictortype)header->predictor);
+        auto next      = plan_of(header, predictor, policy_of(framework));
+        auto fresh     = replan(next);
+
+        with_compressor(plan.predictor, compressor, [&](auto* c) {
+            if (fresh) c->init(header, false, plan.policy);
+            c->decompress(header, compressed, static_cast<DATA*>(decompressed), stream);
+            c->export_timerecord((cusz::TimeRecord*)record);
+        });
     }
     else {
         throw std::runtime_error(std::string(__FUNCTION__) + ": Type is not supported.");
@@ -45,14 +45,15 @@ void core_compress(
 
 template <class Compressor, typename T>
 void core_decompress(
-    Compressor*  compressor,
-    Header*      config,
-    uint8_t*     compressed,
-    size_t       compressed_len,
-    T*           decompressed,
-    size_t       decompressed_alloc_len,
-    cudaStream_t stream,
-    TimeRecord*  timerecord)
+    Compressor*           compressor,
+    Header*               config,
+    uint8_t*              compressed,
+    size_t                compressed_len,
+    T*                    decompressed,
+    size_t                decompressed_alloc_len,
+    cudaStream_t          stream,
+    TimeRecord*           timerecord,
+    cusz_execution_policy policy)
 {
     STASTIC_ASSERT();
 
@@ -69,31 +70,76 @@ void core_decompress(
                 "cuSZ requires the allocation for `decompressed` to at least 1.03x the original size.");
     }
 
-    (*compressor).init(config);
+    (*compressor).init(config, false, policy);
     (*compressor).decompress(config, compressed, decompressed, stream);
     (*compressor).export_timerecord(timerecord);
 }
 
+template <class Compressor, typename T>
+void core_decompress_region(
+    Compressor* compressor,
+    Header*     config,
+    uint8_t*    compressed,
+    size_t      compressed_len,
+    dim3        region_lo3,
+    dim3        region_hi3,
+    T*          decompressed_region,
+    TimeRecord* timerecord)
+{
+    STASTIC_ASSERT();
+
+    {  // runtime check
+        if (compressor == nullptr) throw std::runtime_error("`compressor` cannot be null.");
+        if (config == nullptr) throw std::runtime_error("`config` cannot be null.");
+        if (compressed == nullptr) throw std::runtime_error("Input `compressed` cannot be null.");
+        if (compressed_len != ConfigHelper::get_filesize(config))
+            throw std::runtime_error("`compressed_len` mismatches the description in header.");
+        if (decompressed_region == nullptr)
+            throw std::runtime_error("Output `decompressed_region` cannot be null: must be allocated before API call.");
+    }
+
+    (*compressor).init(config, false, CPU);
+    (*compressor).decompress_region(config, compressed, region_lo3, region_hi3, decompressed_region);
+    (*compressor).export_timerecord(timerecord);
+}
+
 }  // namespace cusz
 
 namespace cusz {
 
-using fp32lorenzo = Framework<float>::LorenzoFeaturedCompressor;
-// using fp32spline3 = Framework<float>::Spline3FeaturedCompressor;
+using fp32lorenzo    = Framework<float>::LorenzoFeaturedCompressor;
+using fp32lorenzoii  = Framework<float>::LorenzoIIFeaturedCompressor;
+using fp32regression = Framework<float>::RegressionFeaturedCompressor;
+using fp32spline3    = Framework<float>::Spline3FeaturedCompressor;
 
 // clang-format off
 
 template void
 core_compress<fp32lorenzo, float>(fp32lorenzo*, Context*, float*, size_t, uint8_t*&, size_t&, Header&, cudaStream_t, TimeRecord*);
 
-// template void
-// core_compress<fp32spline3, float>(fp32spline3*, Context*, float*, size_t, uint8_t*&, size_t&, Header&, cudaStream_t, TimeRecord*);
+template void
+core_compress<fp32spline3, float>(fp32spline3*, Context*, float*, size_t, uint8_t*&, size_t&, Header&, cudaStream_t, TimeRecord*);
+
+template void
+core_decompress<fp32lorenzo, float>(fp32lorenzo*, Header*, uint8_t*, size_t, float*, size_t, cudaStream_t, TimeRecord*, cusz_execution_policy);
+
+template void
+core_decompress_region<fp32lorenzo, float>(fp32lorenzo*, Header*, uint8_t*, size_t, dim3, dim3, float*, TimeRecord*);
 
 template void
-core_decompress<fp32lorenzo, float>(fp32lorenzo*, Header*, uint8_t*, size_t, float*, size_t, cudaStream_t, TimeRecord*);
+core_decompress<fp32spline3, float>(fp32spline3*, Header*, uint8_t*, size_t, float*, size_t, cudaStream_t, TimeRecord*, cusz_execution_policy);
 
-// template void
-// core_decompress<fp32spline3, float>(fp32spline3*, Header*, uint8_t*, size_t, float*, size_t, cudaStream_t, TimeRecord*);
+template void
+core_compress<fp32lorenzoii, float>(fp32lorenzoii*, Context*, float*, size_t, uint8_t*&, size_t&, Header&, cudaStream_t, TimeRecord*);
+
+template void
+core_decompress<fp32lorenzoii, float>(fp32lorenzoii*, Header*, uint8_t*, size_t, float*, size_t, cudaStream_t, TimeRecord*, cusz_execution_policy);
+
+template void
+core_compress<fp32regression, float>(fp32regression*, Context*, float*, size_t, uint8_t*&, size_t&, Header&, cudaStream_t, TimeRecord*);
+
+template void
+core_decompress<fp32regression, float>(fp32regression*, Header*, uint8_t*, size_t, float*, size_t, cudaStream_t, TimeRecord*, cusz_execution_policy);
 
 // clang-format on
 
@@ -12,10 +12,12 @@
 #ifndef C0E747B4_066F_4B04_A3D2_00E1A3B7D682
 #define C0E747B4_066F_4B04_A3D2_00E1A3B7D682
 
+#include <omp.h>
 #include <algorithm>
 #include <cmath>
 #include <cstdint>
 #include <cstdlib>
+#include <vector>
 #include "cusz/type.h"
 
 namespace parsz {
@@ -42,65 +44,149 @@ bool cppstd_error_bounded(T* a, T* b, size_t const len, double const eb, size_t*
     return true;
 }
 
-template <typename T>
-void cppstd_assess_quality(cusz_stats* s, T* xdata, T* odata, size_t const len)
-{
-    double max_odata = odata[0], min_odata = odata[0];
-    double max_xdata = xdata[0], min_xdata = xdata[0];
-    double max_abserr = max_abserr = fabs(xdata[0] - odata[0]);
+// count, means, centered second moments and comoment of (a, b) pairs; merged as in Chan et al.
+struct pair_moments {
+    double n{0}, mean_a{0}, mean_b{0}, m2_a{0}, m2_b{0}, co{0};
 
-    double sum_0 = 0, sum_x = 0;
-    for (size_t i = 0; i < len; i++) sum_0 += odata[i], sum_x += xdata[i];
+    template <typename T>
+    static pair_moments of(T const* a, T const* b, size_t const len)
+    {
+        pair_moments m;
+        if (len == 0) return m;
 
-    double mean_odata = sum_0 / len, mean_xdata = sum_x / len;
-    double sum_var_odata = 0, sum_var_xdata = 0, sum_err2 = 0, sum_corr = 0, rel_abserr = 0;
+        double sum_a = 0, sum_b = 0;
+#pragma omp simd reduction(+ : sum_a, sum_b)
+        for (size_t i = 0; i < len; i++) sum_a += a[i], sum_b += b[i];
 
-    double max_pwrrel_abserr = 0;
-    size_t max_abserr_index  = 0;
-    for (size_t i = 0; i < len; i++) {
-        max_odata = max_odata < odata[i] ? odata[i] : max_odata;
-        min_odata = min_odata > odata[i] ? odata[i] : min_odata;
+        m.n = len, m.mean_a = sum_a / len, m.mean_b = sum_b / len;
+
+        // the block is still in cache, so centering costs no extra pass over memory
+        double m2_a = 0, m2_b = 0, co = 0;
+#pragma omp simd reduction(+ : m2_a, m2_b, co)
+        for (size_t i = 0; i < len; i++) {
+            double da = a[i] - m.mean_a, db = b[i] - m.mean_b;
+            m2_a += da * da, m2_b += db * db, co += da * db;
+        }
+        m.m2_a = m2_a, m.m2_b = m2_b, m.co = co;
+        return m;
+    }
+
+    void merge(pair_moments const& o)
+    {
+        if (o.n == 0) return;
+        auto const n  = this->n + o.n;
+        auto const da = o.mean_a - mean_a, db = o.mean_b - mean_b;
+        auto const w  = this->n * o.n / n;
 
-        max_xdata = max_xdata < odata[i] ? odata[i] : max_xdata;
-        min_xdata = min_xdata > xdata[i] ? xdata[i] : min_xdata;
+        mean_a += da * o.n / n, mean_b += db * o.n / n;
+        m2_a += o.m2_a + da * da * w, m2_b += o.m2_b + db * db * w, co += o.co + da * db * w;
+        this->n = n;
+    }
+
+    double corr() const { return co / sqrt(m2_a * m2_b); }
+};
 
-        float abserr = fabs(xdata[i] - odata[i]);
-        if (odata[i] != 0) {
-            rel_abserr        = abserr / fabs(odata[i]);
-            max_pwrrel_abserr = max_pwrrel_abserr < rel_abserr ? rel_abserr : max_pwrrel_abserr;
+template <typename T>
+void cppstd_assess_quality(cusz_stats* s, T* xdata, T* odata, size_t const len)
+{
+    // per-thread partials over cache-sized blocks, merged in thread order
+    constexpr size_t BLOCK  = 4096;
+    auto const       nblock = (long)((len + BLOCK - 1) / BLOCK);
+
+    struct partial {
+        pair_moments cross, lag1, lag2;  // (odata, xdata), (odata[i], odata[i + 1]), (odata[i], odata[i + 2])
+        double       max_odata{-INFINITY}, min_odata{INFINITY}, max_xdata{-INFINITY}, min_xdata{INFINITY};
+        double       max_abserr{-1}, max_pwrrel_abserr{0}, sum_err2{0};
+        size_t       max_abserr_index{0};
+    };
+
+    auto                 nthread = omp_get_max_threads();
+    std::vector<partial> part(nthread);
+
+#pragma omp parallel num_threads(nthread)
+    {
+        auto& p = part[omp_get_thread_num()];
+
+#pragma omp for schedule(static)
+        for (auto b = 0l; b < nblock; b++) {
+            auto const beg = b * BLOCK, end = std::min(beg + BLOCK, len);
+            auto const o = odata + beg, x = xdata + beg;
+            auto const n = end - beg;
+            // pairs (i, i + lag) starting in the block
+            auto npair = [&](size_t lag) { return len > lag and len - lag > beg ? std::min(end, len - lag) - beg : 0; };
+
+            p.cross.merge(pair_moments::of(o, x, n));
+            p.lag1.merge(pair_moments::of(o, o + 1, npair(1)));
+            p.lag2.merge(pair_moments::of(o, o + 2, npair(2)));
+
+            double max_o = -INFINITY, min_o = INFINITY, max_x = -INFINITY, min_x = INFINITY;
+            double max_err = 0, max_pwrrel = 0, sum_err2 = 0;
+#pragma omp simd reduction(max : max_o, max_x, max_err, max_pwrrel) reduction(min : min_o, min_x) \
+    reduction(+ : sum_err2)
+            for (size_t i = 0; i < n; i++) {
+                double const ov = o[i], xv = x[i], abserr = fabs(xv - ov);
+
+                max_o = std::max(max_o, ov), min_o = std::min(min_o, ov);
+                max_x = std::max(max_x, xv), min_x = std::min(min_x, xv);
+                max_err  = std::max(max_err, abserr);
+                sum_err2 += abserr * abserr;
+                if (ov != 0) max_pwrrel = std::max(max_pwrrel, abserr / fabs(ov));
+            }
+
+            p.max_odata = std::max(p.max_odata, max_o), p.min_odata = std::min(p.min_odata, min_o);
+            p.max_xdata = std::max(p.max_xdata, max_x), p.min_xdata = std::min(p.min_xdata, min_x);
+            p.max_pwrrel_abserr = std::max(p.max_pwrrel_abserr, max_pwrrel);
+            p.sum_err2 += sum_err2;
+
+            // revisit the (cached) block only when it holds a new maximum, for its first index
+            if (max_err > p.max_abserr) {
+                p.max_abserr = max_err;
+                for (size_t i = 0; i < n; i++) {
+                    if (fabs((double)x[i] - (double)o[i]) == max_err) {
+                        p.max_abserr_index = beg + i;
+                        break;
+                    }
+                }
+            }
         }
-        max_abserr_index = max_abserr < abserr ? i : max_abserr_index;
-        max_abserr       = max_abserr < abserr ? abserr : max_abserr;
-        sum_corr += (odata[i] - mean_odata) * (xdata[i] - mean_xdata);
-        sum_var_odata += (odata[i] - mean_odata) * (odata[i] - mean_odata);
-        sum_var_xdata += (xdata[i] - mean_xdata) * (xdata[i] - mean_xdata);
-        sum_err2 += abserr * abserr;
     }
-    double std_odata = sqrt(sum_var_odata / len);
-    double std_xdata = sqrt(sum_var_xdata / len);
-    double ee        = sum_corr / len;
+
+    // threads own ascending ranges of blocks, so ties keep the lowest index
+    auto r = part[0];
+    for (auto t = 1; t < nthread; t++) {
+        auto const& p = part[t];
+        r.cross.merge(p.cross), r.lag1.merge(p.lag1), r.lag2.merge(p.lag2);
+        r.max_odata = std::max(r.max_odata, p.max_odata), r.min_odata = std::min(r.min_odata, p.min_odata);
+        r.max_xdata = std::max(r.max_xdata, p.max_xdata), r.min_xdata = std::min(r.min_xdata, p.min_xdata);
+        r.max_pwrrel_abserr = std::max(r.max_pwrrel_abserr, p.max_pwrrel_abserr);
+        r.sum_err2 += p.sum_err2;
+        if (p.max_abserr > r.max_abserr) r.max_abserr = p.max_abserr, r.max_abserr_index = p.max_abserr_index;
+    }
 
     s->len = len;
 
-    s->odata.max = max_odata;
-    s->odata.min = min_odata;
-    s->odata.rng = max_odata - min_odata;
-    s->odata.std = std_odata;
+    s->odata.max = r.max_odata;
+    s->odata.min = r.min_odata;
+    s->odata.rng = r.max_odata - r.min_odata;
+    s->odata.std = sqrt(r.cross.m2_a / len);
 
-    s->xdata.max = max_xdata;
-    s->xdata.min = min_xdata;
-    s->xdata.rng = max_xdata - min_xdata;
-    s->xdata.std = std_xdata;
+    s->xdata.max = r.max_xdata;
+    s->xdata.min = r.min_xdata;
+    s->xdata.rng = r.max_xdata - r.min_xdata;
+    s->xdata.std = sqrt(r.cross.m2_b / len);
 
-    s->max_err.idx    = max_abserr_index;
-    s->max_err.abs    = max_abserr;
-    s->max_err.rel    = max_abserr / s->odata.rng;
-    s->max_err.pwrrel = max_pwrrel_abserr;
+    s->max_err.idx    = r.max_abserr_index;
+    s->max_err.abs    = r.max_abserr;
+    s->max_err.rel    = r.max_abserr / s->odata.rng;
+    s->max_err.pwrrel = r.max_pwrrel_abserr;
 
-    s->reduced.coeff = ee / std_odata / std_xdata;
-    s->reduced.MSE   = sum_err2 / len;
+    s->reduced.coeff = r.cross.corr();
+    s->reduced.MSE   = r.sum_err2 / len;
     s->reduced.NRMSE = sqrt(s->reduced.MSE) / s->odata.rng;
     s->reduced.PSNR  = 20 * log10(s->odata.rng) - 10 * log10(s->reduced.MSE);
+
+    s->autocor.lag_one = r.lag1.corr();
+    s->autocor.lag_two = r.lag2.corr();
 }
 
 }  // namespace detail
@@ -16,4 +16,6 @@
 #include "framework.hh"
 
 template class cusz::Compressor<cusz::PredefinedCombination<float>::LorenzoFeatured>::impl;
-// template class cusz::Compressor<cusz::PredefinedCombination<float>::Spline3Featured>::impl;  // TODO
+template class cusz::Compressor<cusz::PredefinedCombination<float>::LorenzoIIFeatured>::impl;
+template class cusz::Compressor<cusz::PredefinedCombination<float>::RegressionFeatured>::impl;
+template class cusz::Compressor<cusz::PredefinedCombination<float>::Spline3Featured>::impl;
@@ -18,8 +18,13 @@
 #include <thrust/device_vector.h>
 #include <thrust/execution_policy.h>
 #include <thrust/iterator/permutation_iterator.h>
+#include <thrust/scan.h>
+#include <thrust/sort.h>
 #include <thrust/tuple.h>
 
+#include "kernel/spv_idx.hh"
+#include "kernel/spv_val.hh"
+#include "utils/cuda_err.cuh"
 #include "utils/timer.h"
 
 namespace accsz {
@@ -71,6 +76,200 @@ void spv_scatter(T* d_val, uint32_t* d_idx, int const nnz, T* decoded, float* mi
     DESTROY_CUDAEVENT_PAIR;
 }
 
+template <typename T, typename M>
+void spv_sort(T* d_val, uint32_t* d_idx, int const nnz, float* milliseconds, cudaStream_t stream)
+{
+    CREATE_CUDAEVENT_PAIR;
+    START_CUDAEVENT_RECORDING(stream);
+
+    thrust::sort_by_key(thrust::cuda::par.on(stream), d_idx, d_idx + nnz, d_val);
+
+    STOP_CUDAEVENT_RECORDING(stream);
+    TIME_ELAPSED_CUDAEVENT(milliseconds);
+    DESTROY_CUDAEVENT_PAIR;
+}
+
+// one thread per block of spv_idx_layout; writes first[b] and the number of packed words to start[b + 1]
+__global__ void spv_idx_width(uint32_t const* idx, int const nnz, uint32_t* first, uint32_t* start)
+{
+    using L = spv_idx_layout;
+
+    auto b = blockIdx.x * blockDim.x + threadIdx.x;
+    if (b >= L::nblock(nnz)) return;
+
+    auto const beg = b * L::BLOCK, end = beg + L::count(nnz, b);
+
+    uint32_t any = 0;
+    for (auto i = beg + 1; i < end; i++) any |= idx[i] - idx[i - 1] - 1;
+
+    first[b]     = idx[beg];
+    start[b + 1] = L::nword(end - beg, spv_bit_width(any));
+}
+
+__global__ void spv_idx_pack_block(uint32_t const* idx, int const nnz, uint32_t const* start, uint32_t* packed)
+{
+    using L = spv_idx_layout;
+
+    auto b = blockIdx.x * blockDim.x + threadIdx.x;
+    if (b >= L::nblock(nnz)) return;
+
+    auto const beg = b * L::BLOCK, end = beg + L::count(nnz, b);
+    auto const width = L::width(end - beg, start[b + 1] - start[b]);
+
+    spv_bit_writer gaps(packed + start[b]);
+    for (auto i = beg; i < end; i++) gaps.put(i > beg ? idx[i] - idx[i - 1] - 1 : 0, width);
+    gaps.flush();
+}
+
+// as spv_idx_width, for the values; also writes the shape of the residuals
+template <typename T>
+__global__ void spv_val_width(T const* val, int const nnz, uint8_t* out)
+{
+    using L    = spv_val_layout<T>;
+    using UInt = typename L::UInt;
+
+    auto b = blockIdx.x * blockDim.x + threadIdx.x;
+    if (b >= L::nblock(nnz)) return;
+
+    auto const beg = b * L::BLOCK, end = beg + spv_idx_layout::count(nnz, b);
+
+    UInt any = 0;
+    for (auto i = beg + 1; i < end; i++) any |= L::to_bits(val[i]) ^ L::to_bits(val[i - 1]);
+
+    auto tz    = any == 0 ? 0 : spv_trailing_zeros(any);
+    auto width = spv_bit_width(any >> tz);
+    auto shape = out + L::shape_offset(nnz) + 2 * b;
+
+    reinterpret_cast<T*>(out)[b] = val[beg];
+    shape[0]                     = tz;
+    shape[1]                     = width;
+
+    reinterpret_cast<uint32_t*>(out + L::start_offset(nnz))[b + 1] = spv_idx_layout::nword(end - beg - 1, width);
+}
+
+template <typename T>
+__global__ void spv_val_pack_block(T const* val, int const nnz, uint8_t* out)
+{
+    using L = spv_val_layout<T>;
+
+    auto b = blockIdx.x * blockDim.x + threadIdx.x;
+    if (b >= L::nblock(nnz)) return;
+
+    auto const beg = b * L::BLOCK, end = beg + spv_idx_layout::count(nnz, b);
+    auto const start = reinterpret_cast<uint32_t const*>(out + L::start_offset(nnz));
+    auto const shape = out + L::shape_offset(nnz) + 2 * b;
+
+    spv_bit_writer residuals(reinterpret_cast<uint32_t*>(out + L::packed_offset(nnz)) + start[b]);
+    for (auto i = beg + 1; i < end; i++)
+        residuals.put((L::to_bits(val[i]) ^ L::to_bits(val[i - 1])) >> shape[0], shape[1]);
+    residuals.flush();
+}
+
+template <typename T>
+__global__ void spv_scatter_packed_block(
+    uint8_t const*      coded_val,
+    spv_valcoding const coding,
+    uint32_t const*     packed_idx,
+    int const           nnz,
+    T*                  decoded)
+{
+    auto b = blockIdx.x * blockDim.x + threadIdx.x;
+    if (b >= spv_idx_layout::nblock(nnz)) return;
+
+    spv_idx_cursor    idx(packed_idx, nnz, b);
+    spv_val_cursor<T> val(coded_val, coding, nnz, b);
+    for (auto i = 0; i < idx.count; i++) decoded[idx.next()] = val.next();
+}
+
+// scan the per-block word counts in start[1..nblock] into offsets; returns start[nblock]
+inline uint32_t spv_scan_start(uint32_t* start, size_t const nblock, cudaStream_t stream)
+{
+    thrust::inclusive_scan(thrust::cuda::par.on(stream), start + 1, start + 1 + nblock, start + 1);
+
+    uint32_t total;
+    CHECK_CUDA(cudaMemcpyAsync(&total, start + nblock, sizeof(uint32_t), cudaMemcpyDeviceToHost, stream));
+    CHECK_CUDA(cudaStreamSynchronize(stream));
+    return total;
+}
+
+inline size_t
+spv_idx_pack(uint32_t const* d_idx, int const nnz, uint32_t* d_out, float* milliseconds, cudaStream_t stream)
+{
+    using L = spv_idx_layout;
+
+    auto const nblock = L::nblock(nnz);
+    auto const start  = d_out + L::start_offset(nnz);
+    auto const grid   = (nblock + 255) / 256;
+
+    CREATE_CUDAEVENT_PAIR;
+    START_CUDAEVENT_RECORDING(stream);
+
+    CHECK_CUDA(cudaMemsetAsync(start, 0, sizeof(uint32_t), stream));
+    uint32_t npacked = 0;
+    if (nblock != 0) {
+        spv_idx_width<<<grid, 256, 0, stream>>>(d_idx, nnz, d_out, start);
+        npacked = spv_scan_start(start, nblock, stream);
+        spv_idx_pack_block<<<grid, 256, 0, stream>>>(d_idx, nnz, start, d_out + L::packed_offset(nnz));
+    }
+
+    STOP_CUDAEVENT_RECORDING(stream);
+    TIME_ELAPSED_CUDAEVENT(milliseconds);
+    DESTROY_CUDAEVENT_PAIR;
+
+    return sizeof(uint32_t) * (L::packed_offset(nnz) + npacked);
+}
+
+template <typename T, typename M>
+size_t spv_val_xor(T const* d_val, int const nnz, uint8_t* d_out, float* milliseconds, cudaStream_t stream)
+{
+    using L = spv_val_layout<T>;
+
+    auto const nblock = L::nblock(nnz);
+    auto const start  = reinterpret_cast<uint32_t*>(d_out + L::start_offset(nnz));
+    auto const grid   = (nblock + 255) / 256;
+
+    CREATE_CUDAEVENT_PAIR;
+    START_CUDAEVENT_RECORDING(stream);
+
+    CHECK_CUDA(cudaMemsetAsync(start, 0, sizeof(uint32_t), stream));
+    uint32_t npacked = 0;
+    if (nblock != 0) {
+        spv_val_width<T><<<grid, 256, 0, stream>>>(d_val, nnz, d_out);
+        npacked = spv_scan_start(start, nblock, stream);
+        spv_val_pack_block<T><<<grid, 256, 0, stream>>>(d_val, nnz, d_out);
+    }
+
+    STOP_CUDAEVENT_RECORDING(stream);
+    TIME_ELAPSED_CUDAEVENT(milliseconds);
+    DESTROY_CUDAEVENT_PAIR;
+
+    return L::packed_offset(nnz) + sizeof(uint32_t) * npacked;
+}
+
+template <typename T, typename M>
+void spv_scatter_packed(
+    uint8_t const*      coded_val,
+    spv_valcoding const coding,
+    uint32_t const*     packed_idx,
+    int const           nnz,
+    T*                  decoded,
+    float*              milliseconds,
+    cudaStream_t        stream)
+{
+    auto const nblock = spv_idx_layout::nblock(nnz);
+
+    CREATE_CUDAEVENT_PAIR;
+    START_CUDAEVENT_RECORDING(stream);
+
+    if (nblock != 0)
+        spv_scatter_packed_block<T>
+            <<<(nblock + 255) / 256, 256, 0, stream>>>(coded_val, coding, packed_idx, nnz, decoded);
+
+    STOP_CUDAEVENT_RECORDING(stream);
+    TIME_ELAPSED_CUDAEVENT(milliseconds);
+    DESTROY_CUDAEVENT_PAIR;
+}
+
 }  // namespace detail
 }  // namespace accsz
 
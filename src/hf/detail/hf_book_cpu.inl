@@ -0,0 +1,284 @@
+/**
+ * @file hf_book_cpu.inl
+ * @author Jiannan Tian
+ * @brief Host canonical Huffman codebook: radix ordering + two-queue codeword lengths (length-limited) +
+ * GPU_GenerateCW (sequential).
+ * @version 0.3
+ * @date 2022-12-08
+ *
+ * (C) 2022 by Indiana University, Argonne National Laboratory
+ *
+ */
+
+#ifndef B7E2A4C9_61D3_4B8F_9E07_C35A1F8D2E64
+#define B7E2A4C9_61D3_4B8F_9E07_C35A1F8D2E64
+
+#include <omp.h>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+#include "hf/hf_book_cpu.hh"
+#include "hf_book_limit.inl"
+#include "utils/format.hh"
+#include "utils/timer.h"
+
+namespace asz {
+namespace detail {
+
+/**
+ * @brief codeword length from frequencies sorted in ascending order (all nonzero), two-queue method
+ *
+ * @param freq input; ascending
+ * @param n len of freq
+ * @param CL output; codeword length, nonincreasing
+ */
+inline void hf_generate_cl_cpu(uint32_t* freq, int const n, uint32_t* CL)
+{
+    if (n == 1) {  // edge case -- only one input symbol
+        CL[0] = 1;
+        return;
+    }
+
+    std::vector<uint64_t> ifreq(n - 1);
+    std::vector<int>      parent(2 * n - 1);
+
+    auto l = 0, ifront = 0, irear = 0;
+
+    // leaf is preferred on tie (as in the sorting network of GPU_GenerateCL)
+    auto pick = [&](uint64_t& f) {
+        if (l < n and (ifront == irear or freq[l] <= ifreq[ifront])) {
+            f = freq[l];
+            return l++;
+        }
+        f = ifreq[ifront];
+        return n + ifront++;
+    };
+
+    for (auto k = 0; k < n - 1; k++) {
+        uint64_t fa, fb;
+        auto     a = pick(fa);
+        auto     b = pick(fb);
+        parent[a] = parent[b] = n + irear;
+        ifreq[irear++]        = fa + fb;
+    }
+
+    // internal nodes are created in order; the last one is the root
+    std::vector<uint32_t> depth(n - 1, 0);
+    for (auto i = n - 3; i >= 0; i--) depth[i] = depth[parent[n + i] - n] + 1;
+    for (auto i = 0; i < n; i++) CL[i] = depth[parent[i] - n] + 1;
+
+    // lengths of equal-frequency symbols can be exchanged freely; keep them monotone for the canonical form
+    // (counting sort: lengths are bounded by the number of levels, at most n)
+    std::vector<uint32_t> count(n + 1, 0);
+    for (auto i = 0; i < n; i++) count[CL[i]]++;
+    auto k = 0;
+    for (auto len = n; len >= 1; len--)
+        for (uint32_t c = 0; c < count[len]; c++) CL[k++] = len;
+}
+
+/**
+ * @brief order qcodes by frequency (stable, ascending) without a comparison sort: zero-frequency qcodes first, then
+ * a parallel LSD radix sort (8-bit digits) over the nonzero ones, so the cost is linear in the dictionary size
+ *
+ * @param freq input; frequency
+ * @param n len of freq
+ * @param order output; qcodes in ascending frequency
+ * @return number of zero-frequency qcodes, i.e., the index of the first nonzero in `order`
+ */
+inline int hf_order_by_freq_cpu(uint32_t* freq, int const n, uint32_t* order)
+{
+    constexpr int RADIX = 256;
+
+    auto nthread = omp_get_max_threads();
+    auto blksz   = (n - 1) / nthread + 1;
+
+    // stable partition into zero and nonzero
+    std::vector<int> nzeros(nthread + 1, 0), nnz(nthread + 1, 0);
+    uint32_t         maxfreq = 0;
+
+#pragma omp parallel num_threads(nthread) reduction(max : maxfreq)
+    {
+        auto tid = omp_get_thread_num();
+        auto beg = std::min(n, tid * blksz), end = std::min(n, beg + blksz);
+
+        for (auto i = beg; i < end; i++) {
+            if (freq[i] == 0)
+                nzeros[tid + 1]++;
+            else
+                nnz[tid + 1]++;
+            maxfreq = std::max(maxfreq, freq[i]);
+        }
+#pragma omp barrier
+#pragma omp single
+        for (auto t = 0; t < nthread; t++) nzeros[t + 1] += nzeros[t], nnz[t + 1] += nnz[t];
+
+        auto zdst = nzeros[tid], nzdst = nzeros[nthread] + nnz[tid];
+        for (auto i = beg; i < end; i++) order[freq[i] == 0 ? zdst++ : nzdst++] = i;
+    }
+
+    auto const nz_start = nzeros[nthread];
+    auto const m        = n - nz_start;
+    if (m <= 1) return nz_start;
+
+    std::vector<uint32_t> buf(m);
+    uint32_t*             src = order + nz_start;
+    uint32_t*             dst = buf.data();
+
+    auto mblk = (m - 1) / nthread + 1;
+    // per-thread digit count, laid out [digit][thread] so that the exclusive scan keeps stability
+    std::vector<int> count(RADIX * nthread);
+
+    for (auto shift = 0; shift < 32 and (maxfreq >> shift) != 0; shift += 8) {
+        std::fill(count.begin(), count.end(), 0);
+
+#pragma omp parallel num_threads(nthread)
+        {
+            auto tid = omp_get_thread_num();
+            auto beg = std::min(m, tid * mblk), end = std::min(m, beg + mblk);
+
+            for (auto i = beg; i < end; i++) count[((freq[src[i]] >> shift) & 0xff) * nthread + tid]++;
+#pragma omp barrier
+#pragma omp single
+            {
+                auto sum = 0;
+                for (auto& c : count) {
+                    auto tmp = c;
+                    c        = sum;
+                    sum += tmp;
+                }
+            }
+            for (auto i = beg; i < end; i++) dst[count[((freq[src[i]] >> shift) & 0xff) * nthread + tid]++] = src[i];
+        }
+        std::swap(src, dst);
+    }
+
+    if (src != order + nz_start) std::copy(src, src + m, order + nz_start);
+
+    return nz_start;
+}
+
+/**
+ * @brief canonical codeword from codeword length (nonincreasing); sequential GPU_GenerateCW
+ */
+template <typename H>
+void hf_generate_cw_cpu(uint32_t* CL, H* CW, H* first, H* entry, int const size)
+{
+    int const type_bw = sizeof(H) * 8;
+
+    std::reverse(CL, CL + size);
+
+    int CCL     = CL[0];
+    int CDPI    = 0;
+    int newCDPI = size - 1;
+
+    entry[CCL] = 0;
+
+    // edge case -- only one input symbol
+    CW[CDPI]       = 0;
+    first[CCL]     = CW[CDPI] ^ (((H)1 << (H)CL[CDPI]) - 1);
+    entry[CCL + 1] = 1;
+
+    // initialization of first to max ensures that unused code lengths are skipped over in decoding
+    for (auto i = 0; i < CCL; i++) {
+        first[i] = std::numeric_limits<H>::max();
+        entry[i] = 0;
+    }
+
+    while (CDPI < size - 1) {
+        for (auto i = CDPI; i < size - 1; i++)
+            if ((int)CL[i + 1] > CCL) {
+                newCDPI = i;
+                break;
+            }
+
+        int const updateEnd   = (newCDPI >= size - 1) ? type_bw : CL[newCDPI + 1];
+        int const curEntryVal = entry[CCL];
+        int const numCCL      = (newCDPI - CDPI + 1);
+
+        CW[newCDPI] = CDPI == 0 ? 0 : CW[CDPI];  // pre-stored
+        for (auto i = CDPI; i < newCDPI; i++) CW[i] = CW[newCDPI] + (newCDPI - i);
+
+        for (auto i = CCL + 1; i < updateEnd; i++) entry[i] = curEntryVal + numCCL;
+        if (updateEnd < type_bw) entry[updateEnd] = curEntryVal + numCCL;
+
+        first[CCL] = CW[CDPI] ^ (((H)1 << (H)CL[CDPI]) - 1);
+        for (auto i = CCL + 1; i < updateEnd; i++) first[i] = std::numeric_limits<H>::max();
+
+        if (newCDPI < size - 1) {
+            int CLDiff      = CL[newCDPI + 1] - CL[newCDPI];
+            CW[newCDPI + 1] = ((CW[CDPI] + 1) << CLDiff);
+            CCL             = CL[newCDPI + 1];
+            ++newCDPI;
+        }
+
+        CDPI    = newCDPI;
+        newCDPI = size - 1;
+    }
+
+    // make encoded codeword compatible with CUSZ
+    for (auto i = 0; i < size; i++)
+        CW[i] = (CW[i] | (((H)CL[i] & (H)0xffu) << ((sizeof(H) * 8) - 8))) ^ (((H)1 << (H)CL[i]) - 1);
+
+    std::reverse(CL, CL + size);
+    std::reverse(CW, CW + size);
+}
+
+}  // namespace detail
+}  // namespace asz
+
+template <typename T, typename H>
+void asz::hf_buildbook_cpu(
+    uint32_t* freq,
+    int const dict_size,
+    H*        codebook,
+    uint8_t*  reverse_codebook,
+    int const revbook_nbyte,
+    float*    time_book)
+{
+    auto type_bw = sizeof(H) * 8;
+    auto _first  = reinterpret_cast<H*>(reverse_codebook);
+    auto _entry  = reinterpret_cast<H*>(reverse_codebook + (sizeof(H) * type_bw));
+    auto _qcode  = reinterpret_cast<T*>(reverse_codebook + (sizeof(H) * 2 * type_bw));
+
+    CREATE_CPU_TIMER;
+    START_CPU_TIMER;
+
+    memset(reverse_codebook, 0x0, revbook_nbyte);
+
+    // order qcodes by frequency (stable, ascending); freq is left untouched
+    std::vector<uint32_t> order(dict_size);
+
+    auto first_nonzero_index = asz::detail::hf_order_by_freq_cpu(freq, dict_size, order.data());
+    int  nz_dict_size        = dict_size - first_nonzero_index;
+
+    std::vector<uint32_t> sorted_freq(nz_dict_size), CL(nz_dict_size);
+    std::vector<H>        CW(nz_dict_size);
+    for (auto i = 0; i < nz_dict_size; i++) sorted_freq[i] = freq[order[first_nonzero_index + i]];
+
+    if (nz_dict_size > 0) {
+        asz::detail::hf_generate_cl_cpu(sorted_freq.data(), nz_dict_size, CL.data());
+
+        // the 8 MSBs of a codeword hold its length; deeper codes are shortened rather than failing the book
+        asz::detail::hf_limit_cl(CL.data(), nz_dict_size, sizeof(H) * 8 - 8);
+
+        asz::detail::hf_generate_cw_cpu<H>(CL.data(), CW.data(), _first, _entry, nz_dict_size);
+    }
+
+    // reverse: keys in descending frequency; then scatter codewords to their qcodes
+    memset(codebook, 0x0, sizeof(H) * dict_size);
+    for (auto i = 0; i < dict_size; i++) _qcode[i] = order[dict_size - 1 - i];
+    for (auto i = 0; i < nz_dict_size; i++) codebook[order[first_nonzero_index + i]] = CW[i];
+
+    STOP_CPU_TIMER;
+    TIME_ELAPSED_CPU_TIMER(time_book);
+    DESTROY_CPU_TIMER;
+}
+
+#endif /* B7E2A4C9_61D3_4B8F_9E07_C35A1F8D2E64 */
@@ -0,0 +1,68 @@
+/**
+ * @file hf_book_limit.inl
+ * @author Jiannan Tian
+ * @brief Cap Huffman codeword lengths so that every codeword fits the codebook type.
+ * @version 0.3
+ * @date 2022-12-22
+ *
+ * (C) 2022 by Indiana University, Argonne National Laboratory
+ *
+ */
+
+#ifndef D4A91C36_7E2B_4F85_B0D3_91F6C2E8A457
+#define D4A91C36_7E2B_4F85_B0D3_91F6C2E8A457
+
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+namespace asz {
+namespace detail {
+
+/**
+ * @brief Limit codeword lengths to `max_len` while keeping the code complete (Kraft sum of 1).
+ *
+ * The lengths are counted per level; while a level deeper than `max_len` is populated, two of its leaves are
+ * replaced by one leaf a level up (their sibling moves into their parent), and the shallower leaf freed this way is
+ * split into two. This is the adjustment of JPEG (ITU T.81, Annex K.3) and only lengthens the least frequent codes
+ * of the shallow levels, so the loss in compression is small. Lengths are then handed out again, longest first, in
+ * the order of `CL`.
+ *
+ * @param CL (host) in/out; codeword lengths, nonincreasing (i.e., for frequencies in ascending order)
+ * @param n len of CL
+ * @param max_len longest codeword allowed
+ * @return whether any length has been changed
+ */
+inline bool hf_limit_cl(uint32_t* CL, int const n, int const max_len)
+{
+    if (n == 0 or (int)CL[0] <= max_len) return false;
+    if (max_len < 32 and (uint64_t)n > (1ull << max_len))
+        throw std::runtime_error("Too many symbols for the codeword length limit.");
+
+    int const             deepest = CL[0];
+    std::vector<uint64_t> count(deepest + 1, 0);
+    for (auto i = 0; i < n; i++) count[CL[i]]++;
+
+    for (auto i = deepest; i > max_len; i--) {
+        while (count[i] > 0) {
+            auto j = i - 2;
+            while (count[j] == 0) j--;  // the deepest populated level above i - 1
+
+            count[i] -= 2;      // two leaves leave level i,
+            count[i - 1] += 1;  // one comes back as the parent of the pair
+            count[j + 1] += 2;  // and a leaf at level j becomes the parent of the other one and itself
+            count[j] -= 1;
+        }
+    }
+
+    auto k = 0;
+    for (auto len = max_len; len >= 1; len--)
+        for (uint64_t c = 0; c < count[len]; c++) CL[k++] = len;
+
+    return true;
+}
+
+}  // namespace detail
+}  // namespace asz
+
+#endif /* D4A91C36_7E2B_4F85_B0D3_91F6C2E8A457 */
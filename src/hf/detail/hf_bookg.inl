@@ -29,11 +29,14 @@
 #include <iostream>
 #include <limits>
 #include <type_traits>
+#include <vector>
 
 #include "common.hh"
 #include "hf/hf_bookg.hh"
+#include "hf_book_limit.inl"
 #include "par_merge.inl"
 #include "utils.hh"
+#include "utils/mempool.hh"
 #include "utils/timer.h"
 
 using std::cout;
@@ -522,13 +525,14 @@ __global__ void par_huffman::detail::GPU_ReverseArray(T* array, unsigned int siz
 // Parallel codebook generation wrapper
 template <typename T, typename H>
 void asz::hf_buildbook_g(
-    uint32_t*    freq,
-    int const    dict_size,
-    H*           codebook,
-    uint8_t*     reverse_codebook,
-    int const    revbook_nbyte,
-    float*       time_book,
-    cudaStream_t stream)
+    uint32_t*              freq,
+    int const              dict_size,
+    H*                     codebook,
+    uint8_t*               reverse_codebook,
+    int const              revbook_nbyte,
+    float*                 time_book,
+    cudaStream_t           stream,
+    cusz::memory_resource* mem)
 {
     // Metadata
     auto type_bw  = sizeof(H) * 8;
@@ -536,6 +540,13 @@ void asz::hf_buildbook_g(
     auto _d_entry = reinterpret_cast<H*>(reverse_codebook + (sizeof(H) * type_bw));
     auto _d_qcode = reinterpret_cast<T*>(reverse_codebook + (sizeof(H) * 2 * type_bw));
 
+    // the workspace is taken from the codec's memory resource, so that rebuilding a book does not reach cudaMalloc
+    if (not mem) mem = cusz::default_memory_resource();
+    auto dalloc = [&](auto** ptr, size_t nbyte) {
+        *ptr = reinterpret_cast<std::remove_pointer_t<decltype(ptr)>>(mem->allocate(nbyte, cusz::memkind::DEVICE));
+    };
+    auto dfree  = [&](void* ptr) { mem->deallocate(ptr, cusz::memkind::DEVICE); };
+
     CREATE_CUDAEVENT_PAIR;
     START_CUDAEVENT_RECORDING(stream);
 
@@ -564,13 +575,13 @@ void asz::hf_buildbook_g(
 
     unsigned int* d_first_nonzero_index;
     unsigned int  first_nonzero_index = dict_size;
-    cudaMalloc(&d_first_nonzero_index, sizeof(unsigned int));
+    dalloc(&d_first_nonzero_index, sizeof(unsigned int));
     cudaMemcpy(d_first_nonzero_index, &first_nonzero_index, sizeof(unsigned int), cudaMemcpyHostToDevice);
     par_huffman::detail::GPU_GetFirstNonzeroIndex<unsigned int>
         <<<nblocks, 1024>>>(freq, dict_size, d_first_nonzero_index);
     cudaStreamSynchronize(stream);
     cudaMemcpy(&first_nonzero_index, d_first_nonzero_index, sizeof(unsigned int), cudaMemcpyDeviceToHost);
-    cudaFree(d_first_nonzero_index);
+    dfree(d_first_nonzero_index);
 
     int           nz_dict_size   = dict_size - first_nonzero_index;
     unsigned int* _nz_d_freq     = freq + first_nonzero_index;
@@ -584,16 +595,16 @@ void asz::hf_buildbook_g(
     unsigned int *iNodesFreq = nullptr;  int *iNodesLeader = nullptr;
     unsigned int *tempFreq   = nullptr;  int *tempIsLeaf   = nullptr;  int *tempIndex = nullptr;
     unsigned int *copyFreq   = nullptr;  int *copyIsLeaf   = nullptr;  int *copyIndex = nullptr;
-    cudaMalloc(&CL,           nz_dict_size * sizeof(unsigned int) );
-    cudaMalloc(&lNodesLeader, nz_dict_size * sizeof(int)          );
-    cudaMalloc(&iNodesFreq,   nz_dict_size * sizeof(unsigned int) );
-    cudaMalloc(&iNodesLeader, nz_dict_size * sizeof(int)          );
-    cudaMalloc(&tempFreq,     nz_dict_size * sizeof(unsigned int) );
-    cudaMalloc(&tempIsLeaf,   nz_dict_size * sizeof(int)          );
-    cudaMalloc(&tempIndex,    nz_dict_size * sizeof(int)          );
-    cudaMalloc(&copyFreq,     nz_dict_size * sizeof(unsigned int) );
-    cudaMalloc(&copyIsLeaf,   nz_dict_size * sizeof(int)          );
-    cudaMalloc(&copyIndex,    nz_dict_size * sizeof(int)          );
+    dalloc(&CL,           nz_dict_size * sizeof(unsigned int) );
+    dalloc(&lNodesLeader, nz_dict_size * sizeof(int)          );
+    dalloc(&iNodesFreq,   nz_dict_size * sizeof(unsigned int) );
+    dalloc(&iNodesLeader, nz_dict_size * sizeof(int)          );
+    dalloc(&tempFreq,     nz_dict_size * sizeof(unsigned int) );
+    dalloc(&tempIsLeaf,   nz_dict_size * sizeof(int)          );
+    dalloc(&tempIndex,    nz_dict_size * sizeof(int)          );
+    dalloc(&copyFreq,     nz_dict_size * sizeof(unsigned int) );
+    dalloc(&copyIsLeaf,   nz_dict_size * sizeof(int)          );
+    dalloc(&copyIndex,    nz_dict_size * sizeof(int)          );
     cudaMemset(CL, 0,         nz_dict_size * sizeof(int)          );
     // clang-format on
 
@@ -626,7 +637,14 @@ void asz::hf_buildbook_g(
     }
 
     uint32_t* diagonal_path_intersections;
-    cudaMalloc(&diagonal_path_intersections, (2 * (mblocks + 1)) * sizeof(uint32_t));
+    dalloc(&diagonal_path_intersections, (2 * (mblocks + 1)) * sizeof(uint32_t));
+
+    auto free_workspace = [&]() {
+        for (void* ptr : {(void*)CL, (void*)lNodesLeader, (void*)iNodesFreq, (void*)iNodesLeader, (void*)tempFreq,
+                          (void*)tempIsLeaf, (void*)tempIndex, (void*)copyFreq, (void*)copyIsLeaf, (void*)copyIndex,
+                          (void*)diagonal_path_intersections})
+            dfree(ptr);
+    };
 
     // Codebook already init'ed
     cudaStreamSynchronize(stream);
@@ -653,21 +671,20 @@ void asz::hf_buildbook_g(
 
     unsigned int* d_max_CL;
     unsigned int  max_CL;
-    cudaMalloc(&d_max_CL, sizeof(unsigned int));
+    dalloc(&d_max_CL, sizeof(unsigned int));
     par_huffman::detail::GPU_GetMaxCWLength<<<1, 1>>>(CL, nz_dict_size, d_max_CL);
     cudaStreamSynchronize(stream);
     cudaMemcpy(&max_CL, d_max_CL, sizeof(unsigned int), cudaMemcpyDeviceToHost);
-    cudaFree(d_max_CL);
+    dfree(d_max_CL);
 
+    // The 8 MSBs of a codeword hold its length. Rare deep trees are shortened on host, which is cheaper than
+    // rebuilding and re-encoding with the 8-byte codec.
     int max_CW_bits = (sizeof(H) * 8) - 8;
     if (max_CL > max_CW_bits) {
-        cout << LOG_ERR << "Cannot store all Huffman codewords in " << max_CW_bits + 8 << "-bit representation" << endl;
-        cout << LOG_ERR << "Huffman codeword representation requires at least " << max_CL + 8
-             << " bits (longest codeword: " << max_CL << " bits)" << endl;
-        // cout << LOG_ERR << "(Consider running with -H 8 for 8-byte representation)" << endl << endl;
-        // cout << LOG_ERR << "Exiting cuSZ ..." << endl;
-        // exit(1);
-        throw std::runtime_error("Falling back to 8-byte Codec.");
+        std::vector<uint32_t> h_CL(nz_dict_size);
+        cudaMemcpy(h_CL.data(), CL, nz_dict_size * sizeof(unsigned int), cudaMemcpyDeviceToHost);
+        asz::detail::hf_limit_cl(h_CL.data(), nz_dict_size, max_CW_bits);
+        cudaMemcpy(CL, h_CL.data(), nz_dict_size * sizeof(unsigned int), cudaMemcpyHostToDevice);
     }
 
     // Configure CW for 1024 threads/block
@@ -720,17 +737,7 @@ void asz::hf_buildbook_g(
     DESTROY_CUDAEVENT_PAIR;
 
     // Cleanup
-    cudaFree(CL);
-    cudaFree(lNodesLeader);
-    cudaFree(iNodesFreq);
-    cudaFree(iNodesLeader);
-    cudaFree(tempFreq);
-    cudaFree(tempIsLeaf);
-    cudaFree(tempIndex);
-    cudaFree(copyFreq);
-    cudaFree(copyIsLeaf);
-    cudaFree(copyIndex);
-    cudaFree(diagonal_path_intersections);
+    free_workspace();
     cudaStreamSynchronize(stream);
 
 #ifdef D_DEBUG_PRINT
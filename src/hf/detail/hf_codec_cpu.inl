@@ -0,0 +1,368 @@
+/**
+ * @file hf_codec_cpu.inl
+ * @author Jiannan Tian
+ * @brief Host (OpenMP) chunked Huffman encoding and decoding; see hf_codecg.inl for the CUDA version.
+ * @version 0.3
+ * @date 2022-12-08
+ *
+ * (C) 2022 by Indiana University, Argonne National Laboratory
+ *
+ */
+
+#ifndef D94C2E7A_5B13_4F86_B2D8_A07E3C1F5D92
+#define D94C2E7A_5B13_4F86_B2D8_A07E3C1F5D92
+
+#include <omp.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <vector>
+
+#include "hf/hf_codec_cpu.hh"
+#include "hf/hf_struct.h"
+#include "utils/timer.h"
+
+namespace asz {
+namespace detail {
+
+/**
+ * @brief MSB-first bit writer into `COMPRESSED` cells, staging through a 64-bit accumulator. The layout is that of
+ * the in-place deflate on device: codewords are packed from the most significant bit of a cell and the last cell is
+ * padded with zeros.
+ */
+template <typename COMPRESSED>
+struct hf_bitwriter64_cpu {
+    static const int CELL_BITWIDTH = sizeof(COMPRESSED) * 8;
+
+    COMPRESSED* out;
+    uint64_t    acc{0};  // the lowest `nacc` bits are pending; anything above is stale
+    int         nacc{0};
+
+    explicit hf_bitwriter64_cpu(COMPRESSED* out) : out(out) {}
+
+    // `width` is at most CELL_BITWIDTH - 8, the room a packed codeword has
+    inline void put(uint64_t word, int const width)
+    {
+        if (CELL_BITWIDTH == 32) {
+            // nacc < 32 and width <= 24: never more than one cell to flush
+            acc = (acc << width) | word;
+            nacc += width;
+            if (nacc >= 32) {
+                nacc -= 32;
+                *(out++) = (COMPRESSED)(acc >> nacc);
+            }
+        }
+        else if (nacc + width < 64) {
+            acc = (acc << width) | word;
+            nacc += width;
+        }
+        else {  // the word straddles two 64-bit cells; nacc > 0 as width <= 56
+            auto spill = nacc + width - 64;
+            *(out++)   = (COMPRESSED)((acc << (64 - nacc)) | (word >> spill));
+            acc        = word;
+            nacc       = spill;
+        }
+    }
+
+    inline void flush()
+    {
+        if (nacc != 0) *(out++) = (COMPRESSED)(acc << (CELL_BITWIDTH - nacc));
+        nacc = 0;
+    }
+};
+
+/**
+ * @brief Size each chunk from the codeword widths in the book, without encoding.
+ */
+template <typename UNCOMPRESSED, typename ENCODED, typename MetadataT>
+void hf_encode_chunk_nbit_cpu(
+    UNCOMPRESSED* in_uncompressed,
+    size_t const  len,
+    ENCODED*      in_book,
+    MetadataT*    par_nbit,
+    MetadataT*    par_ncell,
+    int const     sublen,
+    int const     pardeg)
+{
+    constexpr int CELL_BITWIDTH = sizeof(ENCODED) * 8;
+
+#pragma omp parallel for schedule(static)
+    for (auto tid = 0; tid < pardeg; tid++) {
+        auto   start      = std::min((size_t)tid * sublen, len);
+        auto   end        = std::min(start + sublen, len);
+        size_t total_bits = 0;
+
+        for (auto did = start; did < end; did++) total_bits += in_book[(int)in_uncompressed[did]] >> (CELL_BITWIDTH - 8);
+
+        par_nbit[tid]  = total_bits;
+        par_ncell[tid] = (total_bits + CELL_BITWIDTH - 1) / CELL_BITWIDTH;
+    }
+}
+
+/**
+ * @brief Parallel exclusive scan: each thread sums a contiguous block, the block sums are scanned, and each thread
+ * then scans its block from its offset.
+ */
+template <typename MetadataT>
+void hf_encode_exclusive_scan_cpu(MetadataT* in, MetadataT* out, int const n)
+{
+    std::vector<MetadataT> block_sum(omp_get_max_threads() + 1, 0);
+
+#pragma omp parallel
+    {
+        auto const nthread = omp_get_num_threads();
+        auto const tid     = omp_get_thread_num();
+        auto const start   = (int)((int64_t)n * tid / nthread);
+        auto const end     = (int)((int64_t)n * (tid + 1) / nthread);
+
+        MetadataT sum = 0;
+        for (auto i = start; i < end; i++) sum += in[i];
+        block_sum[tid + 1] = sum;
+
+#pragma omp barrier
+#pragma omp single
+        for (auto t = 1; t <= nthread; t++) block_sum[t] += block_sum[t - 1];
+
+        auto run = block_sum[tid];
+        for (auto i = start; i < end; i++) {
+            out[i] = run;
+            run += in[i];
+        }
+    }
+}
+
+/**
+ * @brief Look up and pack each chunk straight to its place in the bitstream, fusing fill, deflate and
+ * concatenation; chunks end on a cell boundary, so no two threads write to the same cell.
+ */
+template <typename UNCOMPRESSED, typename ENCODED, typename MetadataT>
+void hf_encode_chunk_deflate_cpu(
+    UNCOMPRESSED* in_uncompressed,
+    size_t const  len,
+    ENCODED*      in_book,
+    MetadataT*    par_entry,
+    int const     sublen,
+    int const     pardeg,
+    ENCODED*      out_bitstream)
+{
+    constexpr int     CELL_BITWIDTH = sizeof(ENCODED) * 8;
+    constexpr ENCODED WORD_MASK     = ((ENCODED)1 << (CELL_BITWIDTH - 8)) - 1;
+
+#pragma omp parallel for schedule(static)
+    for (auto tid = 0; tid < pardeg; tid++) {
+        auto start = std::min((size_t)tid * sublen, len);
+        auto end   = std::min(start + sublen, len);
+
+        hf_bitwriter64_cpu<ENCODED> writer(out_bitstream + par_entry[tid]);
+        for (auto did = start; did < end; did++) {
+            // bitwidth in the upper 8 bits, as in PackedWordByWidth
+            ENCODED packed_word = in_book[(int)in_uncompressed[did]];
+            writer.put(packed_word & WORD_MASK, packed_word >> (CELL_BITWIDTH - 8));
+        }
+        writer.flush();
+    }
+}
+
+// number of leading bits resolved by one table lookup
+constexpr int HF_CPU_LUT_BITS = 10;
+
+/**
+ * @brief Expand the canonical (first, entry, keys) tables into a direct lookup of `HF_CPU_LUT_BITS`-bit prefixes.
+ * `lut_len[p] == 0` marks a prefix whose codeword is longer than the table; it is resolved by the slow path.
+ */
+template <typename COMPRESSED, typename UNCOMPRESSED>
+void hf_decode_build_lut_cpu(uint8_t* revbook, UNCOMPRESSED* lut_sym, uint8_t* lut_len)
+{
+    static const auto DTYPE_WIDTH = sizeof(COMPRESSED) * 8;
+
+    auto first = reinterpret_cast<COMPRESSED*>(revbook);
+    auto entry = first + DTYPE_WIDTH;
+    auto keys  = reinterpret_cast<UNCOMPRESSED*>(revbook + sizeof(COMPRESSED) * (2 * DTYPE_WIDTH));
+
+    for (auto p = 0; p < (1 << HF_CPU_LUT_BITS); p++) {
+        lut_len[p] = 0;
+        for (auto l = 1; l <= HF_CPU_LUT_BITS; l++) {
+            COMPRESSED v = p >> (HF_CPU_LUT_BITS - l);
+            if (v >= first[l]) {
+                lut_sym[p] = keys[entry[l] + v - first[l]];
+                lut_len[p] = l;
+                break;
+            }
+        }
+    }
+}
+
+// left-aligned window of 64 bits starting at bit `pos`; cells past the chunk read as zero
+template <typename COMPRESSED>
+inline uint64_t hf_decode_peek64_cpu(COMPRESSED* input, size_t const ncell, size_t const pos)
+{
+    static const auto DTYPE_WIDTH = sizeof(COMPRESSED) * 8;
+
+    auto idx = pos / DTYPE_WIDTH;
+    auto off = pos % DTYPE_WIDTH;
+    auto at  = [&](size_t i) -> uint64_t { return i < ncell ? (uint64_t)input[i] : 0; };
+
+    if (DTYPE_WIDTH == 32) {
+        auto w = (at(idx) << 32) | at(idx + 1);
+        return off == 0 ? w : (w << off) | (at(idx + 2) >> (32 - off));
+    }
+    else {
+        return off == 0 ? at(idx) : (at(idx) << off) | (at(idx + 1) >> (64 - off));
+    }
+}
+
+template <typename COMPRESSED, typename UNCOMPRESSED>
+void hf_decode_single_thread_inflate_lut_cpu(
+    COMPRESSED*   input,
+    UNCOMPRESSED* out,
+    int const     total_bw,
+    uint8_t*      revbook,
+    UNCOMPRESSED* lut_sym,
+    uint8_t*      lut_len)
+{
+    static const auto DTYPE_WIDTH = sizeof(COMPRESSED) * 8;
+
+    auto first = reinterpret_cast<COMPRESSED*>(revbook);
+    auto entry = first + DTYPE_WIDTH;
+    auto keys  = reinterpret_cast<UNCOMPRESSED*>(revbook + sizeof(COMPRESSED) * (2 * DTYPE_WIDTH));
+
+    auto const ncell   = ((size_t)total_bw + DTYPE_WIDTH - 1) / DTYPE_WIDTH;
+    size_t     i       = 0;
+    size_t     idx_out = 0;
+
+    while (i < (size_t)total_bw) {
+        auto window = hf_decode_peek64_cpu(input, ncell, i);
+        auto prefix = window >> (64 - HF_CPU_LUT_BITS);
+
+        if (lut_len[prefix] != 0) {  // fast path: the codeword fits in the table
+            out[idx_out++] = lut_sym[prefix];
+            i += lut_len[prefix];
+            continue;
+        }
+
+        // slow path: continue the canonical walk past the table width
+        COMPRESSED v = prefix;
+        int        l = HF_CPU_LUT_BITS;
+        do {
+            v = (v << 1) | ((window >> (63 - l)) & 0x1);
+            ++l;
+        } while (v < first[l]);
+        out[idx_out++] = keys[entry[l] + v - first[l]];
+        i += l;
+    }
+}
+
+}  // namespace detail
+}  // namespace asz
+
+template <typename T, typename H, typename M>
+void asz::hf_encode_coarse_cpu(
+    T*            uncompressed,
+    size_t const  len,
+    hf_book*      book_desc,
+    hf_bitstream* bitstream_desc,
+    uint8_t*&,
+    size_t&,
+    float&        time_lossless)
+{
+    H*        h_bitstream = (H*)bitstream_desc->bitstream;
+    H*        h_book      = (H*)book_desc->book;
+    int const sublen      = bitstream_desc->sublen;
+    int const pardeg      = bitstream_desc->pardeg;
+
+    auto h_par_nbit  = (M*)bitstream_desc->h_metadata->bits;
+    auto h_par_ncell = (M*)bitstream_desc->h_metadata->cells;
+    auto h_par_entry = (M*)bitstream_desc->h_metadata->entries;
+
+    CREATE_CPU_TIMER;
+    START_CPU_TIMER;
+
+    // the gapped buffer is not needed on host: chunks are sized first, then encoded where they end up
+    asz::detail::hf_encode_chunk_nbit_cpu<T, H, M>(uncompressed, len, h_book, h_par_nbit, h_par_ncell, sublen, pardeg);
+    asz::detail::hf_encode_exclusive_scan_cpu<M>(h_par_ncell, h_par_entry, pardeg);
+    asz::detail::hf_encode_chunk_deflate_cpu<T, H, M>(
+        uncompressed, len, h_book, h_par_entry, sublen, pardeg, h_bitstream);
+
+    STOP_CPU_TIMER;
+    float stage_time;
+    TIME_ELAPSED_CPU_TIMER(&stage_time);
+    time_lossless += stage_time;
+    DESTROY_CPU_TIMER;
+}
+
+template <typename T, typename H, typename M>
+void asz::hf_decode_coarse_cpu(
+    H*        bitstream,
+    uint8_t*  revbook,
+    int const,
+    M*        par_nbit,
+    M*        par_entry,
+    int const sublen,
+    int const pardeg,
+    T*        out_decompressed,
+    float&    time_lossless)
+{
+    CREATE_CPU_TIMER;
+    START_CPU_TIMER;
+
+    // built once per call and shared read-only by all threads
+    std::vector<T>       lut_sym(1 << asz::detail::HF_CPU_LUT_BITS);
+    std::vector<uint8_t> lut_len(1 << asz::detail::HF_CPU_LUT_BITS);
+    asz::detail::hf_decode_build_lut_cpu<H, T>(revbook, lut_sym.data(), lut_len.data());
+
+#pragma omp parallel for schedule(dynamic)
+    for (auto i = 0; i < pardeg; i++)
+        asz::detail::hf_decode_single_thread_inflate_lut_cpu(
+            bitstream + par_entry[i], out_decompressed + (size_t)sublen * i, par_nbit[i], revbook, lut_sym.data(),
+            lut_len.data());
+
+    STOP_CPU_TIMER;
+    TIME_ELAPSED_CPU_TIMER(&time_lossless);
+    DESTROY_CPU_TIMER;
+}
+
+template <typename T, typename H, typename M>
+void asz::hf_decode_chunkwise_cpu(
+    H*                                             bitstream,
+    uint8_t*                                       revbook,
+    int const,
+    M*                                             par_nbit,
+    M*                                             par_entry,
+    int const                                      sublen,
+    int const                                      pardeg,
+    size_t const                                   len,
+    std::function<void(size_t, size_t, T*)> const& consume,
+    float&                                         time_elapsed,
+    uint8_t const*                                 chunk_mask)
+{
+    CREATE_CPU_TIMER;
+    START_CPU_TIMER;
+
+    std::vector<T>       lut_sym(1 << asz::detail::HF_CPU_LUT_BITS);
+    std::vector<uint8_t> lut_len(1 << asz::detail::HF_CPU_LUT_BITS);
+    asz::detail::hf_decode_build_lut_cpu<H, T>(revbook, lut_sym.data(), lut_len.data());
+
+#pragma omp parallel
+    {
+        std::vector<T> quant(sublen);
+
+#pragma omp for schedule(dynamic)
+        for (auto i = 0; i < pardeg; i++) {
+            auto begin = std::min((size_t)sublen * i, len);
+            auto end   = std::min(begin + sublen, len);
+            if (begin == end or (chunk_mask and not chunk_mask[i])) continue;
+
+            asz::detail::hf_decode_single_thread_inflate_lut_cpu(
+                bitstream + par_entry[i], quant.data(), par_nbit[i], revbook, lut_sym.data(), lut_len.data());
+            consume(begin, end, quant.data());
+        }
+    }
+
+    STOP_CPU_TIMER;
+    TIME_ELAPSED_CPU_TIMER(&time_elapsed);
+    DESTROY_CPU_TIMER;
+}
+
+#endif /* D94C2E7A_5B13_4F86_B2D8_A07E3C1F5D92 */
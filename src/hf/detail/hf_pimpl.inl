@@ -15,13 +15,17 @@
 #ifndef CUSZ_COMPONENT_HUFFMAN_COARSE_CUH
 #define CUSZ_COMPONENT_HUFFMAN_COARSE_CUH
 
+#ifndef CUSZ_HOST_ONLY
 #include <cuda.h>
+#endif
 // #include <clocale>
 // #include <cstdint>
 // #include <exception>
 // #include <functional>
+#include <algorithm>
 #include <iostream>
 #include <numeric>
+#include <vector>
 // #include <type_traits>
 
 using std::cout;
@@ -29,10 +33,16 @@ using std::cout;
 #include "common/definition.hh"
 #include "common/type_traits.hh"
 #include "utils.hh"
+#include "utils/timer.h"
 
 #include "hf/hf.hh"
+#include "hf/hf_book_cpu.hh"
+#include "hf/hf_codec_cpu.hh"
+
+#ifndef CUSZ_HOST_ONLY
 #include "hf/hf_bookg.hh"
 #include "hf/hf_codecg.hh"
+#endif
 
 /******************************************************************************
                             macros for shorthand writing
@@ -48,28 +58,42 @@ using std::cout;
         CHECK_CUDA(cudaMemcpyAsync(dst, src, nbyte[Header::FIELD], D2D, stream)); \
     }
 
+#define HOST2HOST_COPY(VAR, FIELD)                             \
+    {                                                          \
+        auto dst = h_compressed + header.entry[Header::FIELD]; \
+        auto src = reinterpret_cast<BYTE*>(h_##VAR);           \
+        memcpy(dst, src, nbyte[Header::FIELD]);                \
+    }
+
 #define ACCESSOR(SYM, TYPE) reinterpret_cast<TYPE*>(in_compressed + header.entry[Header::SYM])
 
-#define HC_ALLOCHOST(VAR, SYM)                     \
-    cudaMallocHost(&h_##VAR, rte.nbyte[RTE::SYM]); \
+// buffers are taken from (and returned to) the memory resource of the codec
+#define HC_ALLOC(VAR, NBYTE, KIND) \
+    VAR = reinterpret_cast<decltype(VAR)>(mem->allocate(NBYTE, memkind::KIND));
+
+#define HC_ALLOCHOST(VAR, SYM)                           \
+    HC_ALLOC(h_##VAR, rte.nbyte[RTE::SYM], HOST_PINNED); \
     memset(h_##VAR, 0x0, rte.nbyte[RTE::SYM]);
 
-#define HC_ALLOCDEV(VAR, SYM)                  \
-    cudaMalloc(&d_##VAR, rte.nbyte[RTE::SYM]); \
+#define HC_ALLOCDEV(VAR, SYM)                       \
+    HC_ALLOC(d_##VAR, rte.nbyte[RTE::SYM], DEVICE); \
     cudaMemset(d_##VAR, 0x0, rte.nbyte[RTE::SYM]);
 
-#define HC_FREEHOST(VAR)       \
-    if (h_##VAR) {             \
-        cudaFreeHost(h_##VAR); \
-        h_##VAR = nullptr;     \
-    }
+// host policy: pageable memory, as no device (hence no pinned memory) is assumed
+#define HC_ALLOCHOST_PAGEABLE(VAR, NBYTE)    \
+    HC_ALLOC(h_##VAR, NBYTE, HOST_PAGEABLE); \
+    memset(h_##VAR, 0x0, NBYTE);
 
-#define HC_FREEDEV(VAR)    \
-    if (d_##VAR) {         \
-        cudaFree(d_##VAR); \
-        d_##VAR = nullptr; \
+#define HC_FREE(VAR, KIND)                   \
+    if (VAR) {                               \
+        mem->deallocate(VAR, memkind::KIND); \
+        VAR = nullptr;                       \
     }
 
+#define HC_FREEHOST_PAGEABLE(VAR) HC_FREE(h_##VAR, HOST_PAGEABLE)
+#define HC_FREEHOST(VAR) HC_FREE(h_##VAR, HOST_PINNED)
+#define HC_FREEDEV(VAR) HC_FREE(d_##VAR, DEVICE)
+
 /******************************************************************************
                                 class definition
  ******************************************************************************/
@@ -82,31 +106,59 @@ namespace cusz {
 TEMPLATE_TYPE
 IMPL::~impl()
 {
+    delete book_desc;
+    delete bitstream_desc;
+    if (chunk_desc_h != chunk_desc_d) delete chunk_desc_h;
+    delete chunk_desc_d;
+
+    if (policy == CPU) {
+        HC_FREEHOST_PAGEABLE(tmp);
+        HC_FREEHOST_PAGEABLE(book);  // revbook is in the same allocation
+        HC_FREEHOST_PAGEABLE(par_metadata);
+        HC_FREEHOST_PAGEABLE(bitstream);
+        return;
+    }
+
+    // revbook is in the same allocation as book, and so are the chunk metadata arrays
     HC_FREEDEV(tmp);
     HC_FREEDEV(book);
-    HC_FREEDEV(revbook);
-    HC_FREEDEV(par_nbit);
-    HC_FREEDEV(par_ncell);
-    HC_FREEDEV(par_entry);
+    HC_FREEDEV(par_metadata);
     HC_FREEDEV(bitstream);
 
     HC_FREEHOST(book);
     HC_FREEHOST(revbook);
-    HC_FREEHOST(par_nbit);
-    HC_FREEHOST(par_ncell);
-    HC_FREEHOST(par_entry);
+    HC_FREEHOST(par_metadata);
 }
 
 TEMPLATE_TYPE
 IMPL::impl() = default;
 
+TEMPLATE_TYPE
+void IMPL::set_memory_resource(memory_resource* _mem) { mem = _mem ? _mem : default_memory_resource(); }
+
+TEMPLATE_TYPE
+void IMPL::set_chunk_alignment(size_t const align) { chunk_align = std::max<size_t>(align, 1); }
+
+TEMPLATE_TYPE
+void IMPL::set_approximate_bookcache(bool const approximate) { bookcache.set_approximate(approximate); }
+
 //------------------------------------------------------------------------------
 
 TEMPLATE_TYPE
-void IMPL::init(size_t const in_uncompressed_len, int const booklen, int const pardeg, bool dbg_print)
+void IMPL::init(
+    size_t const          in_uncompressed_len,
+    int const             booklen,
+    int const             _pardeg,
+    bool                  dbg_print,
+    cusz_execution_policy policy)
 {
+    // rounding sublen up to the chunk alignment takes fewer chunks to cover the input
+    int const sublen = ((in_uncompressed_len - 1) / _pardeg + chunk_align) / chunk_align * chunk_align;
+    int const pardeg = chunk_align == 1 ? _pardeg : (in_uncompressed_len - 1) / sublen + 1;
+
     auto max_compressed_bytes = [&]() { return in_uncompressed_len / 2 * sizeof(H); };
 
+#ifndef CUSZ_HOST_ONLY
     auto debug = [&]() {
         setlocale(LC_NUMERIC, "");
         printf("\nHuffmanCoarse<T, H, M>::init() debugging:\n");
@@ -119,6 +171,7 @@ void IMPL::init(size_t const in_uncompressed_len, int const booklen, int const p
         dbg_println("BITSTREAM", d_bitstream, RTE::BITSTREAM);
         printf("\n");
     };
+#endif
 
     memset(rte.nbyte, 0, sizeof(uint32_t) * RTE::END);
     // memset(rte.entry, 0, sizeof(uint32_t) * (RTE::END + 1));
@@ -131,18 +184,48 @@ void IMPL::init(size_t const in_uncompressed_len, int const booklen, int const p
     rte.nbyte[RTE::PAR_ENTRY] = sizeof(M) * pardeg;
     rte.nbyte[RTE::BITSTREAM] = max_compressed_bytes();
 
+    this->policy = policy;
+
+    if (policy == CPU) {
+        HC_ALLOCHOST_PAGEABLE(tmp, rte.nbyte[RTE::TMP]);
+
+        HC_ALLOCHOST_PAGEABLE(book, rte.nbyte[RTE::BOOK] + rte.nbyte[RTE::REVBOOK]);
+        h_revbook = reinterpret_cast<uint8_t*>(h_book + booklen);
+
+        HC_ALLOCHOST_PAGEABLE(par_metadata, rte.nbyte[RTE::PAR_NBIT] * 3);
+        h_par_nbit  = h_par_metadata;
+        h_par_ncell = h_par_metadata + pardeg;
+        h_par_entry = h_par_metadata + pardeg * 2;
+
+        HC_ALLOCHOST_PAGEABLE(bitstream, rte.nbyte[RTE::BITSTREAM]);
+
+        h_compressed = reinterpret_cast<BYTE*>(h_tmp);
+
+        // the same chunk metadata is seen as both "device" and host
+        book_desc      = new hf_book{nullptr, h_book, booklen};
+        chunk_desc_d   = new hf_chunk{h_par_nbit, h_par_ncell, h_par_entry};
+        chunk_desc_h   = chunk_desc_d;
+        bitstream_desc = new hf_bitstream{h_tmp, h_bitstream, chunk_desc_d, chunk_desc_h, sublen, pardeg, 0};
+
+        return;
+    }
+
+#ifdef CUSZ_HOST_ONLY
+    (void)dbg_print;  // it prints device buffers only
+    throw std::runtime_error("LosslessCodec: built without CUDA; use the host policy.");
+#else
     HC_ALLOCDEV(tmp, TMP);
 
     {
         auto total_bytes = rte.nbyte[RTE::BOOK] + rte.nbyte[RTE::REVBOOK];
-        cudaMalloc(&d_book, total_bytes);
+        HC_ALLOC(d_book, total_bytes, DEVICE);
         cudaMemset(d_book, 0x0, total_bytes);
 
         d_revbook = reinterpret_cast<uint8_t*>(d_book + booklen);
     }
 
     {
-        cudaMalloc(&d_par_metadata, rte.nbyte[RTE::PAR_NBIT] * 3);
+        HC_ALLOC(d_par_metadata, rte.nbyte[RTE::PAR_NBIT] * 3, DEVICE);
         cudaMemset(d_par_metadata, 0x0, rte.nbyte[RTE::PAR_NBIT] * 3);
 
         d_par_nbit  = d_par_metadata;
@@ -159,7 +242,7 @@ void IMPL::init(size_t const in_uncompressed_len, int const booklen, int const p
     HC_ALLOCHOST(revbook, REVBOOK);
 
     {
-        cudaMallocHost(&h_par_metadata, rte.nbyte[RTE::PAR_NBIT] * 3);
+        HC_ALLOC(h_par_metadata, rte.nbyte[RTE::PAR_NBIT] * 3, HOST_PINNED);
         // cudaMemset(h_par_nbit, 0x0, rte.nbyte[RTE::PAR_NBIT] * 3);
 
         h_par_nbit  = h_par_metadata;
@@ -170,21 +253,49 @@ void IMPL::init(size_t const in_uncompressed_len, int const booklen, int const p
     int numSMs;
     cudaDeviceGetAttribute(&numSMs, cudaDevAttrMultiProcessorCount, 0);
 
-    int sublen = (in_uncompressed_len - 1) / pardeg + 1;
-
     book_desc      = new hf_book{nullptr, d_book, booklen};
     chunk_desc_d   = new hf_chunk{d_par_nbit, d_par_ncell, d_par_entry};
     chunk_desc_h   = new hf_chunk{h_par_nbit, h_par_ncell, h_par_entry};
     bitstream_desc = new hf_bitstream{d_tmp, d_bitstream, chunk_desc_d, chunk_desc_h, sublen, pardeg, numSMs};
 
     if (dbg_print) debug();
+#endif
 }
 
 TEMPLATE_TYPE
 void IMPL::build_codebook(cusz::FREQ* freq, int const booklen, cudaStream_t stream)
 {
     book_desc->freq = freq;
-    asz::hf_buildbook_g<T, H>(freq, booklen, d_book, d_revbook, get_revbook_nbyte(booklen), &time_book, stream);
+
+    auto const book_nbyte    = sizeof(H) * booklen;
+    auto const revbook_nbyte = get_revbook_nbyte(booklen);
+
+    if (policy == CPU) {
+        // the histogram is already on host; the device path builds on the stream instead of waiting on a copy
+        asz::hf_bookcache::fingerprint_t fp;
+        uint64_t                         hash;
+        float                            time_lookup;
+
+        CREATE_CPU_TIMER;
+        START_CPU_TIMER;
+        bookcache.fingerprint(freq, booklen, fp, hash);
+        auto hit = bookcache.lookup(freq, fp, hash, (BYTE*)h_book, book_nbyte, h_revbook, revbook_nbyte);
+        STOP_CPU_TIMER;
+        TIME_ELAPSED_CPU_TIMER(&time_lookup);
+        DESTROY_CPU_TIMER;
+
+        if (hit) {
+            time_book = time_lookup;
+            return;
+        }
+        asz::hf_buildbook_cpu<T, H>(freq, booklen, h_book, h_revbook, revbook_nbyte, &time_book);
+        bookcache.insert(fp, hash, (BYTE*)h_book, book_nbyte, h_revbook, revbook_nbyte);
+    }
+#ifndef CUSZ_HOST_ONLY
+    else {
+        asz::hf_buildbook_g<T, H>(freq, booklen, d_book, d_revbook, revbook_nbyte, &time_book, stream, mem);
+    }
+#endif
 }
 
 TEMPLATE_TYPE
@@ -197,12 +308,22 @@ void IMPL::encode(
 {
     time_lossless = 0;
 
-    struct Header header;
-
-    asz::hf_encode_coarse_rev1<T, H, M>(
-        in_uncompressed, in_uncompressed_len,  //
-        book_desc, bitstream_desc,             //
-        out_compressed, out_compressed_len, time_lossless, stream);
+    // padding included, so equal inputs give equal bytes
+    Header header;
+    memset(&header, 0x0, sizeof(header));
+
+    if (policy == CPU)
+        asz::hf_encode_coarse_cpu<T, H, M>(
+            in_uncompressed, in_uncompressed_len,  //
+            book_desc, bitstream_desc,             //
+            out_compressed, out_compressed_len, time_lossless);
+#ifndef CUSZ_HOST_ONLY
+    else
+        asz::hf_encode_coarse_rev1<T, H, M>(
+            in_uncompressed, in_uncompressed_len,  //
+            book_desc, bitstream_desc,             //
+            out_compressed, out_compressed_len, time_lossless, stream);
+#endif
 
     header.total_nbit =
         std::accumulate((M*)chunk_desc_h->bits, (M*)chunk_desc_h->bits + bitstream_desc->pardeg, (size_t)0);
@@ -215,7 +336,7 @@ void IMPL::encode(
     subfile_collect(
         header, in_uncompressed_len, book_desc->booklen, bitstream_desc->sublen, bitstream_desc->pardeg, stream);
 
-    out_compressed     = d_compressed;
+    out_compressed     = policy == CPU ? h_compressed : d_compressed;
     out_compressed_len = header.subfile_size();
 }
 
@@ -223,8 +344,12 @@ TEMPLATE_TYPE
 void IMPL::decode(BYTE* in_compressed, T* out_decompressed, cudaStream_t stream, bool header_on_device)
 {
     Header header;
-    if (header_on_device)
+    if (policy == CPU)
+        memcpy(&header, in_compressed, sizeof(header));
+#ifndef CUSZ_HOST_ONLY
+    else if (header_on_device)
         CHECK_CUDA(cudaMemcpyAsync(&header, in_compressed, sizeof(header), cudaMemcpyDeviceToHost, stream));
+#endif
 
     auto d_revbook   = ACCESSOR(REVBOOK, BYTE);
     auto d_par_nbit  = ACCESSOR(PAR_NBIT, M);
@@ -233,15 +358,102 @@ void IMPL::decode(BYTE* in_compressed, T* out_decompressed, cudaStream_t stream,
 
     auto const revbook_nbyte = get_revbook_nbyte(header.booklen);
 
+    if (policy == CPU) {
+        asz::hf_decode_coarse_cpu<T, H, M>(
+            d_bitstream, d_revbook, revbook_nbyte, d_par_nbit, d_par_entry, header.sublen, header.pardeg,
+            out_decompressed, time_lossless);
+        return;
+    }
+
+#ifndef CUSZ_HOST_ONLY
     // launch_coarse_grained_Huffman_decoding<T, H, M>(
     asz::hf_decode_coarse<T, H, M>(
         d_bitstream, d_revbook, revbook_nbyte, d_par_nbit, d_par_entry, header.sublen, header.pardeg, out_decompressed,
         time_lossless, stream);
+#endif
+}
+
+/**
+ * @brief Chunk i covers elements [i * sublen, (i + 1) * sublen) and par_entry already records where its bits start,
+ * so any subset of chunks can be decoded without touching the rest of the bitstream.
+ *
+ * @param in_compressed (host) Huffman subfile
+ * @param in_ranges ascending, disjoint [begin, end) element pairs, 2 * nrange in total
+ * @param out_decompressed (host) the ranges back to back, sum of (end - begin) symbols
+ */
+TEMPLATE_TYPE
+void IMPL::decode_region(BYTE* in_compressed, size_t const* in_ranges, size_t const nrange, T* out_decompressed)
+{
+    Header header;
+    memcpy(&header, in_compressed, sizeof(header));
+
+    // where each range starts in the output
+    std::vector<size_t>  offset(nrange + 1, 0);
+    std::vector<uint8_t> chunk_mask(header.pardeg, 0);
+    for (auto r = 0u; r < nrange; r++) {
+        auto begin = in_ranges[2 * r], end = std::min(in_ranges[2 * r + 1], header.uncompressed_len);
+        offset[r + 1] = offset[r] + (in_ranges[2 * r + 1] - in_ranges[2 * r]);
+        if (begin >= end) continue;
+        for (auto i = begin / header.sublen; i <= (end - 1) / header.sublen; i++) chunk_mask[i] = 1;
+    }
+
+    // copy the part of a chunk that falls in each range
+    auto consume = [&](size_t begin, size_t end, T* quant) {
+        auto r = std::upper_bound(in_ranges + 1, in_ranges + 2 * nrange, begin) - in_ranges;
+        for (r /= 2; r < (long)nrange and in_ranges[2 * r] < end; r++) {
+            auto lo = std::max(begin, in_ranges[2 * r]), hi = std::min(end, in_ranges[2 * r + 1]);
+            auto to = out_decompressed + offset[r] + (lo - in_ranges[2 * r]);
+            if (lo < hi) memcpy(to, quant + (lo - begin), sizeof(T) * (hi - lo));
+        }
+    };
+
+    auto const revbook_nbyte = get_revbook_nbyte(header.booklen);
+
+    asz::hf_decode_chunkwise_cpu<T, H, M>(
+        ACCESSOR(BITSTREAM, H), ACCESSOR(REVBOOK, BYTE), revbook_nbyte, ACCESSOR(PAR_NBIT, M), ACCESSOR(PAR_ENTRY, M),
+        header.sublen, header.pardeg, header.uncompressed_len, consume, time_lossless, chunk_mask.data());
+}
+
+/**
+ * @brief Decoding a chunk to a per-thread buffer and consuming it right away keeps the full-length output of decode()
+ * out of memory; e.g., the consumer reconstructs the data of the chunk from its quant-codes.
+ *
+ * @param in_compressed (host) Huffman subfile
+ * @param align the consumer takes chunks of a multiple of `align` symbols
+ * @param consume see asz::hf_decode_chunkwise_cpu
+ */
+TEMPLATE_TYPE
+bool IMPL::decode_chunkwise(
+    BYTE*                                          in_compressed,
+    size_t const                                   align,
+    std::function<void(size_t, size_t, T*)> const& consume)
+{
+    Header header;
+    memcpy(&header, in_compressed, sizeof(header));
+
+    if (header.sublen % align != 0) return false;
+
+    auto const revbook_nbyte = get_revbook_nbyte(header.booklen);
+
+    asz::hf_decode_chunkwise_cpu<T, H, M>(
+        ACCESSOR(BITSTREAM, H), ACCESSOR(REVBOOK, BYTE), revbook_nbyte, ACCESSOR(PAR_NBIT, M), ACCESSOR(PAR_ENTRY, M),
+        header.sublen, header.pardeg, header.uncompressed_len, consume, time_lossless);
+    return true;
 }
 
 TEMPLATE_TYPE
 void IMPL::clear_buffer()
 {
+    if (policy == CPU) {
+        memset(h_tmp, 0x0, rte.nbyte[RTE::TMP]);
+        memset(h_book, 0x0, rte.nbyte[RTE::BOOK]);
+        memset(h_revbook, 0x0, rte.nbyte[RTE::REVBOOK]);
+        memset(h_par_metadata, 0x0, rte.nbyte[RTE::PAR_NBIT] * 3);
+        memset(h_bitstream, 0x0, rte.nbyte[RTE::BITSTREAM]);
+        return;
+    }
+
+#ifndef CUSZ_HOST_ONLY
     cudaMemset(d_tmp, 0x0, rte.nbyte[RTE::TMP]);
     cudaMemset(d_book, 0x0, rte.nbyte[RTE::BOOK]);
     cudaMemset(d_revbook, 0x0, rte.nbyte[RTE::REVBOOK]);
@@ -249,6 +461,7 @@ void IMPL::clear_buffer()
     cudaMemset(d_par_ncell, 0x0, rte.nbyte[RTE::PAR_NCELL]);
     cudaMemset(d_par_entry, 0x0, rte.nbyte[RTE::PAR_ENTRY]);
     cudaMemset(d_bitstream, 0x0, rte.nbyte[RTE::BITSTREAM]);
+#endif
 }
 
 // private helper
@@ -261,13 +474,6 @@ void IMPL::subfile_collect(
     int const    pardeg,
     cudaStream_t stream)
 {
-    auto BARRIER = [&]() {
-        if (stream)
-            CHECK_CUDA(cudaStreamSynchronize(stream));
-        else
-            CHECK_CUDA(cudaDeviceSynchronize());
-    };
-
     header.header_nbyte     = sizeof(Header);
     header.booklen          = booklen;
     header.sublen           = sublen;
@@ -292,6 +498,25 @@ void IMPL::subfile_collect(
     // };
     // debug_header_entry();
 
+    if (policy == CPU) {
+        memcpy(h_compressed, &header, sizeof(header));
+
+        HOST2HOST_COPY(revbook, REVBOOK)
+        HOST2HOST_COPY(par_nbit, PAR_NBIT)
+        HOST2HOST_COPY(par_entry, PAR_ENTRY)
+        HOST2HOST_COPY(bitstream, BITSTREAM)
+
+        return;
+    }
+
+#ifndef CUSZ_HOST_ONLY
+    auto BARRIER = [&]() {
+        if (stream)
+            CHECK_CUDA(cudaStreamSynchronize(stream));
+        else
+            CHECK_CUDA(cudaDeviceSynchronize());
+    };
+
     CHECK_CUDA(cudaMemcpyAsync(d_compressed, &header, sizeof(header), cudaMemcpyHostToDevice, stream));
 
     /* debug */ BARRIER();
@@ -300,6 +525,7 @@ void IMPL::subfile_collect(
     DEVICE2DEVICE_COPY(par_nbit, PAR_NBIT)
     DEVICE2DEVICE_COPY(par_entry, PAR_ENTRY)
     DEVICE2DEVICE_COPY(bitstream, BITSTREAM)
+#endif
 }
 
 // getter
@@ -312,10 +538,10 @@ TEMPLATE_TYPE
 float IMPL::get_time_lossless() const { return time_lossless; }
 
 TEMPLATE_TYPE
-H* IMPL::expose_book() const { return d_book; }
+H* IMPL::expose_book() const { return policy == CPU ? h_book : d_book; }
 
 TEMPLATE_TYPE
-BYTE* IMPL::expose_revbook() const { return d_revbook; }
+BYTE* IMPL::expose_revbook() const { return policy == CPU ? h_revbook : d_revbook; }
 
 // TODO this kind of space will be overlapping with quant-codes
 TEMPLATE_TYPE
@@ -334,6 +560,7 @@ constexpr bool IMPL::can_overlap_input_and_firstphase_encode() { return sizeof(T
 TEMPLATE_TYPE
 void IMPL::dbg_println(const std::string SYM_name, void* VAR, int SYM)
 {
+#ifndef CUSZ_HOST_ONLY
     CUdeviceptr pbase0{0};
     size_t      psize0{0};
 
@@ -346,6 +573,7 @@ void IMPL::dbg_println(const std::string SYM_name, void* VAR, int SYM)
         "\t(queried)  psize0  : %'9lu\n",
         SYM_name.c_str(), (void*)VAR, (size_t)rte.nbyte[SYM], (void*)&pbase0, psize0);
     pbase0 = 0, psize0 = 0;
+#endif
 }
 
 }  // namespace cusz
@@ -354,6 +582,11 @@ void IMPL::dbg_println(const std::string SYM_name, void* VAR, int SYM)
 #undef HC_ALLOCHOST
 #undef HC_FREEDEV
 #undef HC_FREEHOST
+#undef HC_ALLOCHOST_PAGEABLE
+#undef HC_FREEHOST_PAGEABLE
+#undef HC_ALLOC
+#undef HC_FREE
+#undef HOST2HOST_COPY
 #undef EXPORT_NBYTE
 #undef ACCESSOR
 #undef DEVICE2DEVICE_COPY
@@ -49,9 +49,26 @@ HUFFMAN_COARSE& HUFFMAN_COARSE::operator=(HUFFMAN_COARSE&&) = default;
 //------------------------------------------------------------------------------
 
 TEMPLATE_TYPE
-void HUFFMAN_COARSE::init(size_t const in_uncompressed_len, int const booklen, int const pardeg, bool dbg_print)
+void HUFFMAN_COARSE::set_memory_resource(memory_resource* mem) { pimpl->set_memory_resource(mem); }
+
+TEMPLATE_TYPE
+void HUFFMAN_COARSE::set_chunk_alignment(size_t const align) { pimpl->set_chunk_alignment(align); }
+
+TEMPLATE_TYPE
+void HUFFMAN_COARSE::set_approximate_bookcache(bool const approximate)
+{
+    pimpl->set_approximate_bookcache(approximate);
+}
+
+TEMPLATE_TYPE
+void HUFFMAN_COARSE::init(
+    size_t const          in_uncompressed_len,
+    int const             booklen,
+    int const             pardeg,
+    bool                  dbg_print,
+    cusz_execution_policy policy)
 {
-    pimpl->init(in_uncompressed_len, booklen, pardeg, dbg_print);
+    pimpl->init(in_uncompressed_len, booklen, pardeg, dbg_print, policy);
 }
 
 TEMPLATE_TYPE
@@ -77,6 +94,25 @@ void HUFFMAN_COARSE::decode(BYTE* in_compressed, T* out_decompressed, cudaStream
     pimpl->decode(in_compressed, out_decompressed, stream, header_on_device);
 }
 
+TEMPLATE_TYPE
+void HUFFMAN_COARSE::decode_region(
+    BYTE*         in_compressed,
+    size_t const* in_ranges,
+    size_t const  nrange,
+    T*            out_decompressed)
+{
+    pimpl->decode_region(in_compressed, in_ranges, nrange, out_decompressed);
+}
+
+TEMPLATE_TYPE
+bool HUFFMAN_COARSE::decode_chunkwise(
+    BYTE*                                          in_compressed,
+    size_t const                                   align,
+    std::function<void(size_t, size_t, T*)> const& consume)
+{
+    return pimpl->decode_chunkwise(in_compressed, align, consume);
+}
+
 TEMPLATE_TYPE
 void HUFFMAN_COARSE::clear_buffer() { pimpl->clear_buffer(); }
 
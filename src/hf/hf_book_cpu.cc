@@ -0,0 +1,32 @@
+/**
+ * @file hf_book_cpu.cc
+ * @author Jiannan Tian
+ * @brief
+ * @version 0.3
+ * @date 2022-12-08
+ *
+ * (C) 2022 by Indiana University, Argonne National Laboratory
+ *
+ */
+
+#include "detail/hf_book_cpu.inl"
+#include "hf/hf_book_cpu.hh"
+
+#define HOST_BOOK(T, H) template void asz::hf_buildbook_cpu<T, H>(uint32_t*, int const, H*, uint8_t*, int const, float*);
+
+HOST_BOOK(uint8_t, uint32_t);
+HOST_BOOK(uint16_t, uint32_t);
+HOST_BOOK(uint32_t, uint32_t);
+HOST_BOOK(float, uint32_t);
+
+HOST_BOOK(uint8_t, uint64_t);
+HOST_BOOK(uint16_t, uint64_t);
+HOST_BOOK(uint32_t, uint64_t);
+HOST_BOOK(float, uint64_t);
+
+HOST_BOOK(uint8_t, unsigned long long);
+HOST_BOOK(uint16_t, unsigned long long);
+HOST_BOOK(uint32_t, unsigned long long);
+HOST_BOOK(float, unsigned long long);
+
+#undef HOST_BOOK
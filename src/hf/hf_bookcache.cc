@@ -0,0 +1,101 @@
+/**
+ * @file hf_bookcache.cc
+ * @author Jiannan Tian
+ * @brief
+ * @version 0.3
+ * @date 2022-12-12
+ *
+ * (C) 2022 by Indiana University, Argonne National Laboratory
+ *
+ */
+
+#include "hf/hf_bookcache.hh"
+#include <cstring>
+
+void asz::hf_bookcache::set_approximate(bool const _approximate)
+{
+    if (_approximate != approximate) clear();
+    approximate = _approximate;
+}
+
+void asz::hf_bookcache::fingerprint(uint32_t const* freq, int const booklen, fingerprint_t& fp, uint64_t& hash) const
+{
+    fp.resize(booklen);
+    hash = 0xcbf29ce484222325ull;  // FNV-1a, one 32-bit bin at a time
+
+    for (auto i = 0; i < booklen; i++) {
+        auto bin = freq[i];
+        // magnitude: 0 for 0, then 1 for 1, 2 for 2-3, 3 for 4-7, ...
+        if (approximate) bin = bin == 0 ? 0 : 32 - __builtin_clz(bin);
+
+        fp[i] = bin;
+        hash  = (hash ^ bin) * 0x100000001b3ull;
+    }
+}
+
+bool asz::hf_bookcache::covers(uint8_t const* book, size_t const book_nbyte, uint32_t const* freq, size_t const booklen)
+{
+    auto const width = book_nbyte / booklen;  // sizeof(H); the 8 MSBs of a codeword hold its length, 0 for none
+
+    for (auto i = 0u; i < booklen; i++) {
+        if (freq[i] == 0) continue;
+
+        uint64_t cw = 0;
+        memcpy(&cw, book + i * width, width);
+        if ((cw >> (width * 8 - 8) & 0xff) == 0) return false;
+    }
+    return true;
+}
+
+bool asz::hf_bookcache::close(fingerprint_t const& a, fingerprint_t const& b)
+{
+    if (a.size() != b.size()) return false;
+
+    for (auto i = 0u; i < a.size(); i++)
+        if (a[i] > b[i] + 1 or b[i] > a[i] + 1) return false;
+    return true;
+}
+
+bool asz::hf_bookcache::lookup(
+    uint32_t const*      freq,
+    fingerprint_t const& fp,
+    uint64_t const       hash,
+    uint8_t*             book,
+    size_t const         book_nbyte,
+    uint8_t*             revbook,
+    size_t const         revbook_nbyte)
+{
+    for (auto it = entries.begin(); it != entries.end(); it++) {
+        if (it->book.size() != book_nbyte or it->revbook.size() != revbook_nbyte) continue;
+
+        if (not approximate and (it->hash != hash or it->fp != fp)) continue;
+        if (approximate and (not close(it->fp, fp) or not covers(it->book.data(), book_nbyte, freq, fp.size())))
+            continue;
+
+        memcpy(book, it->book.data(), book_nbyte);
+        memcpy(revbook, it->revbook.data(), revbook_nbyte);
+        entries.splice(entries.begin(), entries, it);
+
+        hits++;
+        return true;
+    }
+
+    misses++;
+    return false;
+}
+
+void asz::hf_bookcache::insert(
+    fingerprint_t const& fp,
+    uint64_t const       hash,
+    uint8_t const*       book,
+    size_t const         book_nbyte,
+    uint8_t const*       revbook,
+    size_t const         revbook_nbyte)
+{
+    if (capacity == 0) return;
+    if (entries.size() == capacity) entries.pop_back();
+
+    entries.push_front(entry{
+        hash, fp, std::vector<uint8_t>(book, book + book_nbyte),
+        std::vector<uint8_t>(revbook, revbook + revbook_nbyte)});
+}
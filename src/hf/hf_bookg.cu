@@ -12,8 +12,9 @@
 #include "detail/hf_bookg.inl"
 #include "hf/hf_bookg.hh"
 
-#define PAR_BOOK(T, H) \
-    template void asz::hf_buildbook_g<T, H>(uint32_t*, int const, H*, uint8_t*, int const, float*, cudaStream_t);
+#define PAR_BOOK(T, H)                       \
+    template void asz::hf_buildbook_g<T, H>( \
+        uint32_t*, int const, H*, uint8_t*, int const, float*, cudaStream_t, cusz::memory_resource*);
 
 PAR_BOOK(uint8_t, uint32_t);
 PAR_BOOK(uint16_t, uint32_t);
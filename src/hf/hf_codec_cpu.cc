@@ -0,0 +1,39 @@
+/**
+ * @file hf_codec_cpu.cc
+ * @author Jiannan Tian
+ * @brief
+ * @version 0.3
+ * @date 2022-12-08
+ *
+ * (C) 2022 by Indiana University, Argonne National Laboratory
+ *
+ */
+
+#include "detail/hf_codec_cpu.inl"
+#include "hf/hf_codec_cpu.hh"
+
+#define HF_CODEC_CPU_INIT(T, H, M)                                                                              \
+    template void asz::hf_encode_coarse_cpu<T, H, M>(                                                           \
+        T*, size_t const, hf_book*, hf_bitstream*, uint8_t*&, size_t&, float&);                                 \
+                                                                                                                \
+    template void asz::hf_decode_coarse_cpu<T, H, M>(                                                           \
+        H*, uint8_t*, int const, M*, M*, int const, int const, T*, float&);                                     \
+                                                                                                                \
+    template void asz::hf_decode_chunkwise_cpu<T, H, M>(                                                        \
+        H*, uint8_t*, int const, M*, M*, int const, int const, size_t const,                                    \
+        std::function<void(size_t, size_t, T*)> const&, float&, uint8_t const*);
+
+HF_CODEC_CPU_INIT(uint8_t, uint32_t, uint32_t);
+HF_CODEC_CPU_INIT(uint16_t, uint32_t, uint32_t);
+HF_CODEC_CPU_INIT(uint32_t, uint32_t, uint32_t);
+HF_CODEC_CPU_INIT(float, uint32_t, uint32_t);
+HF_CODEC_CPU_INIT(uint8_t, uint64_t, uint32_t);
+HF_CODEC_CPU_INIT(uint16_t, uint64_t, uint32_t);
+HF_CODEC_CPU_INIT(uint32_t, uint64_t, uint32_t);
+HF_CODEC_CPU_INIT(float, uint64_t, uint32_t);
+HF_CODEC_CPU_INIT(uint8_t, unsigned long long, uint32_t);
+HF_CODEC_CPU_INIT(uint16_t, unsigned long long, uint32_t);
+HF_CODEC_CPU_INIT(uint32_t, unsigned long long, uint32_t);
+HF_CODEC_CPU_INIT(float, unsigned long long, uint32_t);
+
+#undef HF_CODEC_CPU_INIT
@@ -891,9 +891,11 @@ __global__ void parsz::cuda::__kernel::v0::compaction::c_lorenzo_3d1l(
         if (x < len3.x and y < len3.y and z < len3.z) {
             quant[gid] = quantizable * static_cast<EQ>(candidate);
             if (not quantizable) {
-                auto cur_idx         = atomicAdd(outlier.count, 1);
-                outlier.idx[cur_idx] = gid;
-                outlier.val[cur_idx] = candidate;
+                auto cur_idx = atomicAdd(outlier.count, 1);
+                if (cur_idx < outlier.capacity) {
+                    outlier.idx[cur_idx] = gid;
+                    outlier.val[cur_idx] = candidate;
+                }
             }
         }
     };
@@ -966,9 +968,11 @@ __global__ void parsz::cuda::__kernel::v1_pn::compaction::c_lorenzo_3d1l(
         if (x < len3.x and y < len3.y and z < len3.z) {
             quant[gid] = quantizable * UI_delta;
             if (not quantizable) {
-                auto cur_idx         = atomicAdd(outlier.count, 1);
-                outlier.idx[cur_idx] = gid;
-                outlier.val[cur_idx] = UI_delta;
+                auto cur_idx = atomicAdd(outlier.count, 1);
+                if (cur_idx < outlier.capacity) {
+                    outlier.idx[cur_idx] = gid;
+                    outlier.val[cur_idx] = UI_delta;
+                }
             }
         }
     };
@@ -0,0 +1,590 @@
+/**
+ * @file lorenzo_cpu.inl
+ * @author Jiannan Tian
+ * @brief Host (OpenMP) counterpart of the v0 Lorenzo pred-quant kernels.
+ * @version 0.3
+ * @date 2022-12-08
+ *
+ * (C) 2022 by Indiana University, Argonne National Laboratory
+ *
+ */
+
+#ifndef C1F4F7A5_0B3E_4C55_9C8B_5D4F3C2E6A10
+#define C1F4F7A5_0B3E_4C55_9C8B_5D4F3C2E6A10
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "stat/stat.hh"
+#include "typing.inl"
+
+// The tiling mirrors the CUDA v0 kernels (1D 256, 2D 16x16, 3D 8x8x8), so that
+// both backends produce the same quant-codes and outliers. Each tile is
+// independent (out-of-tile neighbors are 0), hence parallel over tiles.
+// Given a histogram, the construct kernels count each tile's quant-codes right
+// after writing them, while they are still in cache. Outliers are appended to a
+// compacted (idx, val) sink, as the CUDA compaction kernels do.
+
+namespace parsz {
+namespace cpu {
+namespace __kernel {
+namespace v0 {
+
+template <typename T, typename EQ, typename FP, int BLOCK = 256>
+void c_lorenzo_1d1l(
+    T*                                data,
+    dim3                              len3,
+    dim3                              stride3,
+    int                               radius,
+    FP                                ebx2_r,
+    EQ*                               quant,
+    CompactionDRAM<T>                 outlier,
+    asz::stat::histogram_cpu_private* hist = nullptr);
+
+template <typename T, typename EQ, typename FP, int BLOCK = 16>
+void c_lorenzo_2d1l(
+    T*                                data,
+    dim3                              len3,
+    dim3                              stride3,
+    int                               radius,
+    FP                                ebx2_r,
+    EQ*                               quant,
+    CompactionDRAM<T>                 outlier,
+    asz::stat::histogram_cpu_private* hist = nullptr);
+
+template <typename T, typename EQ, typename FP, int BLOCK = 8>
+void c_lorenzo_3d1l(
+    T*                                data,
+    dim3                              len3,
+    dim3                              stride3,
+    int                               radius,
+    FP                                ebx2_r,
+    EQ*                               quant,
+    CompactionDRAM<T>                 outlier,
+    asz::stat::histogram_cpu_private* hist = nullptr);
+
+template <typename T, typename EQ, typename FP, int BLOCK = 256>
+void x_lorenzo_1d1l(
+    EQ*  quant,
+    T*   outlier,
+    dim3 len3,
+    dim3 stride3,
+    int  radius,
+    FP   ebx2,
+    T*   xdata,
+    dim3 tile_lo = dim3(0, 0, 0),
+    dim3 tile_hi = dim3(UINT32_MAX, UINT32_MAX, UINT32_MAX));
+
+template <typename T, typename EQ, typename FP, int BLOCK = 16>
+void x_lorenzo_2d1l(
+    EQ*  quant,
+    T*   outlier,
+    dim3 len3,
+    dim3 stride3,
+    int  radius,
+    FP   ebx2,
+    T*   xdata,
+    dim3 tile_lo = dim3(0, 0, 0),
+    dim3 tile_hi = dim3(UINT32_MAX, UINT32_MAX, UINT32_MAX));
+
+template <typename T, typename EQ, typename FP, int BLOCK = 8>
+void x_lorenzo_3d1l(
+    EQ*  quant,
+    T*   outlier,
+    dim3 len3,
+    dim3 stride3,
+    int  radius,
+    FP   ebx2,
+    T*   xdata,
+    dim3 tile_lo = dim3(0, 0, 0),
+    dim3 tile_hi = dim3(UINT32_MAX, UINT32_MAX, UINT32_MAX));
+
+// Second-order (2-layer) Lorenzo, for 1D (BY = BZ = 1), 2D (BZ = 1) and 3D alike: the residual is (1 - B)^2 along
+// each axis, and reconstruction takes two partial sums along each. It has no CUDA counterpart to match, so the tiles
+// are larger than the 1-layer ones, keeping fewer points next to a tile border (predicted from zeros). Tiles are
+// worked on in double: the residuals reach 4^d times the prequantized values, past the integers exact in float.
+// Returns false if some residual (as an outlier) is not exact in T.
+template <typename T, typename EQ, typename FP, int BX, int BY, int BZ>
+bool c_lorenzo_2l(
+    T*                                data,
+    dim3                              len3,
+    dim3                              stride3,
+    int                               radius,
+    FP                                ebx2_r,
+    EQ*                               quant,
+    CompactionDRAM<T>                 outlier,
+    asz::stat::histogram_cpu_private* hist = nullptr);
+
+template <typename T, typename EQ, typename FP, int BX, int BY, int BZ>
+void x_lorenzo_2l(EQ* quant, T* outlier, dim3 len3, dim3 stride3, int radius, FP ebx2, T* xdata);
+
+}  // namespace v0
+}  // namespace __kernel
+}  // namespace cpu
+}  // namespace parsz
+
+namespace parsz {
+namespace cpu {
+namespace __device {
+namespace v0 {
+
+template <typename T>
+inline void compact_outlier(CompactionDRAM<T>& outlier, size_t gid, T val)
+{
+    uint32_t cur_idx;
+#pragma omp atomic capture
+    cur_idx = (*outlier.count)++;
+    if (cur_idx < outlier.capacity) {
+        outlier.idx[cur_idx] = gid;
+        outlier.val[cur_idx] = val;
+    }
+}
+
+template <typename T, typename EQ>
+inline void quantize_write(T delta, int radius, size_t gid, EQ* quant, CompactionDRAM<T>& outlier)
+{
+    bool quantizable = std::fabs(delta) < radius;
+    T    candidate   = delta + radius;
+    quant[gid]       = quantizable * static_cast<EQ>(candidate);
+    if (not quantizable) compact_outlier(outlier, gid, candidate);
+}
+
+template <typename T, typename EQ>
+inline T load_fuse(EQ* quant, T* outlier, int radius, size_t gid)
+{
+    return outlier[gid] + static_cast<T>(quant[gid]) - radius;
+}
+
+// s[i] -= 2 s[i - 1] - s[i - 2] along `n` rows of `width` contiguous elements, `stride` apart; backward, so that the
+// neighbors are the values before
+inline void difference_2l_along(double* s, int const n, int const stride, int const width)
+{
+    for (auto i = n - 1; i >= 1; i--) {
+        auto cur = s + i * stride, p1 = cur - stride, p2 = cur - 2 * stride;
+        if (i >= 2)
+            for (auto w = 0; w < width; w++) cur[w] += p2[w] - 2 * p1[w];
+        else
+            for (auto w = 0; w < width; w++) cur[w] -= 2 * p1[w];
+    }
+}
+
+// s[i] += 2 s[i - 1] - s[i - 2], the inverse of difference_2l_along
+inline void partial_sum_2l_along(double* s, int const n, int const stride, int const width)
+{
+    for (auto i = 1; i < n; i++) {
+        auto cur = s + i * stride, p1 = cur - stride, p2 = cur - 2 * stride;
+        if (i >= 2)
+            for (auto w = 0; w < width; w++) cur[w] += 2 * p1[w] - p2[w];
+        else
+            for (auto w = 0; w < width; w++) cur[w] += 2 * p1[w];
+    }
+}
+
+// (1 - B)^2 along x, y and z of a BZ x BY x BX tile, with zeros outside it
+template <int BX, int BY, int BZ>
+inline void difference_2l(double* s)
+{
+    for (auto r = 0; r < BY * BZ; r++) difference_2l_along(s + r * BX, BX, 1, 1);
+    for (auto z = 0; z < BZ; z++) difference_2l_along(s + z * BY * BX, BY, BX, BX);
+    difference_2l_along(s, BZ, BY * BX, BY * BX);
+}
+
+template <int BX, int BY, int BZ>
+inline void partial_sum_2l(double* s)
+{
+    for (auto r = 0; r < BY * BZ; r++) partial_sum_2l_along(s + r * BX, BX, 1, 1);
+    for (auto z = 0; z < BZ; z++) partial_sum_2l_along(s + z * BY * BX, BY, BX, BX);
+    partial_sum_2l_along(s, BZ, BY * BX, BY * BX);
+}
+
+}  // namespace v0
+}  // namespace __device
+}  // namespace cpu
+}  // namespace parsz
+
+template <typename T, typename EQ, typename FP, int BLOCK>
+void parsz::cpu::__kernel::v0::c_lorenzo_1d1l(
+    T*                                data,
+    dim3                              len3,
+    dim3,
+    int                               radius,
+    FP                                ebx2_r,
+    EQ*                               quant,
+    CompactionDRAM<T>                 outlier,
+    asz::stat::histogram_cpu_private* hist)
+{
+    namespace subr_v0 = parsz::cpu::__device::v0;
+
+    int64_t ntile = (len3.x - 1) / BLOCK + 1;
+
+#pragma omp parallel for schedule(static)
+    for (int64_t b = 0; b < ntile; b++) {
+        size_t id_base = b * BLOCK;
+        T      prev    = 0;
+        for (size_t id = id_base; id < id_base + BLOCK and id < len3.x; id++) {
+            T cur = std::round(data[id] * ebx2_r);  // prequant (fp presence)
+            subr_v0::quantize_write<T, EQ>(cur - prev, radius, id, quant, outlier);
+            prev = cur;
+        }
+        if (hist) hist->count(quant + id_base, std::min<size_t>(BLOCK, len3.x - id_base));
+    }
+}
+
+template <typename T, typename EQ, typename FP, int BLOCK>
+void parsz::cpu::__kernel::v0::c_lorenzo_2d1l(
+    T*                                data,
+    dim3                              len3,
+    dim3                              stride3,
+    int                               radius,
+    FP                                ebx2_r,
+    EQ*                               quant,
+    CompactionDRAM<T>                 outlier,
+    asz::stat::histogram_cpu_private* hist)
+{
+    namespace subr_v0 = parsz::cpu::__device::v0;
+
+    int64_t ntile_x = (len3.x - 1) / BLOCK + 1;
+    int64_t ntile_y = (len3.y - 1) / BLOCK + 1;
+
+#pragma omp parallel for schedule(static)
+    for (int64_t b = 0; b < ntile_x * ntile_y; b++) {
+        size_t gix_base = (b % ntile_x) * BLOCK;
+        size_t giy_base = (b / ntile_x) * BLOCK;
+
+        T s[BLOCK + 1][BLOCK + 1] = {{0}};  // padded with the zero (out-of-tile) neighbors
+
+        for (auto y = 0; y < BLOCK; y++)
+            for (auto x = 0; x < BLOCK; x++) {
+                auto gix = gix_base + x, giy = giy_base + y;
+                if (gix < len3.x and giy < len3.y) s[y + 1][x + 1] = std::round(data[giy * stride3.y + gix] * ebx2_r);
+            }
+
+        for (auto y = 1; y < BLOCK + 1; y++)
+            for (auto x = 1; x < BLOCK + 1; x++) {
+                auto gix = gix_base + x - 1, giy = giy_base + y - 1;
+                if (gix < len3.x and giy < len3.y) {
+                    T delta = s[y][x] - (s[y][x - 1] + s[y - 1][x] - s[y - 1][x - 1]);
+                    subr_v0::quantize_write<T, EQ>(delta, radius, giy * stride3.y + gix, quant, outlier);
+                }
+            }
+
+        if (hist)
+            for (auto giy = giy_base; giy < std::min<size_t>(giy_base + BLOCK, len3.y); giy++)
+                hist->count(quant + giy * stride3.y + gix_base, std::min<size_t>(BLOCK, len3.x - gix_base));
+    }
+}
+
+template <typename T, typename EQ, typename FP, int BLOCK>
+void parsz::cpu::__kernel::v0::c_lorenzo_3d1l(
+    T*                                data,
+    dim3                              len3,
+    dim3                              stride3,
+    int                               radius,
+    FP                                ebx2_r,
+    EQ*                               quant,
+    CompactionDRAM<T>                 outlier,
+    asz::stat::histogram_cpu_private* hist)
+{
+    namespace subr_v0 = parsz::cpu::__device::v0;
+
+    int64_t ntile_x = (len3.x - 1) / BLOCK + 1;
+    int64_t ntile_y = (len3.y - 1) / BLOCK + 1;
+    int64_t ntile_z = (len3.z - 1) / BLOCK + 1;
+
+#pragma omp parallel for schedule(static)
+    for (int64_t b = 0; b < ntile_x * ntile_y * ntile_z; b++) {
+        size_t gix_base = (b % ntile_x) * BLOCK;
+        size_t giy_base = ((b / ntile_x) % ntile_y) * BLOCK;
+        size_t giz_base = (b / (ntile_x * ntile_y)) * BLOCK;
+
+        T s[BLOCK + 1][BLOCK + 1][BLOCK + 1] = {{{0}}};
+
+        auto in_range = [&](auto x, auto y, auto z) { return x < len3.x and y < len3.y and z < len3.z; };
+        auto gid      = [&](auto x, auto y, auto z) { return z * stride3.z + y * stride3.y + x; };
+
+        for (auto z = 0; z < BLOCK; z++)
+            for (auto y = 0; y < BLOCK; y++)
+                for (auto x = 0; x < BLOCK; x++) {
+                    auto gix = gix_base + x, giy = giy_base + y, giz = giz_base + z;
+                    if (in_range(gix, giy, giz)) s[z + 1][y + 1][x + 1] = std::round(data[gid(gix, giy, giz)] * ebx2_r);
+                }
+
+        for (auto z = 1; z < BLOCK + 1; z++)
+            for (auto y = 1; y < BLOCK + 1; y++)
+                for (auto x = 1; x < BLOCK + 1; x++) {
+                    auto gix = gix_base + x - 1, giy = giy_base + y - 1, giz = giz_base + z - 1;
+                    if (not in_range(gix, giy, giz)) continue;
+
+                    T delta = s[z][y][x] -                        //
+                              (s[z - 1][y - 1][x - 1]             // dist=3
+                               - s[z][y - 1][x - 1]               // dist=2
+                               - s[z - 1][y][x - 1]               //
+                               - s[z - 1][y - 1][x]               //
+                               + s[z][y][x - 1]                   // dist=1
+                               + s[z][y - 1][x]                   //
+                               + s[z - 1][y][x]);                 //
+                    subr_v0::quantize_write<T, EQ>(delta, radius, gid(gix, giy, giz), quant, outlier);
+                }
+
+        if (hist)
+            for (auto giz = giz_base; giz < std::min<size_t>(giz_base + BLOCK, len3.z); giz++)
+                for (auto giy = giy_base; giy < std::min<size_t>(giy_base + BLOCK, len3.y); giy++)
+                    hist->count(quant + gid(gix_base, giy, giz), std::min<size_t>(BLOCK, len3.x - gix_base));
+    }
+}
+
+template <typename T, typename EQ, typename FP, int BLOCK>
+void parsz::cpu::__kernel::v0::x_lorenzo_1d1l(
+    EQ*  quant,
+    T*   outlier,
+    dim3 len3,
+    dim3,
+    int  radius,
+    FP   ebx2,
+    T*   xdata,
+    dim3 tile_lo,
+    dim3 tile_hi)
+{
+    namespace subr_v0 = parsz::cpu::__device::v0;
+
+    int64_t ntile = (len3.x - 1) / BLOCK + 1;
+    int64_t t0 = tile_lo.x, t1 = std::min<int64_t>(ntile, tile_hi.x);
+
+#pragma omp parallel for schedule(static)
+    for (int64_t b = t0; b < t1; b++) {
+        size_t id_base = b * BLOCK;
+        T      sum     = 0;
+        for (size_t id = id_base; id < id_base + BLOCK and id < len3.x; id++) {
+            sum += subr_v0::load_fuse<T, EQ>(quant, outlier, radius, id);
+            xdata[id] = sum * ebx2;
+        }
+    }
+}
+
+template <typename T, typename EQ, typename FP, int BLOCK>
+void parsz::cpu::__kernel::v0::x_lorenzo_2d1l(
+    EQ*  quant,
+    T*   outlier,
+    dim3 len3,
+    dim3 stride3,
+    int  radius,
+    FP   ebx2,
+    T*   xdata,
+    dim3 tile_lo,
+    dim3 tile_hi)
+{
+    namespace subr_v0 = parsz::cpu::__device::v0;
+
+    // the range of tiles to reconstruct (all by default), clipped to the field
+    int64_t tx0 = tile_lo.x, tx1 = std::min<int64_t>((len3.x - 1) / BLOCK + 1, tile_hi.x);
+    int64_t ty0 = tile_lo.y, ty1 = std::min<int64_t>((len3.y - 1) / BLOCK + 1, tile_hi.y);
+    int64_t ntile_x = std::max<int64_t>(tx1 - tx0, 0);
+    int64_t ntile_y = std::max<int64_t>(ty1 - ty0, 0);
+
+#pragma omp parallel for schedule(static)
+    for (int64_t b = 0; b < ntile_x * ntile_y; b++) {
+        size_t gix_base = (tx0 + b % ntile_x) * BLOCK;
+        size_t giy_base = (ty0 + b / ntile_x) * BLOCK;
+
+        T s[BLOCK][BLOCK] = {{0}};
+
+        for (auto y = 0; y < BLOCK; y++)
+            for (auto x = 0; x < BLOCK; x++) {
+                auto gix = gix_base + x, giy = giy_base + y;
+                if (gix < len3.x and giy < len3.y)
+                    s[y][x] = subr_v0::load_fuse<T, EQ>(quant, outlier, radius, giy * stride3.y + gix);
+            }
+
+        // partial-sum along x- and then y-axis
+        for (auto y = 0; y < BLOCK; y++)
+            for (auto x = 1; x < BLOCK; x++) s[y][x] += s[y][x - 1];
+        for (auto y = 1; y < BLOCK; y++)
+            for (auto x = 0; x < BLOCK; x++) s[y][x] += s[y - 1][x];
+
+        for (auto y = 0; y < BLOCK; y++)
+            for (auto x = 0; x < BLOCK; x++) {
+                auto gix = gix_base + x, giy = giy_base + y;
+                if (gix < len3.x and giy < len3.y) xdata[giy * stride3.y + gix] = s[y][x] * ebx2;
+            }
+    }
+}
+
+template <typename T, typename EQ, typename FP, int BLOCK>
+void parsz::cpu::__kernel::v0::x_lorenzo_3d1l(
+    EQ*  quant,
+    T*   outlier,
+    dim3 len3,
+    dim3 stride3,
+    int  radius,
+    FP   ebx2,
+    T*   xdata,
+    dim3 tile_lo,
+    dim3 tile_hi)
+{
+    namespace subr_v0 = parsz::cpu::__device::v0;
+
+    // the range of tiles to reconstruct (all by default), clipped to the field
+    int64_t tx0 = tile_lo.x, tx1 = std::min<int64_t>((len3.x - 1) / BLOCK + 1, tile_hi.x);
+    int64_t ty0 = tile_lo.y, ty1 = std::min<int64_t>((len3.y - 1) / BLOCK + 1, tile_hi.y);
+    int64_t tz0 = tile_lo.z, tz1 = std::min<int64_t>((len3.z - 1) / BLOCK + 1, tile_hi.z);
+    int64_t ntile_x = std::max<int64_t>(tx1 - tx0, 0);
+    int64_t ntile_y = std::max<int64_t>(ty1 - ty0, 0);
+    int64_t ntile_z = std::max<int64_t>(tz1 - tz0, 0);
+
+#pragma omp parallel for schedule(static)
+    for (int64_t b = 0; b < ntile_x * ntile_y * ntile_z; b++) {
+        size_t gix_base = (tx0 + b % ntile_x) * BLOCK;
+        size_t giy_base = (ty0 + (b / ntile_x) % ntile_y) * BLOCK;
+        size_t giz_base = (tz0 + b / (ntile_x * ntile_y)) * BLOCK;
+
+        T s[BLOCK][BLOCK][BLOCK] = {{{0}}};
+
+        auto in_range = [&](auto x, auto y, auto z) { return x < len3.x and y < len3.y and z < len3.z; };
+        auto gid      = [&](auto x, auto y, auto z) { return z * stride3.z + y * stride3.y + x; };
+
+        for (auto z = 0; z < BLOCK; z++)
+            for (auto y = 0; y < BLOCK; y++)
+                for (auto x = 0; x < BLOCK; x++) {
+                    auto gix = gix_base + x, giy = giy_base + y, giz = giz_base + z;
+                    if (in_range(gix, giy, giz))
+                        s[z][y][x] = subr_v0::load_fuse<T, EQ>(quant, outlier, radius, gid(gix, giy, giz));
+                }
+
+        // ND partial-sums along x-, y- and z-axis
+        for (auto z = 0; z < BLOCK; z++)
+            for (auto y = 0; y < BLOCK; y++)
+                for (auto x = 1; x < BLOCK; x++) s[z][y][x] += s[z][y][x - 1];
+        for (auto z = 0; z < BLOCK; z++)
+            for (auto y = 1; y < BLOCK; y++)
+                for (auto x = 0; x < BLOCK; x++) s[z][y][x] += s[z][y - 1][x];
+        for (auto z = 1; z < BLOCK; z++)
+            for (auto y = 0; y < BLOCK; y++)
+                for (auto x = 0; x < BLOCK; x++) s[z][y][x] += s[z - 1][y][x];
+
+        for (auto z = 0; z < BLOCK; z++)
+            for (auto y = 0; y < BLOCK; y++)
+                for (auto x = 0; x < BLOCK; x++) {
+                    auto gix = gix_base + x, giy = giy_base + y, giz = giz_base + z;
+                    if (in_range(gix, giy, giz)) xdata[gid(gix, giy, giz)] = s[z][y][x] * ebx2;
+                }
+    }
+}
+
+template <typename T, typename EQ, typename FP, int BX, int BY, int BZ>
+bool parsz::cpu::__kernel::v0::c_lorenzo_2l(
+    T*                                data,
+    dim3                              len3,
+    dim3                              stride3,
+    int                               radius,
+    FP                                ebx2_r,
+    EQ*                               quant,
+    CompactionDRAM<T>                 outlier,
+    asz::stat::histogram_cpu_private* hist)
+{
+    namespace subr_v0 = parsz::cpu::__device::v0;
+
+    int64_t ntile_x = (len3.x - 1) / BX + 1;
+    int64_t ntile_y = (len3.y - 1) / BY + 1;
+    int64_t ntile_z = (len3.z - 1) / BZ + 1;
+
+    auto const exact_limit = std::ldexp(1.0, std::numeric_limits<T>::digits) - radius;
+    bool       exact       = true;
+
+#pragma omp parallel reduction(&& : exact)
+    {
+        // too large for the stack of a worker
+        std::vector<double> tile(BX * BY * BZ);
+
+#pragma omp for schedule(static)
+        for (int64_t b = 0; b < ntile_x * ntile_y * ntile_z; b++) {
+            size_t gix_base = (b % ntile_x) * BX;
+            size_t giy_base = ((b / ntile_x) % ntile_y) * BY;
+            size_t giz_base = (b / (ntile_x * ntile_y)) * BZ;
+
+            // the in-field part of the tile
+            auto ex = std::min<size_t>(BX, len3.x - gix_base);
+            auto ey = std::min<size_t>(BY, len3.y - giy_base);
+            auto ez = std::min<size_t>(BZ, len3.z - giz_base);
+
+            std::fill(tile.begin(), tile.end(), 0);
+            for (size_t z = 0; z < ez; z++)
+                for (size_t y = 0; y < ey; y++) {
+                    auto src = data + (giz_base + z) * stride3.z + (giy_base + y) * stride3.y + gix_base;
+                    auto dst = tile.data() + (z * BY + y) * BX;
+                    for (size_t x = 0; x < ex; x++) dst[x] = std::round(src[x] * ebx2_r);  // prequant
+                }
+
+            subr_v0::difference_2l<BX, BY, BZ>(tile.data());
+
+            for (size_t z = 0; z < ez; z++)
+                for (size_t y = 0; y < ey; y++) {
+                    auto gid_base = (giz_base + z) * stride3.z + (giy_base + y) * stride3.y + gix_base;
+                    auto src      = tile.data() + (z * BY + y) * BX;
+                    for (size_t x = 0; x < ex; x++) {
+                        exact = exact and std::fabs(src[x]) < exact_limit;
+                        subr_v0::quantize_write<T, EQ>(src[x], radius, gid_base + x, quant, outlier);
+                    }
+                    if (hist) hist->count(quant + gid_base, ex);
+                }
+        }
+    }
+
+    return exact;
+}
+
+template <typename T, typename EQ, typename FP, int BX, int BY, int BZ>
+void parsz::cpu::__kernel::v0::x_lorenzo_2l(
+    EQ*  quant,
+    T*   outlier,
+    dim3 len3,
+    dim3 stride3,
+    int  radius,
+    FP   ebx2,
+    T*   xdata)
+{
+    namespace subr_v0 = parsz::cpu::__device::v0;
+
+    int64_t ntile_x = (len3.x - 1) / BX + 1;
+    int64_t ntile_y = (len3.y - 1) / BY + 1;
+    int64_t ntile_z = (len3.z - 1) / BZ + 1;
+
+#pragma omp parallel
+    {
+        std::vector<double> tile(BX * BY * BZ);
+
+#pragma omp for schedule(static)
+        for (int64_t b = 0; b < ntile_x * ntile_y * ntile_z; b++) {
+            size_t gix_base = (b % ntile_x) * BX;
+            size_t giy_base = ((b / ntile_x) % ntile_y) * BY;
+            size_t giz_base = (b / (ntile_x * ntile_y)) * BZ;
+
+            auto ex = std::min<size_t>(BX, len3.x - gix_base);
+            auto ey = std::min<size_t>(BY, len3.y - giy_base);
+            auto ez = std::min<size_t>(BZ, len3.z - giz_base);
+
+            std::fill(tile.begin(), tile.end(), 0);
+            for (size_t z = 0; z < ez; z++)
+                for (size_t y = 0; y < ey; y++) {
+                    auto gid_base = (giz_base + z) * stride3.z + (giy_base + y) * stride3.y + gix_base;
+                    auto dst      = tile.data() + (z * BY + y) * BX;
+                    for (size_t x = 0; x < ex; x++)
+                        dst[x] = subr_v0::load_fuse<T, EQ>(quant, outlier, radius, gid_base + x);
+                }
+
+            subr_v0::partial_sum_2l<BX, BY, BZ>(tile.data());
+
+            for (size_t z = 0; z < ez; z++)
+                for (size_t y = 0; y < ey; y++) {
+                    auto dst = xdata + (giz_base + z) * stride3.z + (giy_base + y) * stride3.y + gix_base;
+                    auto src = tile.data() + (z * BY + y) * BX;
+                    for (size_t x = 0; x < ex; x++) dst[x] = src[x] * ebx2;
+                }
+        }
+    }
+}
+
+#endif /* C1F4F7A5_0B3E_4C55_9C8B_5D4F3C2E6A10 */
@@ -0,0 +1,514 @@
+/**
+ * @file lorenzo_cpu_avx2.inl
+ * @author Jiannan Tian
+ * @brief AVX2 variant of the host v0 Lorenzo kernels (fp32 only), selected at runtime.
+ * @version 0.3
+ * @date 2022-12-17
+ *
+ * (C) 2022 by Indiana University, Argonne National Laboratory
+ *
+ */
+
+#ifndef E7B3A1D4_6C2F_4A58_8E91_3D0F5B7C2A64
+#define E7B3A1D4_6C2F_4A58_8E91_3D0F5B7C2A64
+
+#if defined(__x86_64__) and (defined(__GNUC__) or defined(__clang__))
+#define PARSZ_CPU_AVX2 1
+#else
+#define PARSZ_CPU_AVX2 0
+#endif
+
+#if PARSZ_CPU_AVX2
+
+#include <immintrin.h>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+#include "lorenzo_cpu.inl"
+#include "stat/stat.hh"
+
+// Same tiles, same outputs as v0: a tile row of 8 (3D) or 16 (2D) maps onto one or two
+// registers, and the 1D tile is swept 8 at a time. Prequant reproduces std::round
+// (half away from zero) exactly, so quant-codes and outliers match the scalar path.
+// Reconstruction adds in the order of v0 too, float sums being order-dependent past
+// 2^24: along x, lanes span rows (2D, 3D) or tiles (1D), transposed 8x8, rather than
+// the columns of a row. Rows crossing the field boundary are loaded masked
+// (zero-filled, the same as the out-of-tile padding) and stored partially.
+
+#define AVX2_FN __attribute__((target("avx2"))) inline
+
+namespace parsz {
+namespace cpu {
+namespace __device {
+namespace avx2 {
+
+AVX2_FN __m256 lanemask(int n)
+{
+    return _mm256_castsi256_ps(_mm256_cmpgt_epi32(_mm256_set1_epi32(n), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7)));
+}
+
+AVX2_FN __m256 load_row(float const* p, int n)
+{
+    return n >= 8 ? _mm256_loadu_ps(p) : _mm256_maskload_ps(p, _mm256_castps_si256(lanemask(n)));
+}
+
+AVX2_FN void store_row(float* p, __m256 v, int n)
+{
+    if (n >= 8)
+        _mm256_storeu_ps(p, v);
+    else
+        _mm256_maskstore_ps(p, _mm256_castps_si256(lanemask(n)), v);
+}
+
+// std::round: truncate, then step away from zero when the remainder (exact) is at least 0.5
+AVX2_FN __m256 round_half_away(__m256 x)
+{
+    auto const sign = _mm256_set1_ps(-0.0f);
+    auto       t    = _mm256_round_ps(x, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+    auto       frac = _mm256_andnot_ps(sign, _mm256_sub_ps(x, t));
+    auto       step = _mm256_or_ps(_mm256_and_ps(x, sign), _mm256_set1_ps(1.0f));
+    return _mm256_add_ps(t, _mm256_and_ps(_mm256_cmp_ps(frac, _mm256_set1_ps(0.5f), _CMP_GE_OQ), step));
+}
+
+// 8x8 transpose in place: lane j of r[i] goes to lane i of r[j]
+AVX2_FN void transpose8(__m256* r)
+{
+    auto t0 = _mm256_unpacklo_ps(r[0], r[1]), t1 = _mm256_unpackhi_ps(r[0], r[1]);
+    auto t2 = _mm256_unpacklo_ps(r[2], r[3]), t3 = _mm256_unpackhi_ps(r[2], r[3]);
+    auto t4 = _mm256_unpacklo_ps(r[4], r[5]), t5 = _mm256_unpackhi_ps(r[4], r[5]);
+    auto t6 = _mm256_unpacklo_ps(r[6], r[7]), t7 = _mm256_unpackhi_ps(r[6], r[7]);
+
+    auto u0 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0));
+    auto u1 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+    auto u2 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0));
+    auto u3 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2));
+    auto u4 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(1, 0, 1, 0));
+    auto u5 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(3, 2, 3, 2));
+    auto u6 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(1, 0, 1, 0));
+    auto u7 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(3, 2, 3, 2));
+
+    r[0] = _mm256_permute2f128_ps(u0, u4, 0x20), r[4] = _mm256_permute2f128_ps(u0, u4, 0x31);
+    r[1] = _mm256_permute2f128_ps(u1, u5, 0x20), r[5] = _mm256_permute2f128_ps(u1, u5, 0x31);
+    r[2] = _mm256_permute2f128_ps(u2, u6, 0x20), r[6] = _mm256_permute2f128_ps(u2, u6, 0x31);
+    r[3] = _mm256_permute2f128_ps(u3, u7, 0x20), r[7] = _mm256_permute2f128_ps(u3, u7, 0x31);
+}
+
+// running sum along x of 8 rows, each in a register, added left to right as the scalar kernel does; `carry`, if any,
+// holds the sums left of the rows (lane i for row i) and is updated to the last column
+AVX2_FN void scan_rows8(__m256* r, __m256* carry = nullptr)
+{
+    transpose8(r);  // r[x] is now column x
+    if (carry) r[0] = _mm256_add_ps(r[0], *carry);
+    for (auto x = 1; x < 8; x++) r[x] = _mm256_add_ps(r[x], r[x - 1]);
+    if (carry) *carry = r[7];
+    transpose8(r);
+}
+
+template <typename EQ>
+AVX2_FN void store_quant(EQ* p, __m256 candidate, __m256 quantizable, int n)
+{
+    alignas(32) int32_t tmp[8];
+    _mm256_store_si256(
+        (__m256i*)tmp, _mm256_and_si256(_mm256_cvttps_epi32(candidate), _mm256_castps_si256(quantizable)));
+    for (auto i = 0; i < std::min(n, 8); i++) p[i] = static_cast<EQ>(tmp[i]);
+}
+
+AVX2_FN void store_quant(uint32_t* p, __m256 candidate, __m256 quantizable, int n)
+{
+    auto q = _mm256_and_si256(_mm256_cvttps_epi32(candidate), _mm256_castps_si256(quantizable));
+    if (n >= 8)
+        _mm256_storeu_si256((__m256i*)p, q);
+    else
+        _mm256_maskstore_epi32((int*)p, _mm256_castps_si256(lanemask(n)), q);
+}
+
+AVX2_FN void store_quant(float* p, __m256 candidate, __m256 quantizable, int n)
+{
+    store_row(p, _mm256_and_ps(candidate, quantizable), n);
+}
+
+// quant holds the row starting at gid; the (rare) outlier lanes are appended one by one
+template <typename EQ>
+AVX2_FN void quantize_write(__m256 delta, float radius, int n, EQ* quant, CompactionDRAM<float>& outlier, size_t gid)
+{
+    auto const r           = _mm256_set1_ps(radius);
+    auto       quantizable = _mm256_cmp_ps(_mm256_andnot_ps(_mm256_set1_ps(-0.0f), delta), r, _CMP_LT_OQ);
+    auto       candidate   = _mm256_add_ps(delta, r);
+    store_quant(quant, candidate, quantizable, n);
+
+    auto lanes = ~_mm256_movemask_ps(quantizable) & ((1 << std::min(n, 8)) - 1);
+    if (lanes == 0) return;
+
+    alignas(32) float c[8];
+    _mm256_store_ps(c, candidate);
+    for (; lanes != 0; lanes &= lanes - 1) {
+        auto i = __builtin_ctz(lanes);
+        parsz::cpu::__device::v0::compact_outlier(outlier, gid + i, c[i]);
+    }
+}
+
+template <typename EQ>
+AVX2_FN __m256 load_quant(EQ const* p, int n)
+{
+    alignas(32) int32_t tmp[8] = {0};
+    for (auto i = 0; i < std::min(n, 8); i++) tmp[i] = static_cast<int32_t>(p[i]);
+    return _mm256_cvtepi32_ps(_mm256_load_si256((__m256i const*)tmp));
+}
+
+AVX2_FN __m256 load_quant(uint8_t const* p, int n)
+{
+    if (n < 8) return load_quant<uint8_t>(p, n);
+    return _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(_mm_loadl_epi64((__m128i const*)p)));
+}
+
+AVX2_FN __m256 load_quant(uint16_t const* p, int n)
+{
+    if (n < 8) return load_quant<uint16_t>(p, n);
+    return _mm256_cvtepi32_ps(_mm256_cvtepu16_epi32(_mm_loadu_si128((__m128i const*)p)));
+}
+
+AVX2_FN __m256 load_quant(uint32_t const* p, int n)
+{
+    return _mm256_cvtepi32_ps(
+        n >= 8 ? _mm256_loadu_si256((__m256i const*)p)
+               : _mm256_maskload_epi32((int const*)p, _mm256_castps_si256(lanemask(n))));
+}
+
+AVX2_FN __m256 load_quant(float const* p, int n) { return load_row(p, n); }
+
+// outlier + quant - radius; lanes past the field are zero, as the out-of-tile padding
+template <typename EQ>
+AVX2_FN __m256 load_fuse(EQ const* quant, float const* outlier, float radius, int n)
+{
+    auto v = _mm256_sub_ps(_mm256_add_ps(load_row(outlier, n), load_quant(quant, n)), _mm256_set1_ps(radius));
+    return n >= 8 ? v : _mm256_and_ps(v, lanemask(n));
+}
+
+}  // namespace avx2
+}  // namespace __device
+}  // namespace cpu
+}  // namespace parsz
+
+namespace parsz {
+namespace cpu {
+namespace __kernel {
+namespace avx2 {
+
+inline bool supported()
+{
+    static bool const avx2 = __builtin_cpu_supports("avx2");
+    return avx2;
+}
+
+template <typename EQ, int BLOCK = 256>
+__attribute__((target("avx2"))) void c_lorenzo_1d1l(
+    float*                            data,
+    dim3                              len3,
+    dim3,
+    int                               radius,
+    float                             ebx2_r,
+    EQ*                               quant,
+    CompactionDRAM<float>             outlier,
+    asz::stat::histogram_cpu_private* hist = nullptr)
+{
+    namespace subr = parsz::cpu::__device::avx2;
+
+    int64_t ntile = (len3.x - 1) / BLOCK + 1;
+
+#pragma omp parallel for schedule(static)
+    for (int64_t b = 0; b < ntile; b++) {
+        size_t const base = b * BLOCK;
+        int const    nval = std::min<int64_t>(BLOCK, len3.x - base);
+
+        alignas(32) float s[8 + BLOCK];  // s[7] is the zero left of the tile
+        _mm256_store_ps(s, _mm256_setzero_ps());
+
+        for (auto i = 0; i < nval; i += 8)
+            _mm256_store_ps(
+                s + 8 + i, subr::round_half_away(
+                               _mm256_mul_ps(subr::load_row(data + base + i, nval - i), _mm256_set1_ps(ebx2_r))));
+
+        for (auto i = 0; i < nval; i += 8) {
+            auto delta = _mm256_sub_ps(_mm256_load_ps(s + 8 + i), _mm256_loadu_ps(s + 7 + i));
+            subr::quantize_write(delta, radius, nval - i, quant + base + i, outlier, base + i);
+        }
+        if (hist) hist->count(quant + base, nval);
+    }
+}
+
+template <typename EQ, int BLOCK = 16>
+__attribute__((target("avx2"))) void c_lorenzo_2d1l(
+    float*                            data,
+    dim3                              len3,
+    dim3                              stride3,
+    int                               radius,
+    float                             ebx2_r,
+    EQ*                               quant,
+    CompactionDRAM<float>             outlier,
+    asz::stat::histogram_cpu_private* hist = nullptr)
+{
+    namespace subr = parsz::cpu::__device::avx2;
+
+    int64_t ntile_x = (len3.x - 1) / BLOCK + 1;
+    int64_t ntile_y = (len3.y - 1) / BLOCK + 1;
+
+#pragma omp parallel for schedule(static)
+    for (int64_t b = 0; b < ntile_x * ntile_y; b++) {
+        size_t gix_base = (b % ntile_x) * BLOCK;
+        size_t giy_base = (b / ntile_x) * BLOCK;
+        int    nx       = std::min<int64_t>(BLOCK, len3.x - gix_base);
+        int    ny       = std::min<int64_t>(BLOCK, len3.y - giy_base);
+
+        // row y + 1 holds tile row y from column 8; row 0 and column 7 are the zero neighbors
+        alignas(32) float s[BLOCK + 1][8 + BLOCK] = {{0}};
+
+        for (auto y = 0; y < ny; y++)
+            for (auto x = 0; x < nx; x += 8)
+                _mm256_store_ps(
+                    &s[y + 1][8 + x], subr::round_half_away(_mm256_mul_ps(
+                                          subr::load_row(data + (giy_base + y) * stride3.y + gix_base + x, nx - x),
+                                          _mm256_set1_ps(ebx2_r))));
+
+        for (auto y = 1; y < ny + 1; y++)
+            for (auto x = 0; x < nx; x += 8) {
+                auto delta = _mm256_sub_ps(
+                    _mm256_load_ps(&s[y][8 + x]),                                                        //
+                    _mm256_sub_ps(                                                                       //
+                        _mm256_add_ps(_mm256_loadu_ps(&s[y][7 + x]), _mm256_load_ps(&s[y - 1][8 + x])),  //
+                        _mm256_loadu_ps(&s[y - 1][7 + x])));
+                auto gid = (giy_base + y - 1) * stride3.y + gix_base + x;
+                subr::quantize_write(delta, radius, nx - x, quant + gid, outlier, gid);
+            }
+
+        if (hist)
+            for (auto y = 0; y < ny; y++) hist->count(quant + (giy_base + y) * stride3.y + gix_base, nx);
+    }
+}
+
+template <typename EQ, int BLOCK = 8>
+__attribute__((target("avx2"))) void c_lorenzo_3d1l(
+    float*                            data,
+    dim3                              len3,
+    dim3                              stride3,
+    int                               radius,
+    float                             ebx2_r,
+    EQ*                               quant,
+    CompactionDRAM<float>             outlier,
+    asz::stat::histogram_cpu_private* hist = nullptr)
+{
+    namespace subr = parsz::cpu::__device::avx2;
+    static_assert(BLOCK == 8, "a 3D tile row is one register");
+
+    int64_t ntile_x = (len3.x - 1) / BLOCK + 1;
+    int64_t ntile_y = (len3.y - 1) / BLOCK + 1;
+    int64_t ntile_z = (len3.z - 1) / BLOCK + 1;
+
+#pragma omp parallel for schedule(static)
+    for (int64_t b = 0; b < ntile_x * ntile_y * ntile_z; b++) {
+        size_t gix_base = (b % ntile_x) * BLOCK;
+        size_t giy_base = ((b / ntile_x) % ntile_y) * BLOCK;
+        size_t giz_base = (b / (ntile_x * ntile_y)) * BLOCK;
+        int    nx       = std::min<int64_t>(BLOCK, len3.x - gix_base);
+        int    ny       = std::min<int64_t>(BLOCK, len3.y - giy_base);
+        int    nz       = std::min<int64_t>(BLOCK, len3.z - giz_base);
+
+        alignas(32) float s[BLOCK + 1][BLOCK + 1][8 + BLOCK] = {{{0}}};
+
+        auto gid = [&](auto y, auto z) { return (giz_base + z) * stride3.z + (giy_base + y) * stride3.y + gix_base; };
+
+        for (auto z = 0; z < nz; z++)
+            for (auto y = 0; y < ny; y++)
+                _mm256_store_ps(
+                    &s[z + 1][y + 1][8],
+                    subr::round_half_away(_mm256_mul_ps(subr::load_row(data + gid(y, z), nx), _mm256_set1_ps(ebx2_r))));
+
+        for (auto z = 1; z < nz + 1; z++)
+            for (auto y = 1; y < ny + 1; y++) {
+                // the same association as the scalar kernel
+                auto pred = _mm256_loadu_ps(&s[z - 1][y - 1][7]);                   // dist=3
+                pred      = _mm256_sub_ps(pred, _mm256_loadu_ps(&s[z][y - 1][7]));  // dist=2
+                pred      = _mm256_sub_ps(pred, _mm256_loadu_ps(&s[z - 1][y][7]));  //
+                pred      = _mm256_sub_ps(pred, _mm256_load_ps(&s[z - 1][y - 1][8]));
+                pred      = _mm256_add_ps(pred, _mm256_loadu_ps(&s[z][y][7]));  // dist=1
+                pred      = _mm256_add_ps(pred, _mm256_load_ps(&s[z][y - 1][8]));
+                pred      = _mm256_add_ps(pred, _mm256_load_ps(&s[z - 1][y][8]));
+
+                auto delta = _mm256_sub_ps(_mm256_load_ps(&s[z][y][8]), pred);
+                auto _gid  = gid(y - 1, z - 1);
+                subr::quantize_write(delta, radius, nx, quant + _gid, outlier, _gid);
+            }
+
+        if (hist)
+            for (auto z = 0; z < nz; z++)
+                for (auto y = 0; y < ny; y++) hist->count(quant + gid(y, z), nx);
+    }
+}
+
+template <typename EQ, int BLOCK = 256>
+__attribute__((target("avx2"))) void x_lorenzo_1d1l(
+    EQ*    quant,
+    float* outlier,
+    dim3   len3,
+    dim3,
+    int    radius,
+    float  ebx2,
+    float* xdata,
+    dim3   tile_lo = dim3(0, 0, 0),
+    dim3   tile_hi = dim3(UINT32_MAX, UINT32_MAX, UINT32_MAX))
+{
+    namespace subr    = parsz::cpu::__device::avx2;
+    namespace subr_v0 = parsz::cpu::__device::v0;
+
+    int64_t ntile = (len3.x - 1) / BLOCK + 1;
+    int64_t t0 = tile_lo.x, t1 = std::min<int64_t>(ntile, tile_hi.x);
+    int64_t ngroup = std::max<int64_t>(t1 - t0 + 7, 0) / 8;
+
+    // a tile is one running sum: lane j sums tile b0 + j, 8 tiles at a time
+#pragma omp parallel for schedule(static)
+    for (int64_t g = 0; g < ngroup; g++) {
+        int64_t const b0 = t0 + g * 8;
+
+        if (b0 + 8 <= t1 and (size_t)(b0 + 8) * BLOCK <= len3.x) {
+            auto sum = _mm256_setzero_ps();
+            for (auto i = 0; i < BLOCK; i += 8) {
+                __m256 r[8];
+                for (auto j = 0; j < 8; j++) {
+                    auto id = (b0 + j) * BLOCK + i;
+                    r[j]    = subr::load_fuse(quant + id, outlier + id, radius, 8);
+                }
+                subr::scan_rows8(r, &sum);
+                for (auto j = 0; j < 8; j++)
+                    _mm256_storeu_ps(xdata + (b0 + j) * BLOCK + i, _mm256_mul_ps(r[j], _mm256_set1_ps(ebx2)));
+            }
+            continue;
+        }
+
+        // the last, partial group, as v0
+        for (auto b = b0; b < std::min<int64_t>(b0 + 8, t1); b++) {
+            size_t id_base = b * BLOCK;
+            float  sum     = 0;
+            for (size_t id = id_base; id < id_base + BLOCK and id < len3.x; id++) {
+                sum += subr_v0::load_fuse<float, EQ>(quant, outlier, radius, id);
+                xdata[id] = sum * ebx2;
+            }
+        }
+    }
+}
+
+template <typename EQ, int BLOCK = 16>
+__attribute__((target("avx2"))) void x_lorenzo_2d1l(
+    EQ*    quant,
+    float* outlier,
+    dim3   len3,
+    dim3   stride3,
+    int    radius,
+    float  ebx2,
+    float* xdata,
+    dim3   tile_lo = dim3(0, 0, 0),
+    dim3   tile_hi = dim3(UINT32_MAX, UINT32_MAX, UINT32_MAX))
+{
+    namespace subr = parsz::cpu::__device::avx2;
+    static_assert(BLOCK == 16, "a 2D tile row is two registers");
+
+    int64_t tx0 = tile_lo.x, tx1 = std::min<int64_t>((len3.x - 1) / BLOCK + 1, tile_hi.x);
+    int64_t ty0 = tile_lo.y, ty1 = std::min<int64_t>((len3.y - 1) / BLOCK + 1, tile_hi.y);
+    int64_t ntile_x = std::max<int64_t>(tx1 - tx0, 0);
+    int64_t ntile_y = std::max<int64_t>(ty1 - ty0, 0);
+
+#pragma omp parallel for schedule(static)
+    for (int64_t b = 0; b < ntile_x * ntile_y; b++) {
+        size_t gix_base = (tx0 + b % ntile_x) * BLOCK;
+        size_t giy_base = (ty0 + b / ntile_x) * BLOCK;
+        int    nx       = std::min<int64_t>(BLOCK, len3.x - gix_base);
+        int    ny       = std::min<int64_t>(BLOCK, len3.y - giy_base);
+
+        // rows past the field are zero, as the out-of-tile padding
+        __m256 lo[BLOCK], hi[BLOCK];  // columns 0-7 and 8-15 of each row
+        for (auto y = 0; y < BLOCK; y++) {
+            auto gid = (giy_base + y) * stride3.y + gix_base;
+            lo[y]    = y < ny ? subr::load_fuse(quant + gid, outlier + gid, radius, nx) : _mm256_setzero_ps();
+            hi[y]    = y < ny and nx > 8 ? subr::load_fuse(quant + gid + 8, outlier + gid + 8, radius, nx - 8)
+                                         : _mm256_setzero_ps();
+        }
+
+        // partial-sum along x, 8 rows at a time, and then along y
+        for (auto y = 0; y < BLOCK; y += 8) {
+            auto carry = _mm256_setzero_ps();
+            subr::scan_rows8(lo + y, &carry);
+            subr::scan_rows8(hi + y, &carry);
+        }
+        for (auto y = 1; y < ny; y++) lo[y] = _mm256_add_ps(lo[y], lo[y - 1]), hi[y] = _mm256_add_ps(hi[y], hi[y - 1]);
+
+        for (auto y = 0; y < ny; y++) {
+            auto gid = (giy_base + y) * stride3.y + gix_base;
+            subr::store_row(xdata + gid, _mm256_mul_ps(lo[y], _mm256_set1_ps(ebx2)), nx);
+            if (nx > 8) subr::store_row(xdata + gid + 8, _mm256_mul_ps(hi[y], _mm256_set1_ps(ebx2)), nx - 8);
+        }
+    }
+}
+
+template <typename EQ, int BLOCK = 8>
+__attribute__((target("avx2"))) void x_lorenzo_3d1l(
+    EQ*    quant,
+    float* outlier,
+    dim3   len3,
+    dim3   stride3,
+    int    radius,
+    float  ebx2,
+    float* xdata,
+    dim3   tile_lo = dim3(0, 0, 0),
+    dim3   tile_hi = dim3(UINT32_MAX, UINT32_MAX, UINT32_MAX))
+{
+    namespace subr = parsz::cpu::__device::avx2;
+    static_assert(BLOCK == 8, "a 3D tile row is one register");
+
+    int64_t tx0 = tile_lo.x, tx1 = std::min<int64_t>((len3.x - 1) / BLOCK + 1, tile_hi.x);
+    int64_t ty0 = tile_lo.y, ty1 = std::min<int64_t>((len3.y - 1) / BLOCK + 1, tile_hi.y);
+    int64_t tz0 = tile_lo.z, tz1 = std::min<int64_t>((len3.z - 1) / BLOCK + 1, tile_hi.z);
+    int64_t ntile_x = std::max<int64_t>(tx1 - tx0, 0);
+    int64_t ntile_y = std::max<int64_t>(ty1 - ty0, 0);
+    int64_t ntile_z = std::max<int64_t>(tz1 - tz0, 0);
+
+#pragma omp parallel for schedule(static)
+    for (int64_t b = 0; b < ntile_x * ntile_y * ntile_z; b++) {
+        size_t gix_base = (tx0 + b % ntile_x) * BLOCK;
+        size_t giy_base = (ty0 + (b / ntile_x) % ntile_y) * BLOCK;
+        size_t giz_base = (tz0 + b / (ntile_x * ntile_y)) * BLOCK;
+        int    nx       = std::min<int64_t>(BLOCK, len3.x - gix_base);
+        int    ny       = std::min<int64_t>(BLOCK, len3.y - giy_base);
+        int    nz       = std::min<int64_t>(BLOCK, len3.z - giz_base);
+
+        auto gid = [&](auto y, auto z) { return (giz_base + z) * stride3.z + (giy_base + y) * stride3.y + gix_base; };
+
+        // plane[y] carries the partial sums of the previous z-plane; each row is x-summed, then y- and z-summed
+        __m256 plane[BLOCK];
+        for (auto y = 0; y < BLOCK; y++) plane[y] = _mm256_setzero_ps();
+
+        for (auto z = 0; z < nz; z++) {
+            __m256 r[BLOCK];
+            for (auto y = 0; y < BLOCK; y++) {
+                auto _gid = gid(y, z);
+                r[y]      = y < ny ? subr::load_fuse(quant + _gid, outlier + _gid, radius, nx) : _mm256_setzero_ps();
+            }
+            subr::scan_rows8(r);
+
+            for (auto y = 0; y < ny; y++) {
+                if (y > 0) r[y] = _mm256_add_ps(r[y], r[y - 1]);
+                plane[y] = _mm256_add_ps(plane[y], r[y]);
+                subr::store_row(xdata + gid(y, z), _mm256_mul_ps(plane[y], _mm256_set1_ps(ebx2)), nx);
+            }
+        }
+    }
+}
+
+}  // namespace avx2
+}  // namespace __kernel
+}  // namespace cpu
+}  // namespace parsz
+
+#undef AVX2_FN
+
+#endif /* PARSZ_CPU_AVX2 */
+
+#endif /* E7B3A1D4_6C2F_4A58_8E91_3D0F5B7C2A64 */
@@ -0,0 +1,313 @@
+/**
+ * @file regression_cpu.inl
+ * @author Jiannan Tian
+ * @brief Host (OpenMP) blockwise Lorenzo/regression pred-quant kernels, for 1D, 2D and 3D alike.
+ * @version 0.3
+ * @date 2022-12-28
+ *
+ * (C) 2022 by Indiana University, Argonne National Laboratory
+ *
+ */
+
+#ifndef B6D03E7A_95C2_4F18_8B4E_7A1C2D9E5F30
+#define B6D03E7A_95C2_4F18_8B4E_7A1C2D9E5F30
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+#include "lorenzo_cpu.inl"
+#include "stat/stat.hh"
+#include "typing.inl"
+
+// Blocks of BX x BY x BZ are grouped NB per dimension (of more than one block) into tiles, which are independent
+// (out-of-tile neighbors are 0), hence parallel over tiles. Lorenzo blocks predict from their neighbors in the tile
+// whichever way those are predicted, so decompression goes over a tile in raster order; compression works on the
+// prequantized input, which decompression reproduces exactly, so all its points are independent.
+//
+// Lorenzo of a row is q(x - 1) + w(x) - w(x - 1), where w = up + back - upback of the rows before it (y - 1, z - 1
+// and both), a row off the tile being zeros; so only the dependency along x is left to go point by point.
+//
+// A hyperplane is evaluated in double from coefficients that are multiples of 1/256; with block-local coordinates
+// that is exact, so both directions round it alike however the arithmetic is contracted.
+
+namespace parsz {
+namespace cpu {
+namespace __device {
+namespace v0 {
+
+template <typename T>
+inline double hyperplane(T const* c, int const x, int const y, int const z)
+{
+    return (double)c[0] + (double)c[1] * x + (double)c[2] * y + (double)c[3] * z;
+}
+
+// by least squares, over the block of extent (fx, fy, fz) at (bx, by, bz) of the tile
+template <typename T, int TX, int TY, int TZ>
+inline void fit_hyperplane(double const* s, int bx, int by, int bz, int fx, int fy, int fz, T* c)
+{
+    double sum = 0, sum_x = 0, sum_y = 0, sum_z = 0;
+    for (auto z = 0; z < fz; z++)
+        for (auto y = 0; y < fy; y++) {
+            auto row = s + ((bz + z) * TY + by + y) * TX + bx;
+            for (auto x = 0; x < fx; x++) {
+                sum += row[x], sum_x += x * row[x], sum_y += y * row[x], sum_z += z * row[x];
+            }
+        }
+
+    double const n = fx * fy * fz, mx = (fx - 1) / 2.0, my = (fy - 1) / 2.0, mz = (fz - 1) / 2.0;
+
+    auto slope = [&](double sum_l, double m, int f) {
+        return f > 1 ? (sum_l - m * sum) / (n * (f * f - 1) / 12) : 0.0;  // sum of (l - m)^2 over the block
+    };
+    // in quant-steps, as multiples of 1/256
+    auto coeff = [](double v) -> T { return std::round(v * 256) / 256; };
+
+    c[1] = coeff(slope(sum_x, mx, fx));
+    c[2] = coeff(slope(sum_y, my, fy));
+    c[3] = coeff(slope(sum_z, mz, fz));
+    c[0] = coeff(sum / n - c[1] * mx - c[2] * my - c[3] * mz);
+}
+
+// whether c errs less than Lorenzo (of residuals lz) on every other point (in each dimension) of the block
+template <typename T, int TX, int TY, int TZ>
+inline bool
+hyperplane_wins(double const* s, double const* lz, int bx, int by, int bz, int fx, int fy, int fz, T const* c)
+{
+    double err_hyperplane = 0, err_lorenzo = 0;
+
+    for (int z = fz > 1; z < fz; z += 2)
+        for (int y = fy > 1; y < fy; y += 2)
+            for (int x = fx > 1; x < fx; x += 2) {
+                auto const id = ((bz + z) * TY + by + y) * TX + bx + x;
+                err_hyperplane += std::fabs(s[id] - std::round(hyperplane(c, x, y, z)));
+                err_lorenzo += std::fabs(lz[id]);
+            }
+
+    return err_hyperplane < err_lorenzo;
+}
+
+// w of row (y, z) of the tile, of n points
+template <int TX, int TY, int TZ>
+inline void lorenzo_carry(double const* s, double const* zeros, int const y, int const z, int const n, double* w)
+{
+    auto row = [&](int y, int z) { return y < 0 or z < 0 ? zeros : s + (z * TY + y) * TX; };
+
+    auto up = row(y - 1, z), back = row(y, z - 1), upback = row(y - 1, z - 1);
+    for (auto x = 0; x < n; x++) w[x] = up[x] + back[x] - upback[x];
+}
+
+}  // namespace v0
+}  // namespace __device
+}  // namespace cpu
+}  // namespace parsz
+
+namespace parsz {
+namespace cpu {
+namespace __kernel {
+namespace v0 {
+
+// anchor is of regression_anchor_len(); returns false if some residual (as an outlier) is not exact in T
+template <typename T, typename EQ, typename FP, int BX, int BY, int BZ, int NB>
+bool c_lorenzo_regression(
+    T*                                data,
+    dim3                              len3,
+    dim3                              stride3,
+    int                               radius,
+    FP                                ebx2_r,
+    EQ*                               quant,
+    CompactionDRAM<T>                 outlier,
+    T*                                anchor,
+    asz::stat::histogram_cpu_private* hist = nullptr);
+
+template <typename T, typename EQ, typename FP, int BX, int BY, int BZ, int NB>
+void x_lorenzo_regression(EQ* quant, T* outlier, T* anchor, dim3 len3, dim3 stride3, int radius, FP ebx2, T* xdata);
+
+}  // namespace v0
+}  // namespace __kernel
+}  // namespace cpu
+}  // namespace parsz
+
+template <typename T, typename EQ, typename FP, int BX, int BY, int BZ, int NB>
+bool parsz::cpu::__kernel::v0::c_lorenzo_regression(
+    T*                                data,
+    dim3                              len3,
+    dim3                              stride3,
+    int                               radius,
+    FP                                ebx2_r,
+    EQ*                               quant,
+    CompactionDRAM<T>                 outlier,
+    T*                                anchor,
+    asz::stat::histogram_cpu_private* hist)
+{
+    namespace subr_v0 = parsz::cpu::__device::v0;
+
+    constexpr int TX = BX * NB, TY = BY > 1 ? BY * NB : 1, TZ = BZ > 1 ? BZ * NB : 1;
+
+    auto const nblock3 = dim3((len3.x - 1) / BX + 1, (len3.y - 1) / BY + 1, (len3.z - 1) / BZ + 1);
+    auto const nblock  = (size_t)nblock3.x * nblock3.y * nblock3.z;
+
+    int64_t ntile_x = (len3.x - 1) / TX + 1;
+    int64_t ntile_y = (len3.y - 1) / TY + 1;
+    int64_t ntile_z = (len3.z - 1) / TZ + 1;
+
+    auto const exact_limit = std::ldexp(1.0, std::numeric_limits<T>::digits) - radius;
+    bool       exact       = true;
+
+    // a byte per block first, as neighboring tiles may share a byte of the bitmap
+    std::vector<uint8_t> selected(nblock);
+
+#pragma omp parallel reduction(&& : exact)
+    {
+        // prequantized values, and their Lorenzo residuals; only the in-field part of a tile is ever read
+        std::vector<double> tile(TX * TY * TZ), lz(TX * TY * TZ), zeros(TX), w(TX);
+
+#pragma omp for schedule(static)
+        for (int64_t b = 0; b < ntile_x * ntile_y * ntile_z; b++) {
+            size_t gix_base = (b % ntile_x) * TX;
+            size_t giy_base = ((b / ntile_x) % ntile_y) * TY;
+            size_t giz_base = (b / (ntile_x * ntile_y)) * TZ;
+
+            int ex = std::min<size_t>(TX, len3.x - gix_base);
+            int ey = std::min<size_t>(TY, len3.y - giy_base);
+            int ez = std::min<size_t>(TZ, len3.z - giz_base);
+
+            auto bid_of = [&](int x, int y, int z) {
+                return ((giz_base + z) / BZ * nblock3.y + (giy_base + y) / BY) * nblock3.x + (gix_base + x) / BX;
+            };
+
+            for (auto z = 0; z < ez; z++)
+                for (auto y = 0; y < ey; y++) {
+                    auto src = data + (giz_base + z) * stride3.z + (giy_base + y) * stride3.y + gix_base;
+                    auto dst = tile.data() + (z * TY + y) * TX;
+                    for (auto x = 0; x < ex; x++) dst[x] = std::round(src[x] * ebx2_r);  // prequant
+                }
+
+            for (auto z = 0; z < ez; z++)
+                for (auto y = 0; y < ey; y++) {
+                    auto q = tile.data() + (z * TY + y) * TX;
+                    auto r = lz.data() + (z * TY + y) * TX;
+
+                    subr_v0::lorenzo_carry<TX, TY, TZ>(tile.data(), zeros.data(), y, z, ex, w.data());
+                    r[0] = q[0] - w[0];
+                    for (auto x = 1; x < ex; x++) r[x] = q[x] - q[x - 1] - w[x] + w[x - 1];
+                }
+
+            for (auto bz = 0; bz < ez; bz += BZ)
+                for (auto by = 0; by < ey; by += BY)
+                    for (auto bx = 0; bx < ex; bx += BX) {
+                        int const fx = std::min(BX, ex - bx), fy = std::min(BY, ey - by), fz = std::min(BZ, ez - bz);
+
+                        auto const bid = bid_of(bx, by, bz);
+                        auto const c   = anchor + 4 * bid;
+
+                        subr_v0::fit_hyperplane<T, TX, TY, TZ>(tile.data(), bx, by, bz, fx, fy, fz, c);
+                        selected[bid] =
+                            subr_v0::hyperplane_wins<T, TX, TY, TZ>(tile.data(), lz.data(), bx, by, bz, fx, fy, fz, c);
+                        if (not selected[bid]) {
+                            std::fill(c, c + 4, 0);
+                            continue;
+                        }
+
+                        // the residuals of the block are against the hyperplane instead
+                        for (auto z = 0; z < fz; z++)
+                            for (auto y = 0; y < fy; y++) {
+                                auto const id = ((bz + z) * TY + by + y) * TX + bx;
+                                for (auto x = 0; x < fx; x++)
+                                    lz[id + x] = tile[id + x] - std::round(subr_v0::hyperplane(c, x, y, z));
+                            }
+                    }
+
+            for (auto z = 0; z < ez; z++)
+                for (auto y = 0; y < ey; y++) {
+                    auto const gid_base = (giz_base + z) * stride3.z + (giy_base + y) * stride3.y + gix_base;
+                    auto const r        = lz.data() + (z * TY + y) * TX;
+
+                    for (auto x = 0; x < ex; x++) {
+                        exact = exact and std::fabs(r[x]) < exact_limit;
+                        subr_v0::quantize_write<T, EQ>(r[x], radius, gid_base + x, quant, outlier);
+                    }
+                    if (hist) hist->count(quant + gid_base, ex);
+                }
+        }
+    }
+
+    auto bitmap = reinterpret_cast<uint8_t*>(anchor + 4 * nblock);
+    std::memset(bitmap, 0, ((nblock - 1) / 32 + 1) * sizeof(T));
+    for (size_t bid = 0; bid < nblock; bid++)
+        if (selected[bid]) bitmap[bid / 8] |= 1u << (bid % 8);
+
+    return exact;
+}
+
+template <typename T, typename EQ, typename FP, int BX, int BY, int BZ, int NB>
+void parsz::cpu::__kernel::v0::x_lorenzo_regression(
+    EQ*  quant,
+    T*   outlier,
+    T*   anchor,
+    dim3 len3,
+    dim3 stride3,
+    int  radius,
+    FP   ebx2,
+    T*   xdata)
+{
+    namespace subr_v0 = parsz::cpu::__device::v0;
+
+    constexpr int TX = BX * NB, TY = BY > 1 ? BY * NB : 1, TZ = BZ > 1 ? BZ * NB : 1;
+
+    auto const nblock3 = dim3((len3.x - 1) / BX + 1, (len3.y - 1) / BY + 1, (len3.z - 1) / BZ + 1);
+    auto const nblock  = (size_t)nblock3.x * nblock3.y * nblock3.z;
+    auto const bitmap  = reinterpret_cast<uint8_t const*>(anchor + 4 * nblock);
+
+    int64_t ntile_x = (len3.x - 1) / TX + 1;
+    int64_t ntile_y = (len3.y - 1) / TY + 1;
+    int64_t ntile_z = (len3.z - 1) / TZ + 1;
+
+#pragma omp parallel
+    {
+        std::vector<double> tile(TX * TY * TZ), zeros(TX), w(TX);
+
+#pragma omp for schedule(static)
+        for (int64_t b = 0; b < ntile_x * ntile_y * ntile_z; b++) {
+            size_t gix_base = (b % ntile_x) * TX;
+            size_t giy_base = ((b / ntile_x) % ntile_y) * TY;
+            size_t giz_base = (b / (ntile_x * ntile_y)) * TZ;
+
+            int ex = std::min<size_t>(TX, len3.x - gix_base);
+            int ey = std::min<size_t>(TY, len3.y - giy_base);
+            int ez = std::min<size_t>(TZ, len3.z - giz_base);
+
+            for (auto z = 0; z < ez; z++)
+                for (auto y = 0; y < ey; y++) {
+                    auto const gid_base = (giz_base + z) * stride3.z + (giy_base + y) * stride3.y + gix_base;
+                    auto const bid_base =
+                        ((giz_base + z) / BZ * nblock3.y + (giy_base + y) / BY) * nblock3.x + gix_base / BX;
+                    auto q = tile.data() + (z * TY + y) * TX;
+
+                    subr_v0::lorenzo_carry<TX, TY, TZ>(tile.data(), zeros.data(), y, z, ex, w.data());
+
+                    for (auto x = 0; x < ex; x++) {
+                        auto const bid = bid_base + x / BX;
+                        auto const c   = anchor + 4 * bid;
+
+                        double pred;
+                        if ((bitmap[bid / 8] >> (bid % 8)) & 1)
+                            pred = std::round(subr_v0::hyperplane(c, x % BX, y % BY, z % BZ));
+                        else
+                            pred = x == 0 ? w[0] : q[x - 1] + w[x] - w[x - 1];
+
+                        q[x] = pred + subr_v0::load_fuse<T, EQ>(quant, outlier, radius, gid_base + x);
+                    }
+
+                    auto dst = xdata + gid_base;
+                    for (auto x = 0; x < ex; x++) dst[x] = q[x] * ebx2;
+                }
+        }
+    }
+}
+
+#endif /* B6D03E7A_95C2_4F18_8B4E_7A1C2D9E5F30 */
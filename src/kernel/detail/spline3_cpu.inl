@@ -0,0 +1,229 @@
+/**
+ * @file spline3_cpu.inl
+ * @author Jiannan Tian
+ * @brief Host (OpenMP) Spline3 pred-quant kernels, for 1D, 2D and 3D alike.
+ * @version 0.3
+ * @date 2022-12-26
+ *
+ * (C) 2022 by Indiana University, Argonne National Laboratory
+ *
+ */
+
+#ifndef A8E25C3F_1D64_4B0A_9E7C_2F5B8D1A3C96
+#define A8E25C3F_1D64_4B0A_9E7C_2F5B8D1A3C96
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+#include "lorenzo_cpu.inl"
+#include "stat/stat.hh"
+#include "typing.inl"
+
+// Anchors sit every anchor_stride (a power of 2) points in each dimension. A point off the anchor grid belongs to the
+// level of stride s, the largest power of 2 below anchor_stride dividing all its coordinates. Within a level, the
+// points odd in z (s-wise) are interpolated along z first, then those odd in y along y, then those odd in x along x;
+// each from the (already reconstructed) points at -3s, -s, +s and +3s along its dimension. A dimension of length 1
+// never has an odd coordinate, so lower dimensionalities need no code of their own.
+//
+// Compression predicts from the prequantized input, which decompression reproduces exactly, so all points are
+// independent there. Decompression goes level by level and dimension by dimension, each pass in parallel. Rows are
+// split into chunks of `spline3_chunk` points, so that a 1D field is worked on in parallel all the same.
+
+namespace parsz {
+namespace cpu {
+namespace __device {
+namespace v0 {
+
+constexpr int64_t spline3_chunk = 4096;
+
+// at coordinate c of a dimension of length n, from at[-3 * stride], at[-stride], at[stride] and at[3 * stride] (as
+// far as in range), where stride is s along the dimension; in double, so that the arithmetic on integral
+// (prequantized) values is exact and both directions agree
+template <typename T>
+inline double
+spline3_interpolate(T const* at, int64_t const stride, int64_t const c, int64_t const s, int64_t const n)
+{
+    double const b = at[-stride];
+    if (c + s >= n) return b;
+
+    double const c_   = at[stride];
+    bool const   a_in = c - 3 * s >= 0, d_in = c + 3 * s < n;
+
+    if (a_in and d_in) return (-at[-3 * stride] + 9 * b + 9 * c_ - at[3 * stride]) / 16;
+    if (d_in) return (3 * b + 6 * c_ - at[3 * stride]) / 8;
+    if (a_in) return (-at[-3 * stride] + 6 * b + 3 * c_) / 8;
+    return (b + c_) / 2;
+}
+
+}  // namespace v0
+}  // namespace __device
+}  // namespace cpu
+}  // namespace parsz
+
+namespace parsz {
+namespace cpu {
+namespace __kernel {
+namespace v0 {
+
+template <typename T, typename EQ, typename FP>
+void c_spline3(
+    T*                                data,
+    dim3                              len3,
+    dim3                              leap3,
+    T*                                anchor,
+    dim3                              anchor_len3,
+    int                               anchor_stride,
+    int                               radius,
+    FP                                ebx2_r,
+    EQ*                               quant,
+    CompactionDRAM<T>                 outlier,
+    asz::stat::histogram_cpu_private* hist);
+
+template <typename T, typename EQ, typename FP>
+void x_spline3(
+    EQ*  quant,
+    T*   anchor,
+    dim3 anchor_len3,
+    int  anchor_stride,
+    dim3 len3,
+    dim3 leap3,
+    int  radius,
+    FP   ebx2,
+    T*   xdata);
+
+}  // namespace v0
+}  // namespace __kernel
+}  // namespace cpu
+}  // namespace parsz
+
+template <typename T, typename EQ, typename FP>
+void parsz::cpu::__kernel::v0::c_spline3(
+    T*                                data,
+    dim3                              len3,
+    dim3                              leap3,
+    T*                                anchor,
+    dim3                              anchor_len3,
+    int                               anchor_stride,
+    int                               radius,
+    FP                                ebx2_r,
+    EQ*                               quant,
+    CompactionDRAM<T>                 outlier,
+    asz::stat::histogram_cpu_private* hist)
+{
+    namespace subr_v0 = parsz::cpu::__device::v0;
+
+    int64_t const nx = len3.x, ny = len3.y, nz = len3.z;
+    int64_t const nchunk = (nx - 1) / subr_v0::spline3_chunk + 1;
+
+    auto prequant = [&](int64_t gid) -> T { return round(data[gid] * ebx2_r); };
+
+#pragma omp parallel for schedule(static)
+    for (int64_t r = 0; r < nz * ny * nchunk; r++) {
+        int64_t const z = r / (ny * nchunk), y = (r / nchunk) % ny;
+        int64_t const x_beg = (r % nchunk) * subr_v0::spline3_chunk;
+        int64_t const x_end = std::min(nx, x_beg + subr_v0::spline3_chunk);
+
+        auto const row_base = z * leap3.z + y * leap3.y;
+
+        for (int64_t x = x_beg; x < x_end; x++) {
+            auto const gid = row_base + x;
+            auto const v   = x | y | z;
+            auto const q   = prequant(gid);
+
+            if (v % anchor_stride == 0) {
+                auto const az = z / anchor_stride, ay = y / anchor_stride, ax = x / anchor_stride;
+                anchor[az * anchor_len3.x * anchor_len3.y + ay * anchor_len3.x + ax] = q;
+                quant[gid] = radius;
+                continue;
+            }
+
+            int64_t const s = v & -v;
+            int64_t       c, n, leap;
+            if (x & s)
+                c = x, n = nx, leap = 1;
+            else if (y & s)
+                c = y, n = ny, leap = leap3.y;
+            else
+                c = z, n = nz, leap = leap3.z;
+
+            // the neighbors along the dimension (as far as in range) at -3s, -s, s, 3s, as line[0], [2], [4], [6]
+            T line[7];
+            for (auto i = -3; i <= 3; i += 2) {
+                auto const at = c + i * s;
+                line[3 + i]   = at >= 0 and at < n ? prequant(gid + i * s * leap) : 0;
+            }
+            auto const pred = (T)std::round(subr_v0::spline3_interpolate(line + 3, 1, c, s, n));
+
+            subr_v0::quantize_write<T, EQ>(q - pred, radius, gid, quant, outlier);
+        }
+
+        if (hist) hist->count(quant + row_base + x_beg, x_end - x_beg);
+    }
+}
+
+template <typename T, typename EQ, typename FP>
+void parsz::cpu::__kernel::v0::x_spline3(
+    EQ*  quant,
+    T*   anchor,
+    dim3 anchor_len3,
+    int  anchor_stride,
+    dim3 len3,
+    dim3 leap3,
+    int  radius,
+    FP   ebx2,
+    T*   xdata)
+{
+    namespace subr_v0 = parsz::cpu::__device::v0;
+
+    int64_t const len[3]  = {len3.x, len3.y, len3.z};
+    int64_t const leap[3] = {1, leap3.y, leap3.z};
+
+    int64_t const nanchor = (int64_t)anchor_len3.x * anchor_len3.y * anchor_len3.z;
+
+#pragma omp parallel for schedule(static)
+    for (int64_t i = 0; i < nanchor; i++) {
+        int64_t const ax = i % anchor_len3.x, ay = (i / anchor_len3.x) % anchor_len3.y;
+        int64_t const az = i / ((int64_t)anchor_len3.x * anchor_len3.y);
+        xdata[anchor_stride * (az * leap[2] + ay * leap[1] + ax)] = anchor[i];
+    }
+
+    // along dimension k, of the points odd (s-wise) in k; the dimensions passed before k are multiples of s, the
+    // ones to pass after it multiples of 2s
+    auto pass = [&](int const k, int64_t const s) {
+        int64_t beg[3], step[3], n[3];
+        for (auto d = 0; d < 3; d++) {
+            beg[d]  = d == k ? s : 0;
+            step[d] = d > k ? s : 2 * s;
+            n[d]    = beg[d] < len[d] ? (len[d] - beg[d] - 1) / step[d] + 1 : 0;
+        }
+        int64_t const nchunk = (n[0] - 1) / subr_v0::spline3_chunk + 1;
+
+#pragma omp parallel for schedule(static)
+        for (int64_t r = 0; r < n[2] * n[1] * nchunk; r++) {
+            int64_t const z = beg[2] + r / (n[1] * nchunk) * step[2], y = beg[1] + (r / nchunk) % n[1] * step[1];
+            int64_t const i_beg = (r % nchunk) * subr_v0::spline3_chunk;
+            int64_t const i_end = std::min(n[0], i_beg + subr_v0::spline3_chunk);
+
+            for (int64_t i = i_beg; i < i_end; i++) {
+                auto const x   = beg[0] + i * step[0];
+                auto const gid = z * leap[2] + y * leap[1] + x;
+                auto const c   = k == 0 ? x : (k == 1 ? y : z);
+                auto const pred =
+                    (T)std::round(subr_v0::spline3_interpolate(xdata + gid, s * leap[k], c, s, len[k]));
+
+                xdata[gid] = pred + subr_v0::load_fuse<T, EQ>(quant, xdata, radius, gid);
+            }
+        }
+    };
+
+    for (int64_t s = anchor_stride / 2; s >= 1; s /= 2)
+        for (auto k = 2; k >= 0; k--) pass(k, s);
+
+    auto const n = len[0] * len[1] * len[2];
+#pragma omp parallel for simd schedule(static)
+    for (int64_t i = 0; i < n; i++) xdata[i] *= ebx2;
+}
+
+#endif /* A8E25C3F_1D64_4B0A_9E7C_2F5B8D1A3C96 */
@@ -539,9 +539,11 @@ __forceinline__ __device__ void parsz::cuda::__device::v0::compaction::predict_q
         if (not quantizable) {
             auto g_idx = inblock_idx + g_idx_base;
             if (g_idx < dimx) {
-                auto cur_idx         = atomicAdd(outlier.count, 1);
-                outlier.val[cur_idx] = candidate;
-                outlier.idx[cur_idx] = g_idx;
+                auto cur_idx = atomicAdd(outlier.count, 1);
+                if (cur_idx < outlier.capacity) {
+                    outlier.val[cur_idx] = candidate;
+                    outlier.idx[cur_idx] = g_idx;
+                }
             }
         }
     };
@@ -585,9 +587,11 @@ __forceinline__ __device__ void parsz::cuda::__device::v1_pn::compaction::predic
         if (not quantizable) {
             auto g_idx = inblock_idx + g_idx_base;
             if (g_idx < dimx) {
-                auto cur_idx         = atomicAdd(outlier.count, 1);
-                outlier.val[cur_idx] = delta;
-                outlier.idx[cur_idx] = g_idx;
+                auto cur_idx = atomicAdd(outlier.count, 1);
+                if (cur_idx < outlier.capacity) {
+                    outlier.val[cur_idx] = delta;
+                    outlier.idx[cur_idx] = g_idx;
+                }
             }
         }
     };
@@ -845,9 +849,11 @@ __forceinline__ __device__ void parsz::cuda::__device::v0::compaction::quantize_
             quant[gid] = quantizable * static_cast<EQ>(candidate);
 
             if (not quantizable) {
-                auto cur_idx         = atomicAdd(outlier.count, 1);
-                outlier.idx[cur_idx] = gid;
-                outlier.val[cur_idx] = candidate;
+                auto cur_idx = atomicAdd(outlier.count, 1);
+                if (cur_idx < outlier.capacity) {
+                    outlier.idx[cur_idx] = gid;
+                    outlier.val[cur_idx] = candidate;
+                }
             }
         }
     }
@@ -884,9 +890,11 @@ __forceinline__ __device__ void parsz::cuda::__device::v1_pn::compaction::quanti
             quant[gid] = quantizable * UI_delta;
 
             if (not quantizable) {
-                auto cur_idx         = atomicAdd(outlier.count, 1);
-                outlier.idx[cur_idx] = gid;
-                outlier.val[cur_idx] = delta[i];
+                auto cur_idx = atomicAdd(outlier.count, 1);
+                if (cur_idx < outlier.capacity) {
+                    outlier.idx[cur_idx] = gid;
+                    outlier.val[cur_idx] = delta[i];
+                }
             }
         }
     }
@@ -9,39 +9,52 @@
  *
  */
 
-// TODO -> `compaction`
+#ifndef A6D2E9F1_3B7C_4E05_9A84_C1F6B2D7E398
+#define A6D2E9F1_3B7C_4E05_9A84_C1F6B2D7E398
+
+#include "cusz/cuda_compat.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+// Outliers appended as (idx, val) pairs. `count` keeps counting past `capacity`, but
+// only the first `capacity` pairs are written, so that an overflow is detectable.
 template <typename T>
 struct CompactionDRAM {
     using type = T;
     T*        val;
     uint32_t* idx;
     uint32_t* count;
+    uint32_t  capacity;
 
+#ifndef CUSZ_HOST_ONLY
     void allocate(size_t len, bool device = true)
     {
+        capacity = len;
         if (device) {
             cudaMalloc(&idx, sizeof(uint32_t) * len);
             cudaMalloc(&val, sizeof(T) * len);
-            cudaMalloc(&count, sizeof(T) * 1);
+            cudaMalloc(&count, sizeof(uint32_t));
 
-            cudaMemset(count, 0x0, sizeof(T) * 1);
+            cudaMemset(count, 0x0, sizeof(uint32_t));
         }
         else {
             cudaMallocHost(&idx, sizeof(uint32_t) * len);
             cudaMallocHost(&val, sizeof(T) * len);
-            cudaMallocHost(&count, sizeof(T) * 1);
+            cudaMallocHost(&count, sizeof(uint32_t));
 
-            memset(count, 0x0, sizeof(T) * 1);
+            memset(count, 0x0, sizeof(uint32_t));
         }
     }
 
     void allocate_managed(size_t len)
     {
+        capacity = len;
         cudaMallocManaged(&idx, sizeof(uint32_t) * len);
         cudaMallocManaged(&val, sizeof(T) * len);
-        cudaMallocManaged(&count, sizeof(T) * 1);
+        cudaMallocManaged(&count, sizeof(uint32_t));
 
-        cudaMemset(count, 0x0, sizeof(T) * 1);
+        cudaMemset(count, 0x0, sizeof(uint32_t));
     }
 
     void destroy()
@@ -50,4 +63,7 @@ struct CompactionDRAM {
         cudaFree(val);
         cudaFree(count);
     }
+#endif
 };
+
+#endif /* A6D2E9F1_3B7C_4E05_9A84_C1F6B2D7E398 */
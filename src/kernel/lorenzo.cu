@@ -21,19 +21,20 @@
 
 template <typename T, typename E, typename FP>
 cusz_error_status compress_predict_lorenzo_i(
-    T* const     data,
-    dim3 const   len3,
-    double const eb,
-    int const    radius,
-    E* const     errctrl,
-    dim3 const   placeholder_2,
-    T* const     anchor,
-    dim3 const   placeholder_1,
-    T* const     outlier,
-    uint32_t*    outlier_idx,
-    uint32_t*    num_outliers,
-    float*       time_elapsed,
-    cudaStream_t stream)
+    T* const       data,
+    dim3 const     len3,
+    double const   eb,
+    int const      radius,
+    E* const       errctrl,
+    dim3 const     placeholder_2,
+    T* const       anchor,
+    dim3 const     placeholder_1,
+    T* const       outlier,
+    uint32_t*      outlier_idx,
+    uint32_t*      num_outliers,
+    uint32_t const max_outliers,
+    float*         time_elapsed,
+    cudaStream_t   stream)
 {
     auto divide3 = [](dim3 len, dim3 sublen) {
         return dim3(
@@ -74,6 +75,12 @@ cusz_error_status compress_predict_lorenzo_i(
     auto ebx2_r = 1 / ebx2;
     auto leap3  = dim3(1, len3.x, len3.x * len3.y);
 
+    // given outlier_idx and num_outliers, outliers are appended to (outlier_idx, outlier) in no particular order
+    auto const compact = outlier_idx != nullptr and num_outliers != nullptr;
+    auto       sink    = CompactionDRAM<T>{outlier, outlier_idx, num_outliers, max_outliers};
+
+    if (compact) CHECK_CUDA(cudaMemsetAsync(num_outliers, 0x0, sizeof(uint32_t), stream));
+
     CREATE_CUDAEVENT_PAIR;
     START_CUDAEVENT_RECORDING(stream);
 
@@ -81,20 +88,32 @@ cusz_error_status compress_predict_lorenzo_i(
         //::cusz::c_lorenzo_1d1l<T, E, FP, SUBLEN_1D, SEQ_1D>
         //<<<GRID_1D, BLOCK_1D, 0, stream>>>(data, errctrl, outlier, len3, leap3, radius, ebx2_r);
 
-        parsz::cuda::__kernel::v0::c_lorenzo_1d1l<T, E, FP, SUBLEN_1D, SEQ_1D>
-            <<<GRID_1D, BLOCK_1D, 0, stream>>>(data, len3, leap3, radius, ebx2_r, errctrl, outlier);
+        if (compact)
+            parsz::cuda::__kernel::v0::compaction::c_lorenzo_1d1l<T, E, FP, SUBLEN_1D, SEQ_1D>
+                <<<GRID_1D, BLOCK_1D, 0, stream>>>(data, len3, leap3, radius, ebx2_r, errctrl, sink);
+        else
+            parsz::cuda::__kernel::v0::c_lorenzo_1d1l<T, E, FP, SUBLEN_1D, SEQ_1D>
+                <<<GRID_1D, BLOCK_1D, 0, stream>>>(data, len3, leap3, radius, ebx2_r, errctrl, outlier);
     }
     else if (d == 2) {
         //::cusz::c_lorenzo_2d1l_16x16data_mapto16x2<T, E, FP>
         //<<<GRID_2D, BLOCK_2D, 0, stream>>>(data, errctrl, outlier, len3, leap3, radius, ebx2_r);
-        parsz::cuda::__kernel::v0::c_lorenzo_2d1l<T, E, FP>
-            <<<GRID_2D, BLOCK_2D, 0, stream>>>(data, len3, leap3, radius, ebx2_r, errctrl, outlier);
+        if (compact)
+            parsz::cuda::__kernel::v0::compaction::c_lorenzo_2d1l<T, E, FP>
+                <<<GRID_2D, BLOCK_2D, 0, stream>>>(data, len3, leap3, radius, ebx2_r, errctrl, sink);
+        else
+            parsz::cuda::__kernel::v0::c_lorenzo_2d1l<T, E, FP>
+                <<<GRID_2D, BLOCK_2D, 0, stream>>>(data, len3, leap3, radius, ebx2_r, errctrl, outlier);
     }
     else if (d == 3) {
         //::cusz::c_lorenzo_3d1l_32x8x8data_mapto32x1x8<T, E, FP>
         //<<<GRID_3D, BLOCK_3D, 0, stream>>>(data, errctrl, outlier, len3, leap3, radius, ebx2_r);
-        parsz::cuda::__kernel::v0::c_lorenzo_3d1l<T, E, FP>
-            <<<GRID_3D, BLOCK_3D, 0, stream>>>(data, len3, leap3, radius, ebx2_r, errctrl, outlier);
+        if (compact)
+            parsz::cuda::__kernel::v0::compaction::c_lorenzo_3d1l<T, E, FP>
+                <<<GRID_3D, BLOCK_3D, 0, stream>>>(data, len3, leap3, radius, ebx2_r, errctrl, sink);
+        else
+            parsz::cuda::__kernel::v0::c_lorenzo_3d1l<T, E, FP>
+                <<<GRID_3D, BLOCK_3D, 0, stream>>>(data, len3, leap3, radius, ebx2_r, errctrl, outlier);
     }
 
     STOP_CUDAEVENT_RECORDING(stream);
@@ -192,7 +211,7 @@ cusz_error_status decompress_predict_lorenzo_i(
 #define CPP_TEMPLATE_INIT_AND_C_WRAPPER(Tliteral, Eliteral, FPliteral, T, E, FP)                                       \
     template cusz_error_status compress_predict_lorenzo_i<T, E, FP>(                                                   \
         T* const, dim3 const, double const, int const, E* const, dim3 const, T* const, dim3 const, T* const,           \
-        uint32_t*, uint32_t*, float*, cudaStream_t);                                                                   \
+        uint32_t*, uint32_t*, uint32_t const, float*, cudaStream_t);                                                  \
                                                                                                                        \
     template cusz_error_status decompress_predict_lorenzo_i<T, E, FP>(                                                 \
         E*, dim3 const, T*, dim3 const, T*, uint32_t*, uint32_t const, double const, int const, T*, dim3 const,        \
@@ -204,7 +223,7 @@ cusz_error_status decompress_predict_lorenzo_i(
         cudaStream_t stream)                                                                                           \
     {                                                                                                                  \
         return compress_predict_lorenzo_i<T, E, FP>(                                                                   \
-            data, len3, eb, radius, errctrl, placeholder_2, anchor, placeholder_1, outlier, nullptr, nullptr,          \
+            data, len3, eb, radius, errctrl, placeholder_2, anchor, placeholder_1, outlier, nullptr, nullptr, 0,       \
             time_elapsed, stream);                                                                                     \
     }                                                                                                                  \
                                                                                                                        \
@@ -0,0 +1,425 @@
+/**
+ * @file lorenzo_cpu.cc
+ * @author Jiannan Tian
+ * @brief
+ * @version 0.3
+ * @date 2022-12-08
+ *
+ * (C) 2022 by Indiana University, Argonne National Laboratory
+ *
+ */
+
+#include "cusz/cuda_compat.h"
+
+#include "cusz/type.h"
+#include "stat/stat.hh"
+#include "utils/timer.h"
+
+#include "kernel/lorenzo_all.hh"
+
+#include "detail/lorenzo_cpu.inl"
+#include "detail/lorenzo_cpu_avx2.inl"
+
+namespace {
+
+// v0 kernels by dimensionality
+template <typename T, typename E, typename FP>
+struct host_lorenzo_v0 {
+    static void construct(
+        int                               d,
+        T*                                data,
+        dim3                              len3,
+        dim3                              leap3,
+        int                               radius,
+        FP                                ebx2_r,
+        E*                                errctrl,
+        CompactionDRAM<T>                 outlier,
+        asz::stat::histogram_cpu_private* hist)
+    {
+        namespace v0 = parsz::cpu::__kernel::v0;
+        if (d == 1)
+            v0::c_lorenzo_1d1l<T, E, FP>(data, len3, leap3, radius, ebx2_r, errctrl, outlier, hist);
+        else if (d == 2)
+            v0::c_lorenzo_2d1l<T, E, FP>(data, len3, leap3, radius, ebx2_r, errctrl, outlier, hist);
+        else if (d == 3)
+            v0::c_lorenzo_3d1l<T, E, FP>(data, len3, leap3, radius, ebx2_r, errctrl, outlier, hist);
+    }
+
+    static void reconstruct(
+        int  d,
+        E*   errctrl,
+        T*   outlier,
+        dim3 len3,
+        dim3 leap3,
+        int  radius,
+        FP   ebx2,
+        T*   xdata,
+        dim3 lo = dim3(0, 0, 0),
+        dim3 hi = dim3(UINT32_MAX, UINT32_MAX, UINT32_MAX))
+    {
+        namespace v0 = parsz::cpu::__kernel::v0;
+        if (d == 1)
+            v0::x_lorenzo_1d1l<T, E, FP>(errctrl, outlier, len3, leap3, radius, ebx2, xdata, lo, hi);
+        else if (d == 2)
+            v0::x_lorenzo_2d1l<T, E, FP>(errctrl, outlier, len3, leap3, radius, ebx2, xdata, lo, hi);
+        else if (d == 3)
+            v0::x_lorenzo_3d1l<T, E, FP>(errctrl, outlier, len3, leap3, radius, ebx2, xdata, lo, hi);
+    }
+};
+
+template <typename T, typename E, typename FP>
+struct host_lorenzo : host_lorenzo_v0<T, E, FP> {
+};
+
+#if PARSZ_CPU_AVX2
+// fp32 switches to the AVX2 kernels when the CPU has them
+template <typename E>
+struct host_lorenzo<float, E, float> {
+    static void construct(
+        int                               d,
+        float*                            data,
+        dim3                              len3,
+        dim3                              leap3,
+        int                               radius,
+        float                             ebx2_r,
+        E*                                errctrl,
+        CompactionDRAM<float>             outlier,
+        asz::stat::histogram_cpu_private* hist)
+    {
+        namespace avx2 = parsz::cpu::__kernel::avx2;
+        if (not avx2::supported())
+            return host_lorenzo_v0<float, E, float>::construct(
+                d, data, len3, leap3, radius, ebx2_r, errctrl, outlier, hist);
+
+        if (d == 1)
+            avx2::c_lorenzo_1d1l<E>(data, len3, leap3, radius, ebx2_r, errctrl, outlier, hist);
+        else if (d == 2)
+            avx2::c_lorenzo_2d1l<E>(data, len3, leap3, radius, ebx2_r, errctrl, outlier, hist);
+        else if (d == 3)
+            avx2::c_lorenzo_3d1l<E>(data, len3, leap3, radius, ebx2_r, errctrl, outlier, hist);
+    }
+
+    static void reconstruct(
+        int    d,
+        E*     errctrl,
+        float* outlier,
+        dim3   len3,
+        dim3   leap3,
+        int    radius,
+        float  ebx2,
+        float* xdata,
+        dim3   lo = dim3(0, 0, 0),
+        dim3   hi = dim3(UINT32_MAX, UINT32_MAX, UINT32_MAX))
+    {
+        namespace avx2 = parsz::cpu::__kernel::avx2;
+        if (not avx2::supported())
+            return host_lorenzo_v0<float, E, float>::reconstruct(
+                d, errctrl, outlier, len3, leap3, radius, ebx2, xdata, lo, hi);
+
+        if (d == 1)
+            avx2::x_lorenzo_1d1l<E>(errctrl, outlier, len3, leap3, radius, ebx2, xdata, lo, hi);
+        else if (d == 2)
+            avx2::x_lorenzo_2d1l<E>(errctrl, outlier, len3, leap3, radius, ebx2, xdata, lo, hi);
+        else if (d == 3)
+            avx2::x_lorenzo_3d1l<E>(errctrl, outlier, len3, leap3, radius, ebx2, xdata, lo, hi);
+    }
+};
+#endif
+
+}  // namespace
+
+template <typename T, typename E, typename FP>
+cusz_error_status compress_predict_lorenzo_i_cpu(
+    T* const       data,
+    dim3 const     len3,
+    double const   eb,
+    int const      radius,
+    E* const       errctrl,
+    dim3 const,
+    T* const,
+    dim3 const,
+    T* const       outlier,
+    uint32_t*      outlier_idx,
+    uint32_t*      num_outliers,
+    uint32_t const max_outliers,
+    float*         time_elapsed,
+    uint32_t*      out_freq,
+    int const      nbin)
+{
+    auto ndim = [&]() {
+        if (len3.z == 1 and len3.y == 1)
+            return 1;
+        else if (len3.z == 1 and len3.y != 1)
+            return 2;
+        else
+            return 3;
+    };
+
+    auto d = ndim();
+
+    // error bound
+    auto ebx2   = eb * 2;
+    auto ebx2_r = 1 / ebx2;
+    auto leap3  = dim3(1, len3.x, len3.x * len3.y);
+
+    if (outlier_idx == nullptr or num_outliers == nullptr) return CUSZ_FAIL_UNSUPPORTED_PIPELINE;
+
+    *num_outliers = 0;
+    auto sink     = CompactionDRAM<T>{outlier, outlier_idx, num_outliers, max_outliers};
+
+    CREATE_CPU_TIMER;
+    START_CPU_TIMER;
+
+    if (out_freq) {
+        asz::stat::histogram_cpu_private hist(nbin);
+        host_lorenzo<T, E, FP>::construct(d, data, len3, leap3, radius, ebx2_r, errctrl, sink, &hist);
+        hist.merge(out_freq);
+    }
+    else {
+        host_lorenzo<T, E, FP>::construct(d, data, len3, leap3, radius, ebx2_r, errctrl, sink, nullptr);
+    }
+
+    STOP_CPU_TIMER;
+    TIME_ELAPSED_CPU_TIMER(time_elapsed);
+    DESTROY_CPU_TIMER;
+
+    return CUSZ_SUCCESS;
+}
+
+template <typename T, typename E, typename FP>
+cusz_error_status decompress_predict_lorenzo_i_cpu(
+    E*             errctrl,
+    dim3 const,
+    T*,
+    dim3 const,
+    T*             outlier,  // dense, scattered already
+    uint32_t*,
+    uint32_t const,
+    double const   eb,
+    int const      radius,
+    T*             xdata,
+    dim3 const     len3,
+    float*         time_elapsed)
+{
+    auto ndim = [&]() {
+        if (len3.z == 1 and len3.y == 1)
+            return 1;
+        else if (len3.z == 1 and len3.y != 1)
+            return 2;
+        else
+            return 3;
+    };
+
+    // error bound
+    auto ebx2  = eb * 2;
+    auto leap3 = dim3(1, len3.x, len3.x * len3.y);
+
+    auto d = ndim();
+
+    CREATE_CPU_TIMER;
+    START_CPU_TIMER;
+
+    host_lorenzo<T, E, FP>::reconstruct(d, errctrl, outlier, len3, leap3, radius, ebx2, xdata);
+
+    STOP_CPU_TIMER;
+    TIME_ELAPSED_CPU_TIMER(time_elapsed);
+    DESTROY_CPU_TIMER;
+
+    return CUSZ_SUCCESS;
+}
+
+template <typename T, typename E, typename FP>
+cusz_error_status decompress_predict_lorenzo_i_region_cpu(
+    E*           errctrl,
+    T*           outlier,
+    double const eb,
+    int const    radius,
+    T*           xdata,
+    dim3 const   len3,
+    dim3 const   region_lo3,
+    dim3 const   region_hi3,
+    float*       time_elapsed)
+{
+    auto const d = (len3.z == 1 and len3.y == 1) ? 1 : (len3.z == 1 ? 2 : 3);
+
+    // the tiles of the box are those of the field, which reconstruct independently; the box is a field of its own,
+    // but of the dimensionality of the whole field
+    auto const box3  = dim3(region_hi3.x - region_lo3.x, region_hi3.y - region_lo3.y, region_hi3.z - region_lo3.z);
+    auto const leap3 = dim3(1, box3.x, box3.x * box3.y);
+
+    CREATE_CPU_TIMER;
+    START_CPU_TIMER;
+
+    host_lorenzo<T, E, FP>::reconstruct(d, errctrl, outlier, box3, leap3, radius, eb * 2, xdata);
+
+    STOP_CPU_TIMER;
+    TIME_ELAPSED_CPU_TIMER(time_elapsed);
+    DESTROY_CPU_TIMER;
+
+    return CUSZ_SUCCESS;
+}
+
+template <typename T, typename E, typename FP>
+cusz_error_status decompress_predict_lorenzo_i_slab_cpu(
+    E*           errctrl,
+    T*           outlier,
+    double const eb,
+    int const    radius,
+    T*           xdata,
+    dim3 const   len3,
+    size_t const begin,
+    size_t const end)
+{
+    auto const d     = (len3.z == 1 and len3.y == 1) ? 1 : (len3.z == 1 ? 2 : 3);
+    auto const leap3 = dim3(1, len3.x, len3.x * len3.y);
+    auto const n     = end - begin;
+
+    // the rows of tiles make a field of their own, the same in x (and y) and shorter in the slowest dimension
+    auto const slab3 = d == 1 ? dim3(n, 1, 1)
+                              : (d == 2 ? dim3(len3.x, n / leap3.y, 1) : dim3(len3.x, len3.y, n / leap3.z));
+
+    host_lorenzo<T, E, FP>::reconstruct(d, errctrl, outlier + begin, slab3, leap3, radius, eb * 2, xdata + begin);
+
+    return CUSZ_SUCCESS;
+}
+
+namespace {
+
+// tiles of the 2-layer kernels: 1D 4096, 2D 64x64, 3D 32x32x32
+template <typename T, typename E, typename FP>
+struct host_lorenzo_2l {
+    static bool construct(
+        int                               d,
+        T*                                data,
+        dim3                              len3,
+        dim3                              leap3,
+        int                               radius,
+        FP                                ebx2_r,
+        E*                                errctrl,
+        CompactionDRAM<T>                 outlier,
+        asz::stat::histogram_cpu_private* hist)
+    {
+        namespace v0 = parsz::cpu::__kernel::v0;
+        if (d == 1)
+            return v0::c_lorenzo_2l<T, E, FP, 4096, 1, 1>(data, len3, leap3, radius, ebx2_r, errctrl, outlier, hist);
+        else if (d == 2)
+            return v0::c_lorenzo_2l<T, E, FP, 64, 64, 1>(data, len3, leap3, radius, ebx2_r, errctrl, outlier, hist);
+        else
+            return v0::c_lorenzo_2l<T, E, FP, 32, 32, 32>(data, len3, leap3, radius, ebx2_r, errctrl, outlier, hist);
+    }
+
+    static void reconstruct(int d, E* errctrl, T* outlier, dim3 len3, dim3 leap3, int radius, FP ebx2, T* xdata)
+    {
+        namespace v0 = parsz::cpu::__kernel::v0;
+        if (d == 1)
+            v0::x_lorenzo_2l<T, E, FP, 4096, 1, 1>(errctrl, outlier, len3, leap3, radius, ebx2, xdata);
+        else if (d == 2)
+            v0::x_lorenzo_2l<T, E, FP, 64, 64, 1>(errctrl, outlier, len3, leap3, radius, ebx2, xdata);
+        else if (d == 3)
+            v0::x_lorenzo_2l<T, E, FP, 32, 32, 32>(errctrl, outlier, len3, leap3, radius, ebx2, xdata);
+    }
+};
+
+}  // namespace
+
+template <typename T, typename E, typename FP>
+cusz_error_status compress_predict_lorenzo_ii_cpu(
+    T* const       data,
+    dim3 const     len3,
+    double const   eb,
+    int const      radius,
+    E* const       errctrl,
+    T*             outlier,
+    uint32_t*      outlier_idx,
+    uint32_t*      num_outliers,
+    uint32_t const max_outliers,
+    float*         time_elapsed,
+    uint32_t*      out_freq,
+    int const      nbin)
+{
+    auto const d      = (len3.z == 1 and len3.y == 1) ? 1 : (len3.z == 1 ? 2 : 3);
+    auto const ebx2_r = 1 / (eb * 2);
+    auto const leap3  = dim3(1, len3.x, len3.x * len3.y);
+
+    if (outlier_idx == nullptr or num_outliers == nullptr) return CUSZ_FAIL_UNSUPPORTED_PIPELINE;
+
+    *num_outliers = 0;
+    auto sink     = CompactionDRAM<T>{outlier, outlier_idx, num_outliers, max_outliers};
+
+    CREATE_CPU_TIMER;
+    START_CPU_TIMER;
+
+    bool exact;
+    if (out_freq) {
+        asz::stat::histogram_cpu_private hist(nbin);
+        exact = host_lorenzo_2l<T, E, FP>::construct(d, data, len3, leap3, radius, ebx2_r, errctrl, sink, &hist);
+        hist.merge(out_freq);
+    }
+    else {
+        exact = host_lorenzo_2l<T, E, FP>::construct(d, data, len3, leap3, radius, ebx2_r, errctrl, sink, nullptr);
+    }
+
+    STOP_CPU_TIMER;
+    TIME_ELAPSED_CPU_TIMER(time_elapsed);
+    DESTROY_CPU_TIMER;
+
+    return exact ? CUSZ_SUCCESS : CUSZ_FAIL_UNSUPPORTED_PRECISION;
+}
+
+template <typename T, typename E, typename FP>
+cusz_error_status decompress_predict_lorenzo_ii_cpu(
+    E*           errctrl,
+    double const eb,
+    int const    radius,
+    T*           xdata,
+    dim3 const   len3,
+    float*       time_elapsed)
+{
+    auto const d     = (len3.z == 1 and len3.y == 1) ? 1 : (len3.z == 1 ? 2 : 3);
+    auto const leap3 = dim3(1, len3.x, len3.x * len3.y);
+
+    CREATE_CPU_TIMER;
+    START_CPU_TIMER;
+
+    host_lorenzo_2l<T, E, FP>::reconstruct(d, errctrl, xdata, len3, leap3, radius, eb * 2, xdata);
+
+    STOP_CPU_TIMER;
+    TIME_ELAPSED_CPU_TIMER(time_elapsed);
+    DESTROY_CPU_TIMER;
+
+    return CUSZ_SUCCESS;
+}
+
+#define CPP_TEMPLATE_INIT(T, E, FP)                                                                                 \
+    template cusz_error_status compress_predict_lorenzo_i_cpu<T, E, FP>(                                            \
+        T* const, dim3 const, double const, int const, E* const, dim3 const, T* const, dim3 const, T* const,        \
+        uint32_t*, uint32_t*, uint32_t const, float*, uint32_t*, int const);                                        \
+                                                                                                                    \
+    template cusz_error_status decompress_predict_lorenzo_i_cpu<T, E, FP>(                                          \
+        E*, dim3 const, T*, dim3 const, T*, uint32_t*, uint32_t const, double const, int const, T*, dim3 const,     \
+        float*);                                                                                                    \
+                                                                                                                    \
+    template cusz_error_status decompress_predict_lorenzo_i_region_cpu<T, E, FP>(                                   \
+        E*, T*, double const, int const, T*, dim3 const, dim3 const, dim3 const, float*);                           \
+                                                                                                                    \
+    template cusz_error_status decompress_predict_lorenzo_i_slab_cpu<T, E, FP>(                                     \
+        E*, T*, double const, int const, T*, dim3 const, size_t const, size_t const);                               \
+                                                                                                                    \
+    template cusz_error_status compress_predict_lorenzo_ii_cpu<T, E, FP>(                                           \
+        T* const, dim3 const, double const, int const, E* const, T*, uint32_t*, uint32_t*, uint32_t const, float*,  \
+        uint32_t*, int const);                                                                                      \
+                                                                                                                    \
+    template cusz_error_status decompress_predict_lorenzo_ii_cpu<T, E, FP>(                                         \
+        E*, double const, int const, T*, dim3 const, float*);
+
+CPP_TEMPLATE_INIT(float, uint8_t, float);
+CPP_TEMPLATE_INIT(float, uint16_t, float);
+CPP_TEMPLATE_INIT(float, uint32_t, float);
+CPP_TEMPLATE_INIT(float, float, float);
+
+CPP_TEMPLATE_INIT(double, uint8_t, double);
+CPP_TEMPLATE_INIT(double, uint16_t, double);
+CPP_TEMPLATE_INIT(double, uint32_t, double);
+CPP_TEMPLATE_INIT(double, float, double);
+
+#undef CPP_TEMPLATE_INIT
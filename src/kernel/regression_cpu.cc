@@ -0,0 +1,160 @@
+/**
+ * @file regression_cpu.cc
+ * @author Jiannan Tian
+ * @brief
+ * @version 0.3
+ * @date 2022-12-28
+ *
+ * (C) 2022 by Indiana University, Argonne National Laboratory
+ *
+ */
+
+#include "cusz/cuda_compat.h"
+
+#include "cusz/type.h"
+#include "stat/stat.hh"
+#include "utils/timer.h"
+
+#include "kernel/regression_cpu.hh"
+
+#include "detail/regression_cpu.inl"
+
+namespace {
+
+// blocks as regression_block3(); tiles of 4096 in 1D, 64x64 in 2D and 36x36x36 in 3D
+template <typename T, typename E, typename FP>
+struct host_regression {
+    static bool construct(
+        int                               d,
+        T*                                data,
+        dim3                              len3,
+        dim3                              leap3,
+        int                               radius,
+        FP                                ebx2_r,
+        E*                                errctrl,
+        CompactionDRAM<T>                 outlier,
+        T*                                anchor,
+        asz::stat::histogram_cpu_private* hist)
+    {
+        namespace v0 = parsz::cpu::__kernel::v0;
+        if (d == 1)
+            return v0::c_lorenzo_regression<T, E, FP, 64, 1, 1, 64>(
+                data, len3, leap3, radius, ebx2_r, errctrl, outlier, anchor, hist);
+        else if (d == 2)
+            return v0::c_lorenzo_regression<T, E, FP, 16, 16, 1, 4>(
+                data, len3, leap3, radius, ebx2_r, errctrl, outlier, anchor, hist);
+        else
+            return v0::c_lorenzo_regression<T, E, FP, 6, 6, 6, 6>(
+                data, len3, leap3, radius, ebx2_r, errctrl, outlier, anchor, hist);
+    }
+
+    static void
+    reconstruct(int d, E* errctrl, T* outlier, T* anchor, dim3 len3, dim3 leap3, int radius, FP ebx2, T* xdata)
+    {
+        namespace v0 = parsz::cpu::__kernel::v0;
+        if (d == 1)
+            v0::x_lorenzo_regression<T, E, FP, 64, 1, 1, 64>(
+                errctrl, outlier, anchor, len3, leap3, radius, ebx2, xdata);
+        else if (d == 2)
+            v0::x_lorenzo_regression<T, E, FP, 16, 16, 1, 4>(
+                errctrl, outlier, anchor, len3, leap3, radius, ebx2, xdata);
+        else
+            v0::x_lorenzo_regression<T, E, FP, 6, 6, 6, 6>(
+                errctrl, outlier, anchor, len3, leap3, radius, ebx2, xdata);
+    }
+};
+
+}  // namespace
+
+template <typename T, typename E, typename FP>
+cusz_error_status compress_predict_regression_cpu(
+    T* const       data,
+    dim3 const     len3,
+    double const   eb,
+    int const      radius,
+    E* const       errctrl,
+    T* const       anchor,
+    T*             outlier,
+    uint32_t*      outlier_idx,
+    uint32_t*      num_outliers,
+    uint32_t const max_outliers,
+    float*         time_elapsed,
+    uint32_t*      out_freq,
+    int const      nbin)
+{
+    // as regression_block3()
+    auto const d      = (len3.z == 1 and len3.y == 1) ? 1 : (len3.z == 1 ? 2 : 3);
+    auto const ebx2_r = 1 / (eb * 2);
+    auto const leap3  = dim3(1, len3.x, len3.x * len3.y);
+
+    if (outlier_idx == nullptr or num_outliers == nullptr) return CUSZ_FAIL_UNSUPPORTED_PIPELINE;
+
+    *num_outliers = 0;
+    auto sink     = CompactionDRAM<T>{outlier, outlier_idx, num_outliers, max_outliers};
+
+    CREATE_CPU_TIMER;
+    START_CPU_TIMER;
+
+    bool exact;
+    if (out_freq) {
+        asz::stat::histogram_cpu_private hist(nbin);
+        exact =
+            host_regression<T, E, FP>::construct(d, data, len3, leap3, radius, ebx2_r, errctrl, sink, anchor, &hist);
+        hist.merge(out_freq);
+    }
+    else {
+        exact =
+            host_regression<T, E, FP>::construct(d, data, len3, leap3, radius, ebx2_r, errctrl, sink, anchor, nullptr);
+    }
+
+    STOP_CPU_TIMER;
+    TIME_ELAPSED_CPU_TIMER(time_elapsed);
+    DESTROY_CPU_TIMER;
+
+    return exact ? CUSZ_SUCCESS : CUSZ_FAIL_UNSUPPORTED_PRECISION;
+}
+
+template <typename T, typename E, typename FP>
+cusz_error_status decompress_predict_regression_cpu(
+    E*           errctrl,
+    T*           anchor,
+    double const eb,
+    int const    radius,
+    T*           xdata,
+    dim3 const   len3,
+    float*       time_elapsed)
+{
+    auto const d     = (len3.z == 1 and len3.y == 1) ? 1 : (len3.z == 1 ? 2 : 3);
+    auto const leap3 = dim3(1, len3.x, len3.x * len3.y);
+
+    CREATE_CPU_TIMER;
+    START_CPU_TIMER;
+
+    host_regression<T, E, FP>::reconstruct(d, errctrl, xdata, anchor, len3, leap3, radius, eb * 2, xdata);
+
+    STOP_CPU_TIMER;
+    TIME_ELAPSED_CPU_TIMER(time_elapsed);
+    DESTROY_CPU_TIMER;
+
+    return CUSZ_SUCCESS;
+}
+
+#define CPP_TEMPLATE_INIT(T, E, FP)                                                                            \
+    template cusz_error_status compress_predict_regression_cpu<T, E, FP>(                                      \
+        T* const, dim3 const, double const, int const, E* const, T* const, T*, uint32_t*, uint32_t*,            \
+        uint32_t const, float*, uint32_t*, int const);                                                         \
+                                                                                                               \
+    template cusz_error_status decompress_predict_regression_cpu<T, E, FP>(                                    \
+        E*, T*, double const, int const, T*, dim3 const, float*);
+
+CPP_TEMPLATE_INIT(float, uint8_t, float);
+CPP_TEMPLATE_INIT(float, uint16_t, float);
+CPP_TEMPLATE_INIT(float, uint32_t, float);
+CPP_TEMPLATE_INIT(float, float, float);
+
+CPP_TEMPLATE_INIT(double, uint8_t, double);
+CPP_TEMPLATE_INIT(double, uint16_t, double);
+CPP_TEMPLATE_INIT(double, uint32_t, double);
+CPP_TEMPLATE_INIT(double, float, double);
+
+#undef CPP_TEMPLATE_INIT
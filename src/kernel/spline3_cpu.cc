@@ -0,0 +1,116 @@
+/**
+ * @file spline3_cpu.cc
+ * @author Jiannan Tian
+ * @brief
+ * @version 0.3
+ * @date 2022-12-26
+ *
+ * (C) 2022 by Indiana University, Argonne National Laboratory
+ *
+ */
+
+#include "cusz/cuda_compat.h"
+
+#include "cusz/type.h"
+#include "stat/stat.hh"
+#include "utils/timer.h"
+
+#include "kernel/spline3_cpu.hh"
+
+#include "detail/spline3_cpu.inl"
+
+template <typename T, typename E, typename FP>
+cusz_error_status compress_predict_spline3_cpu(
+    T* const       data,
+    dim3 const     len3,
+    double const   eb,
+    int const      radius,
+    E* const       errctrl,
+    T* const       anchor,
+    dim3 const     anchor_len3,
+    T*             outlier,
+    uint32_t*      outlier_idx,
+    uint32_t*      num_outliers,
+    uint32_t const max_outliers,
+    float*         time_elapsed,
+    uint32_t*      out_freq,
+    int const      nbin)
+{
+    auto ebx2   = eb * 2;
+    auto ebx2_r = 1 / ebx2;
+    auto leap3  = dim3(1, len3.x, len3.x * len3.y);
+    auto stride = spline3_anchor_stride(len3);
+
+    if (outlier_idx == nullptr or num_outliers == nullptr) return CUSZ_FAIL_UNSUPPORTED_PIPELINE;
+
+    *num_outliers = 0;
+    auto sink     = CompactionDRAM<T>{outlier, outlier_idx, num_outliers, max_outliers};
+
+    CREATE_CPU_TIMER;
+    START_CPU_TIMER;
+
+    if (out_freq) {
+        asz::stat::histogram_cpu_private hist(nbin);
+        parsz::cpu::__kernel::v0::c_spline3<T, E, FP>(
+            data, len3, leap3, anchor, anchor_len3, stride, radius, ebx2_r, errctrl, sink, &hist);
+        hist.merge(out_freq);
+    }
+    else {
+        parsz::cpu::__kernel::v0::c_spline3<T, E, FP>(
+            data, len3, leap3, anchor, anchor_len3, stride, radius, ebx2_r, errctrl, sink, nullptr);
+    }
+
+    STOP_CPU_TIMER;
+    TIME_ELAPSED_CPU_TIMER(time_elapsed);
+    DESTROY_CPU_TIMER;
+
+    return CUSZ_SUCCESS;
+}
+
+template <typename T, typename E, typename FP>
+cusz_error_status decompress_predict_spline3_cpu(
+    E*           errctrl,
+    T*           anchor,
+    dim3 const   anchor_len3,
+    double const eb,
+    int const    radius,
+    T*           xdata,
+    dim3 const   len3,
+    float*       time_elapsed)
+{
+    auto ebx2   = eb * 2;
+    auto leap3  = dim3(1, len3.x, len3.x * len3.y);
+    auto stride = spline3_anchor_stride(len3);
+
+    CREATE_CPU_TIMER;
+    START_CPU_TIMER;
+
+    parsz::cpu::__kernel::v0::x_spline3<T, E, FP>(
+        errctrl, anchor, anchor_len3, stride, len3, leap3, radius, ebx2, xdata);
+
+    STOP_CPU_TIMER;
+    TIME_ELAPSED_CPU_TIMER(time_elapsed);
+    DESTROY_CPU_TIMER;
+
+    return CUSZ_SUCCESS;
+}
+
+#define CPP_TEMPLATE_INIT(T, E, FP)                                                                             \
+    template cusz_error_status compress_predict_spline3_cpu<T, E, FP>(                                          \
+        T* const, dim3 const, double const, int const, E* const, T* const, dim3 const, T*, uint32_t*, uint32_t*, \
+        uint32_t const, float*, uint32_t*, int const);                                                          \
+                                                                                                                \
+    template cusz_error_status decompress_predict_spline3_cpu<T, E, FP>(                                        \
+        E*, T*, dim3 const, double const, int const, T*, dim3 const, float*);
+
+CPP_TEMPLATE_INIT(float, uint8_t, float);
+CPP_TEMPLATE_INIT(float, uint16_t, float);
+CPP_TEMPLATE_INIT(float, uint32_t, float);
+CPP_TEMPLATE_INIT(float, float, float);
+
+CPP_TEMPLATE_INIT(double, uint8_t, double);
+CPP_TEMPLATE_INIT(double, uint16_t, double);
+CPP_TEMPLATE_INIT(double, uint32_t, double);
+CPP_TEMPLATE_INIT(double, float, double);
+
+#undef CPP_TEMPLATE_INIT
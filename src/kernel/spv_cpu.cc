@@ -0,0 +1,339 @@
+/**
+ * @file spv_cpu.cc
+ * @author Jiannan Tian
+ * @brief
+ * @version 0.3
+ * @date 2022-12-08
+ *
+ * (C) 2022 by Indiana University, Argonne National Laboratory
+ *
+ */
+
+#include <omp.h>
+#include <algorithm>
+#include <vector>
+
+#include "kernel/spv_cpu.hh"
+#include "kernel/spv_idx.hh"
+#include "kernel/spv_val.hh"
+#include "utils/timer.h"
+
+template <typename T, typename M>
+void accsz::spv_gather_cpu(T* in, size_t const in_len, T* h_val, uint32_t* h_idx, int* nnz, float* milliseconds)
+{
+    CREATE_CPU_TIMER;
+    START_CPU_TIMER;
+
+    // count per thread, exclusive-scan the counts, then write in place (order-preserving)
+    auto             nthread = omp_get_max_threads();
+    std::vector<int> count(nthread + 1, 0);
+
+#pragma omp parallel num_threads(nthread)
+    {
+        auto tid = omp_get_thread_num();
+        auto n   = omp_get_num_threads();
+
+        auto beg = in_len * tid / n;
+        auto end = in_len * (tid + 1) / n;
+
+        int _count = 0;
+        for (auto i = beg; i < end; i++) _count += in[i] != 0;
+        count[tid + 1] = _count;
+
+#pragma omp barrier
+#pragma omp single
+        for (auto t = 1; t <= n; t++) count[t] += count[t - 1];
+
+        auto pos = count[tid];
+        for (auto i = beg; i < end; i++) {
+            if (in[i] != 0) {
+                h_idx[pos] = i;
+                h_val[pos] = in[i];
+                pos++;
+            }
+        }
+    }
+
+    *nnz = count[nthread];
+
+    STOP_CPU_TIMER;
+    TIME_ELAPSED_CPU_TIMER(milliseconds);
+    DESTROY_CPU_TIMER;
+}
+
+template <typename T, typename M>
+void accsz::spv_scatter_cpu(T* h_val, uint32_t* h_idx, int const nnz, T* decoded, float* milliseconds)
+{
+    CREATE_CPU_TIMER;
+    START_CPU_TIMER;
+
+#pragma omp parallel for schedule(static)
+    for (auto i = 0; i < nnz; i++) decoded[h_idx[i]] = h_val[i];
+
+    STOP_CPU_TIMER;
+    TIME_ELAPSED_CPU_TIMER(milliseconds);
+    DESTROY_CPU_TIMER;
+}
+
+template <typename T, typename M>
+void accsz::spv_scatter_ranges_cpu(
+    T*            h_val,
+    uint32_t*     h_idx,
+    int const     nnz,
+    size_t const* ranges,
+    size_t const  nrange,
+    T*            decoded,
+    float*        milliseconds)
+{
+    CREATE_CPU_TIMER;
+    START_CPU_TIMER;
+
+    // where each range starts in `decoded`
+    std::vector<size_t> offset(nrange + 1, 0);
+    for (auto r = 0u; r < nrange; r++) offset[r + 1] = offset[r] + (ranges[2 * r + 1] - ranges[2 * r]);
+
+#pragma omp parallel for schedule(static)
+    for (auto i = 0; i < nnz; i++) {
+        size_t const at  = h_idx[i];
+        auto const   pos = std::upper_bound(ranges, ranges + 2 * nrange, at) - ranges;
+        // past the begin of range pos / 2, not past its end
+        if (pos % 2 == 1) decoded[offset[pos / 2] + (at - ranges[pos - 1])] = h_val[i];
+    }
+
+    STOP_CPU_TIMER;
+    TIME_ELAPSED_CPU_TIMER(milliseconds);
+    DESTROY_CPU_TIMER;
+}
+
+template <typename T, typename M>
+void accsz::spv_sort_cpu(T* h_val, uint32_t* h_idx, int const nnz, float* milliseconds)
+{
+    CREATE_CPU_TIMER;
+    START_CPU_TIMER;
+
+    if (not std::is_sorted(h_idx, h_idx + nnz)) {
+        // LSD radix sort by 11-bit digits, only as many passes as the largest index needs
+        constexpr int DIGIT = 11, NBUCKET = 1 << DIGIT;
+
+        auto const max_idx = *std::max_element(h_idx, h_idx + nnz);
+        auto       npass   = 1;
+        while (npass * DIGIT < 32 and (max_idx >> (npass * DIGIT)) != 0) npass++;
+
+        std::vector<uint32_t> idx_buf(nnz);
+        std::vector<T>        val_buf(nnz);
+        std::vector<size_t>   offset(NBUCKET);
+
+        auto src_idx = h_idx, dst_idx = idx_buf.data();
+        auto src_val = h_val, dst_val = val_buf.data();
+
+        for (auto pass = 0; pass < npass; pass++) {
+            auto const shift = pass * DIGIT;
+
+            std::fill(offset.begin(), offset.end(), 0);
+            for (auto i = 0; i < nnz; i++) offset[(src_idx[i] >> shift) & (NBUCKET - 1)]++;
+            size_t sum = 0;
+            for (auto& o : offset) sum += o, o = sum - o;
+
+            for (auto i = 0; i < nnz; i++) {
+                auto dst     = offset[(src_idx[i] >> shift) & (NBUCKET - 1)]++;
+                dst_idx[dst] = src_idx[i];
+                dst_val[dst] = src_val[i];
+            }
+            std::swap(src_idx, dst_idx);
+            std::swap(src_val, dst_val);
+        }
+
+        if (src_idx != h_idx) {
+            std::copy(src_idx, src_idx + nnz, h_idx);
+            std::copy(src_val, src_val + nnz, h_val);
+        }
+    }
+
+    STOP_CPU_TIMER;
+    TIME_ELAPSED_CPU_TIMER(milliseconds);
+    DESTROY_CPU_TIMER;
+}
+
+size_t accsz::spv_idx_pack_cpu(uint32_t const* h_idx, int const nnz, uint32_t* out, float* milliseconds)
+{
+    using L = spv_idx_layout;
+
+    CREATE_CPU_TIMER;
+    START_CPU_TIMER;
+
+    auto const nblock = (long)L::nblock(nnz);
+    auto       first  = out;
+    auto       start  = out + L::start_offset(nnz);
+    auto       packed = out + L::packed_offset(nnz);
+
+    start[0] = 0;
+#pragma omp parallel for schedule(static)
+    for (auto b = 0l; b < nblock; b++) {
+        auto const beg = b * L::BLOCK, end = beg + L::count(nnz, b);
+
+        uint32_t any = 0;
+        for (auto i = beg + 1; i < end; i++) any |= h_idx[i] - h_idx[i - 1] - 1;
+
+        first[b]     = h_idx[beg];
+        start[b + 1] = L::nword(end - beg, spv_bit_width(any));
+    }
+    for (auto b = 0l; b < nblock; b++) start[b + 1] += start[b];
+
+#pragma omp parallel for schedule(static)
+    for (auto b = 0l; b < nblock; b++) {
+        auto const beg = b * L::BLOCK, end = beg + L::count(nnz, b);
+        auto const width = L::width(end - beg, start[b + 1] - start[b]);
+
+        spv_bit_writer gaps(packed + start[b]);
+        for (auto i = beg; i < end; i++) gaps.put(i > beg ? h_idx[i] - h_idx[i - 1] - 1 : 0, width);
+        gaps.flush();
+    }
+
+    STOP_CPU_TIMER;
+    TIME_ELAPSED_CPU_TIMER(milliseconds);
+    DESTROY_CPU_TIMER;
+
+    return sizeof(uint32_t) * (L::packed_offset(nnz) + start[nblock]);
+}
+
+template <typename T, typename M>
+size_t accsz::spv_val_xor_cpu(T const* h_val, int const nnz, uint8_t* out, float* milliseconds)
+{
+    using L    = spv_val_layout<T>;
+    using UInt = typename L::UInt;
+
+    CREATE_CPU_TIMER;
+    START_CPU_TIMER;
+
+    auto const nblock = (long)L::nblock(nnz);
+    auto       first  = reinterpret_cast<T*>(out);
+    auto       start  = reinterpret_cast<uint32_t*>(out + L::start_offset(nnz));
+    auto       shape  = out + L::shape_offset(nnz);
+    auto       packed = reinterpret_cast<uint32_t*>(out + L::packed_offset(nnz));
+
+    auto residual = [&](long i) -> UInt { return L::to_bits(h_val[i]) ^ L::to_bits(h_val[i - 1]); };
+
+    start[0] = 0;
+#pragma omp parallel for schedule(static)
+    for (auto b = 0l; b < nblock; b++) {
+        auto const beg = b * L::BLOCK, end = beg + spv_idx_layout::count(nnz, b);
+
+        UInt any = 0;
+        for (auto i = beg + 1; i < end; i++) any |= residual(i);
+
+        auto tz = any == 0 ? 0 : spv_trailing_zeros(any);
+
+        first[b]         = h_val[beg];
+        shape[2 * b]     = tz;
+        shape[2 * b + 1] = spv_bit_width(any >> tz);
+        start[b + 1]     = spv_idx_layout::nword(end - beg - 1, shape[2 * b + 1]);
+    }
+    for (auto b = 0l; b < nblock; b++) start[b + 1] += start[b];
+
+#pragma omp parallel for schedule(static)
+    for (auto b = 0l; b < nblock; b++) {
+        auto const beg = b * L::BLOCK, end = beg + spv_idx_layout::count(nnz, b);
+
+        spv_bit_writer residuals(packed + start[b]);
+        for (auto i = beg + 1; i < end; i++) residuals.put(residual(i) >> shape[2 * b], shape[2 * b + 1]);
+        residuals.flush();
+    }
+
+    STOP_CPU_TIMER;
+    TIME_ELAPSED_CPU_TIMER(milliseconds);
+    DESTROY_CPU_TIMER;
+
+    return L::packed_offset(nnz) + sizeof(uint32_t) * start[nblock];
+}
+
+template <typename T, typename M>
+void accsz::spv_scatter_packed_cpu(
+    uint8_t const*      coded_val,
+    spv_valcoding const coding,
+    uint32_t const*     packed_idx,
+    int const           nnz,
+    T*                  decoded,
+    float*              milliseconds)
+{
+    CREATE_CPU_TIMER;
+    START_CPU_TIMER;
+
+    auto const nblock = (long)spv_idx_layout::nblock(nnz);
+
+#pragma omp parallel for schedule(static)
+    for (auto b = 0l; b < nblock; b++) {
+        spv_idx_cursor    idx(packed_idx, nnz, b);
+        spv_val_cursor<T> val(coded_val, coding, nnz, b);
+        for (auto i = 0; i < idx.count; i++) decoded[idx.next()] = val.next();
+    }
+
+    STOP_CPU_TIMER;
+    TIME_ELAPSED_CPU_TIMER(milliseconds);
+    DESTROY_CPU_TIMER;
+}
+
+template <typename T, typename M>
+void accsz::spv_scatter_packed_ranges_cpu(
+    uint8_t const*      coded_val,
+    spv_valcoding const coding,
+    uint32_t const*     packed_idx,
+    int const           nnz,
+    size_t const*       ranges,
+    size_t const        nrange,
+    T*                  decoded,
+    float*              milliseconds)
+{
+    CREATE_CPU_TIMER;
+    START_CPU_TIMER;
+
+    auto const nblock = (long)spv_idx_layout::nblock(nnz);
+    auto const first  = packed_idx;
+
+    // where each range starts in `decoded`
+    std::vector<size_t> offset(nrange + 1, 0);
+    for (auto r = 0u; r < nrange; r++) offset[r + 1] = offset[r] + (ranges[2 * r + 1] - ranges[2 * r]);
+
+#pragma omp parallel for schedule(dynamic)
+    for (auto r = 0l; r < (long)nrange; r++) {
+        auto const lo = ranges[2 * r], hi = ranges[2 * r + 1];
+        auto const to = decoded + offset[r] - lo;
+
+        // the last block starting at or before lo, up to the first starting at or after hi
+        auto b = std::upper_bound(first, first + nblock, lo) - first;
+        for (b = std::max(b - 1, 0l); b < nblock and first[b] < hi; b++) {
+            spv_idx_cursor    idx(packed_idx, nnz, b);
+            spv_val_cursor<T> val(coded_val, coding, nnz, b);
+            for (auto i = 0; i < idx.count; i++) {
+                auto at = idx.next();
+                auto v  = val.next();
+                if (at >= lo and at < hi) to[at] = v;
+            }
+        }
+    }
+
+    STOP_CPU_TIMER;
+    TIME_ELAPSED_CPU_TIMER(milliseconds);
+    DESTROY_CPU_TIMER;
+}
+
+#define SPV_CPU(T, M)                                                                                     \
+    template void accsz::spv_gather_cpu<T, M>(T*, size_t const, T*, uint32_t*, int*, float*);             \
+    template void accsz::spv_scatter_cpu<T, M>(T*, uint32_t*, int const, T*, float*);                     \
+    template void accsz::spv_scatter_ranges_cpu<T, M>(                                                    \
+        T*, uint32_t*, int const, size_t const*, size_t const, T*, float*);                               \
+    template void accsz::spv_sort_cpu<T, M>(T*, uint32_t*, int const, float*);                            \
+    template size_t accsz::spv_val_xor_cpu<T, M>(T const*, int const, uint8_t*, float*);                  \
+    template void accsz::spv_scatter_packed_cpu<T, M>(                                                    \
+        uint8_t const*, spv_valcoding const, uint32_t const*, int const, T*, float*);                     \
+    template void accsz::spv_scatter_packed_ranges_cpu<T, M>(                                             \
+        uint8_t const*, spv_valcoding const, uint32_t const*, int const, size_t const*, size_t const, T*,   \
+        float*);
+
+SPV_CPU(uint8_t, uint32_t)
+SPV_CPU(uint16_t, uint32_t)
+SPV_CPU(uint32_t, uint32_t)
+SPV_CPU(uint64_t, uint32_t)
+SPV_CPU(float, uint32_t)
+SPV_CPU(double, uint32_t)
+
+#undef SPV_CPU
@@ -24,6 +24,31 @@
         T* d_val, uint32_t* d_idx, int const nnz, T* decoded, float* milliseconds, cudaStream_t stream)            \
     {                                                                                                              \
         accsz::detail::spv_scatter<T, M>(d_val, d_idx, nnz, decoded, milliseconds, stream);                        \
+    }                                                                                                              \
+                                                                                                                   \
+    void spv_sort_T##Tliteral##_M##Mliteral(                                                                       \
+        T* d_val, uint32_t* d_idx, int const nnz, float* milliseconds, cudaStream_t stream)                        \
+    {                                                                                                              \
+        accsz::detail::spv_sort<T, M>(d_val, d_idx, nnz, milliseconds, stream);                                    \
+    }                                                                                                              \
+                                                                                                                   \
+    size_t spv_val_xor_T##Tliteral##_M##Mliteral(                                                                  \
+        T const* d_val, int const nnz, uint8_t* d_out, float* milliseconds, cudaStream_t stream)                   \
+    {                                                                                                              \
+        return accsz::detail::spv_val_xor<T, M>(d_val, nnz, d_out, milliseconds, stream);                          \
+    }                                                                                                              \
+                                                                                                                   \
+    void spv_scatter_packed_T##Tliteral##_M##Mliteral(                                                             \
+        uint8_t const*  coded_val,                                                                                 \
+        int const       coding,                                                                                    \
+        uint32_t const* packed_idx,                                                                                \
+        int const       nnz,                                                                                       \
+        T*              decoded,                                                                                   \
+        float*          milliseconds,                                                                              \
+        cudaStream_t    stream)                                                                                    \
+    {                                                                                                              \
+        accsz::detail::spv_scatter_packed<T, M>(                                                                   \
+            coded_val, (accsz::spv_valcoding)coding, packed_idx, nnz, decoded, milliseconds, stream);              \
     }
 
 SPV(ui8, ui32, uint8_t, uint32_t)
@@ -48,6 +73,34 @@ SPV(fp64, ui32, double, uint32_t)
         T * d_val, uint32_t * d_idx, int const nnz, T* decoded, float* milliseconds, cudaStream_t stream)           \
     {                                                                                                               \
         spv_scatter_T##Tliteral##_M##Mliteral(d_val, d_idx, nnz, decoded, milliseconds, stream);                    \
+    }                                                                                                               \
+                                                                                                                    \
+    template <>                                                                                                     \
+    void accsz::spv_sort<T, M>(                                                                                     \
+        T * d_val, uint32_t * d_idx, int const nnz, float* milliseconds, cudaStream_t stream)                       \
+    {                                                                                                               \
+        spv_sort_T##Tliteral##_M##Mliteral(d_val, d_idx, nnz, milliseconds, stream);                                \
+    }                                                                                                               \
+                                                                                                                    \
+    template <>                                                                                                     \
+    size_t accsz::spv_val_xor<T, M>(                                                                                \
+        T const* d_val, int const nnz, uint8_t* d_out, float* milliseconds, cudaStream_t stream)                    \
+    {                                                                                                               \
+        return spv_val_xor_T##Tliteral##_M##Mliteral(d_val, nnz, d_out, milliseconds, stream);                      \
+    }                                                                                                               \
+                                                                                                                    \
+    template <>                                                                                                     \
+    void accsz::spv_scatter_packed<T, M>(                                                                           \
+        uint8_t const*      coded_val,                                                                              \
+        spv_valcoding const coding,                                                                                 \
+        uint32_t const*     packed_idx,                                                                             \
+        int const           nnz,                                                                                    \
+        T*                  decoded,                                                                                \
+        float*              milliseconds,                                                                           \
+        cudaStream_t        stream)                                                                                 \
+    {                                                                                                               \
+        spv_scatter_packed_T##Tliteral##_M##Mliteral(                                                               \
+            coded_val, (int)coding, packed_idx, nnz, decoded, milliseconds, stream);                                \
     }
 
 SPV(ui8, ui32, uint8_t, uint32_t)
@@ -58,3 +111,23 @@ SPV(fp32, ui32, float, uint32_t)
 SPV(fp64, ui32, double, uint32_t)
 
 #undef SPV
+
+size_t spv_idx_pack_Mui32(
+    uint32_t const* d_idx,
+    int const       nnz,
+    uint32_t*       d_out,
+    float*          milliseconds,
+    cudaStream_t    stream)
+{
+    return accsz::detail::spv_idx_pack(d_idx, nnz, d_out, milliseconds, stream);
+}
+
+size_t accsz::spv_idx_pack(
+    uint32_t const* d_idx,
+    int const       nnz,
+    uint32_t*       d_out,
+    float*          milliseconds,
+    cudaStream_t    stream)
+{
+    return spv_idx_pack_Mui32(d_idx, nnz, d_out, milliseconds, stream);
+}
@@ -0,0 +1,74 @@
+/**
+ * @file stat.cc
+ * @author Jiannan Tian
+ * @brief
+ * @version 0.3
+ * @date 2022-12-08
+ *
+ * (C) 2022 by Indiana University, Argonne National Laboratory
+ *
+ */
+
+#include <omp.h>
+#include <cstring>
+#include <vector>
+
+#include "cusz/type.h"
+#include "stat/stat.hh"
+#include "utils/timer.h"
+
+asz::stat::histogram_cpu_private::histogram_cpu_private(int const nbin, int const nthread) :
+    nbin(nbin), stride((nbin + 15) / 16 * 16), nrow(nthread * NREPLICA), local((size_t)stride * nrow, 0)
+{
+}
+
+void asz::stat::histogram_cpu_private::merge(uint32_t* out_freq)
+{
+    // rows are contiguous in the bin index, so the merge runs on whole vectors
+#pragma omp parallel for simd schedule(static)
+    for (auto b = 0; b < nbin; b++) {
+        uint32_t sum = 0;
+        for (auto r = 0; r < nrow; r++) sum += local[(size_t)r * stride + b];
+        out_freq[b] = sum;
+    }
+}
+
+template <typename T>
+cusz_error_status asz::stat::histogram_cpu(
+    T*           in_data,
+    size_t const in_len,
+    uint32_t*    out_freq,
+    int const    num_buckets,
+    float*       milliseconds)
+{
+    CREATE_CPU_TIMER;
+    START_CPU_TIMER;
+
+    auto const            nthread = omp_get_max_threads();
+    histogram_cpu_private hist(num_buckets, nthread);
+
+#pragma omp parallel num_threads(nthread)
+    {
+        auto const tid   = omp_get_thread_num();
+        auto const start = in_len * tid / nthread;
+        auto const end   = in_len * (tid + 1) / nthread;
+        hist.count(in_data + start, end - start);
+    }
+    hist.merge(out_freq);
+
+    STOP_CPU_TIMER;
+    TIME_ELAPSED_CPU_TIMER(milliseconds);
+    DESTROY_CPU_TIMER;
+
+    return CUSZ_SUCCESS;
+}
+
+#define INIT_HIST_CPU(T) \
+    template cusz_error_status asz::stat::histogram_cpu<T>(T*, size_t const, uint32_t*, int const, float*);
+
+INIT_HIST_CPU(uint8_t)
+INIT_HIST_CPU(uint16_t)
+INIT_HIST_CPU(uint32_t)
+INIT_HIST_CPU(uint64_t)
+
+#undef INIT_HIST_CPU
@@ -0,0 +1,359 @@
+/**
+ * @file stream.cc
+ * @author Jiannan Tian
+ * @brief
+ * @version 0.3
+ * @date 2022-12-15
+ *
+ * (C) 2022 by Indiana University, Argonne National Laboratory
+ *
+ */
+
+#include "stream.hh"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <future>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include "compressor.hh"
+#include "framework.hh"
+#include "header.h"
+
+#ifndef CUSZ_HOST_ONLY
+#include "utils/cuda_err.cuh"
+#endif
+
+namespace {
+
+constexpr char STREAM_MAGIC[8] = {'C', 'U', 'S', 'Z', 'S', 'T', 'R', 'M'};
+
+struct slab_geometry {
+    int      ndim;
+    size_t   slab_len;  // number of elements in one slab
+    size_t   nslab;     // extent of the slowest dimension
+    uint32_t tile;      // Lorenzo tile extent along the slowest dimension
+};
+
+slab_geometry get_geometry(size_t x, size_t y, size_t z)
+{
+    if (z > 1) return slab_geometry{3, x * y, z, 8};
+    if (y > 1) return slab_geometry{2, x, y, 16};
+    return slab_geometry{1, 1, x, 256};
+}
+
+void set_segment_len(cusz::Context* ctx, slab_geometry const& g, size_t x, size_t y, uint32_t nslab)
+{
+    if (g.ndim == 3)
+        ctx->set_len(x, y, nslab);
+    else if (g.ndim == 2)
+        ctx->set_len(x, nslab);
+    else
+        ctx->set_len(nslab);
+}
+
+std::vector<cusz::StreamSegment> partition(slab_geometry const& g, uint32_t const seg_nslab)
+{
+    std::vector<cusz::StreamSegment> segs;
+    for (size_t begin = 0; begin < g.nslab; begin += seg_nslab)
+        segs.push_back({0, 0, (uint32_t)begin, (uint32_t)std::min<size_t>(seg_nslab, g.nslab - begin)});
+
+    // a single-element segment is not a valid input; fold it into its predecessor
+    if (segs.size() > 1 and segs.back().nslab * g.slab_len == 1) {
+        segs.pop_back();
+        segs.back().nslab += 1;
+    }
+    return segs;
+}
+
+template <typename T>
+void read_slabs(std::ifstream& ifs, slab_geometry const& g, cusz::StreamSegment const& seg, T* buf)
+{
+    ifs.seekg(sizeof(T) * g.slab_len * seg.slab_begin);
+    ifs.read(reinterpret_cast<char*>(buf), sizeof(T) * g.slab_len * seg.nslab);
+    if (not ifs) throw std::runtime_error("[stream] failed to read slabs from input.");
+}
+
+// value range for "r2r" mode, in one pass of at most `budget_len` elements at a time
+template <typename T>
+double get_range(std::ifstream& ifs, size_t const len, size_t const budget_len)
+{
+    std::vector<T> buf(std::min(len, budget_len));
+    T              minval = std::numeric_limits<T>::max(), maxval = std::numeric_limits<T>::lowest();
+
+    ifs.seekg(0);
+    for (size_t done = 0; done < len; done += buf.size()) {
+        auto n = std::min(buf.size(), len - done);
+        ifs.read(reinterpret_cast<char*>(buf.data()), sizeof(T) * n);
+        if (not ifs) throw std::runtime_error("[stream] failed to read input for range.");
+
+        auto res = std::minmax_element(buf.data(), buf.data() + n);
+        minval   = std::min(minval, *res.first);
+        maxval   = std::max(maxval, *res.second);
+    }
+    return (double)maxval - (double)minval;
+}
+
+}  // namespace
+
+bool cusz::StreamHelper::is_stream_archive(std::string const& fname)
+{
+    std::ifstream ifs(fname, std::ios::binary);
+    char          magic[8];
+    if (not ifs.read(magic, sizeof(magic))) return false;
+    return memcmp(magic, STREAM_MAGIC, sizeof(magic)) == 0;
+}
+
+uint32_t cusz::StreamHelper::get_seg_nslab(Context* ctx, size_t const type_nbyte, size_t const budget_nbyte)
+{
+    auto g     = get_geometry(ctx->x, ctx->y, ctx->z);
+    auto nslab = budget_nbyte / (type_nbyte * g.slab_len);
+
+    nslab = nslab / g.tile * g.tile;
+    nslab = std::max<size_t>(nslab, g.tile);
+    nslab = std::min<size_t>(nslab, g.nslab);
+
+    return nslab;
+}
+
+template <class Compressor, typename T>
+size_t cusz::stream_compress(
+    Context*           config,
+    std::string const& in_fname,
+    std::string const& out_fname,
+    size_t const       budget_nbyte,
+    cudaStream_t       stream)
+{
+    using BYTE = uint8_t;
+
+    auto const policy = (*config).policy;
+    auto const x = (*config).x, y = (*config).y, z = (*config).z;
+    auto const g = get_geometry(x, y, z);
+
+    std::ifstream ifs(in_fname, std::ios::binary);
+    if (not ifs) throw std::runtime_error("[stream] cannot open " + in_fname);
+    std::ofstream ofs(out_fname, std::ios::binary);
+    if (not ofs) throw std::runtime_error("[stream] cannot open " + out_fname);
+
+    auto seg_nslab = StreamHelper::get_seg_nslab(config, sizeof(T), budget_nbyte);
+    auto segs      = partition(g, seg_nslab);
+
+    double eb = (*config).eb;
+    if ((*config).mode == "r2r") eb *= get_range<T>(ifs, g.slab_len * g.nslab, g.slab_len * seg_nslab);
+
+    size_t max_seg_len = 0;
+    for (auto& s : segs) max_seg_len = std::max(max_seg_len, s.nslab * g.slab_len);
+    auto const alloc_len = (size_t)(max_seg_len * 1.03) + 1;
+
+    // double buffer: segment k+1 is read while segment k is being compressed
+    std::vector<T> h_in[2] = {std::vector<T>(alloc_len), std::vector<T>(alloc_len)};
+    std::vector<BYTE> h_staging;
+#ifdef CUSZ_HOST_ONLY
+    if (policy == CUDA) throw std::runtime_error("[stream] This build has no CUDA backend; use the host policy.");
+#else
+    T* d_in{nullptr};
+    if (policy == CUDA) CHECK_CUDA(cudaMalloc(&d_in, sizeof(T) * alloc_len));
+#endif
+
+    StreamHeader header{};
+    memcpy(header.magic, STREAM_MAGIC, sizeof(STREAM_MAGIC));
+    header.version           = StreamHelper::VERSION;
+    header.ndim              = g.ndim;
+    header.x                 = x;
+    header.y                 = y;
+    header.z                 = z;
+    header.byte_uncompressed = sizeof(T);
+    header.nseg              = segs.size();
+    header.seg_nslab         = seg_nslab;
+    header.eb                = eb;
+    ofs.write(reinterpret_cast<char*>(&header), sizeof(header));  // placeholder; index_offset is patched at the end
+
+    // one compressor per segment shape: all but the last segment share one
+    std::unique_ptr<Compressor> body, tail;
+
+    auto read_ahead = [&](int k) {
+        return std::async(std::launch::async, [&, k]() { read_slabs(ifs, g, segs[k], h_in[k % 2].data()); });
+    };
+
+    auto pending = read_ahead(0);
+    for (auto k = 0; k < (int)segs.size(); k++) {
+        pending.get();
+        if (k + 1 < (int)segs.size()) pending = read_ahead(k + 1);
+
+        auto seg_ctx = *config;
+        set_segment_len(&seg_ctx, g, x, y, segs[k].nslab);
+        seg_ctx.eb = eb;
+        CompressorHelper::autotune_coarse_parvle(&seg_ctx);
+
+        auto& compressor = segs[k].nslab == segs[0].nslab ? body : tail;
+        if (not compressor) {
+            compressor.reset(new Compressor);
+            compressor->init(&seg_ctx);
+        }
+
+        T* in = h_in[k % 2].data();
+#ifndef CUSZ_HOST_ONLY
+        if (policy == CUDA) {
+            CHECK_CUDA(cudaMemcpy(d_in, in, sizeof(T) * seg_ctx.get_len(), cudaMemcpyHostToDevice));
+            in = d_in;
+        }
+#endif
+
+        BYTE*  compressed;
+        size_t compressed_len;
+        compressor->compress(&seg_ctx, in, compressed, compressed_len, stream);
+
+#ifndef CUSZ_HOST_ONLY
+        if (policy == CUDA) {
+            h_staging.resize(compressed_len);
+            CHECK_CUDA(cudaMemcpy(h_staging.data(), compressed, compressed_len, cudaMemcpyDeviceToHost));
+            compressed = h_staging.data();
+        }
+#endif
+
+        segs[k].offset = ofs.tellp();
+        segs[k].nbyte  = compressed_len;
+        ofs.write(reinterpret_cast<char*>(compressed), compressed_len);
+    }
+
+    header.index_offset = ofs.tellp();
+    ofs.write(reinterpret_cast<char*>(segs.data()), sizeof(StreamSegment) * segs.size());
+    auto total_nbyte = (size_t)ofs.tellp();
+
+    ofs.seekp(0);
+    ofs.write(reinterpret_cast<char*>(&header), sizeof(header));
+    if (not ofs) throw std::runtime_error("[stream] failed to write " + out_fname);
+
+#ifndef CUSZ_HOST_ONLY
+    if (d_in) cudaFree(d_in);
+#endif
+
+    return total_nbyte;
+}
+
+template <class Compressor, typename T>
+size_t cusz::stream_decompress(
+    std::string const&    in_fname,
+    std::string const&    out_fname,
+    cusz_execution_policy policy,
+    cudaStream_t          stream)
+{
+    using BYTE = uint8_t;
+
+    std::ifstream ifs(in_fname, std::ios::binary);
+    if (not ifs) throw std::runtime_error("[stream] cannot open " + in_fname);
+
+    StreamHeader header;
+    ifs.read(reinterpret_cast<char*>(&header), sizeof(header));
+    if (not ifs or memcmp(header.magic, STREAM_MAGIC, sizeof(STREAM_MAGIC)) != 0)
+        throw std::runtime_error("[stream] " + in_fname + " is not a multi-segment archive.");
+    if (header.byte_uncompressed != sizeof(T))
+        throw std::runtime_error("[stream] data type mismatches the archive.");
+
+    std::vector<StreamSegment> segs(header.nseg);
+    ifs.seekg(header.index_offset);
+    ifs.read(reinterpret_cast<char*>(segs.data()), sizeof(StreamSegment) * segs.size());
+    if (not ifs) throw std::runtime_error("[stream] failed to read the segment index.");
+
+    auto const g = get_geometry(header.x, header.y, header.z);
+
+    std::ofstream ofs;
+    if (not out_fname.empty()) {
+        ofs.open(out_fname, std::ios::binary);
+        if (not ofs) throw std::runtime_error("[stream] cannot open " + out_fname);
+    }
+
+    size_t max_seg_len = 0, max_seg_nbyte = 0;
+    for (auto& s : segs) {
+        max_seg_len   = std::max(max_seg_len, s.nslab * g.slab_len);
+        max_seg_nbyte = std::max<size_t>(max_seg_nbyte, s.nbyte);
+    }
+    auto const alloc_len = (size_t)(max_seg_len * 1.03) + 1;
+
+    std::vector<BYTE> h_in[2] = {std::vector<BYTE>(max_seg_nbyte), std::vector<BYTE>(max_seg_nbyte)};
+    std::vector<T>    h_out(alloc_len);
+#ifdef CUSZ_HOST_ONLY
+    if (policy == CUDA) throw std::runtime_error("[stream] This build has no CUDA backend; use the host policy.");
+#else
+    BYTE* d_in{nullptr};
+    T*    d_out{nullptr};
+    if (policy == CUDA) {
+        CHECK_CUDA(cudaMalloc(&d_in, max_seg_nbyte));
+        CHECK_CUDA(cudaMalloc(&d_out, sizeof(T) * alloc_len));
+    }
+#endif
+
+    std::unique_ptr<Compressor> body, tail;
+
+    auto read_ahead = [&](int k) {
+        return std::async(std::launch::async, [&, k]() {
+            ifs.seekg(segs[k].offset);
+            ifs.read(reinterpret_cast<char*>(h_in[k % 2].data()), segs[k].nbyte);
+            if (not ifs) throw std::runtime_error("[stream] failed to read a segment.");
+        });
+    };
+
+    size_t total_len = 0;
+    auto   pending   = read_ahead(0);
+    for (auto k = 0; k < (int)segs.size(); k++) {
+        pending.get();
+        if (k + 1 < (int)segs.size()) pending = read_ahead(k + 1);
+
+        Header seg_header;
+        memcpy(&seg_header, h_in[k % 2].data(), sizeof(Header));
+        auto len = ConfigHelper::get_uncompressed_len(&seg_header);
+
+        auto& compressor = segs[k].nslab == segs[0].nslab ? body : tail;
+        if (not compressor) {
+            compressor.reset(new Compressor);
+            compressor->init(&seg_header, false, policy);
+        }
+
+#ifndef CUSZ_HOST_ONLY
+        if (policy == CUDA) {
+            CHECK_CUDA(cudaMemcpy(d_in, h_in[k % 2].data(), segs[k].nbyte, cudaMemcpyHostToDevice));
+            compressor->decompress(&seg_header, d_in, d_out, stream, false);
+            CHECK_CUDA(cudaMemcpy(h_out.data(), d_out, sizeof(T) * len, cudaMemcpyDeviceToHost));
+        }
+        else
+#endif
+        {
+            compressor->decompress(&seg_header, h_in[k % 2].data(), h_out.data(), stream, false);
+        }
+
+        if (ofs.is_open()) ofs.write(reinterpret_cast<char*>(h_out.data()), sizeof(T) * len);
+        total_len += len;
+    }
+
+#ifndef CUSZ_HOST_ONLY
+    if (d_in) cudaFree(d_in);
+    if (d_out) cudaFree(d_out);
+#endif
+
+    return total_len;
+}
+
+namespace cusz {
+
+using fp32lorenzo    = Framework<float>::LorenzoFeaturedCompressor;
+using fp32lorenzoii  = Framework<float>::LorenzoIIFeaturedCompressor;
+using fp32regression = Framework<float>::RegressionFeaturedCompressor;
+using fp32spline3    = Framework<float>::Spline3FeaturedCompressor;
+
+template size_t stream_compress<fp32lorenzo, float>(Context*, std::string const&, std::string const&, size_t const, cudaStream_t);
+template size_t stream_decompress<fp32lorenzo, float>(std::string const&, std::string const&, cusz_execution_policy, cudaStream_t);
+
+template size_t stream_compress<fp32lorenzoii, float>(Context*, std::string const&, std::string const&, size_t const, cudaStream_t);
+template size_t stream_decompress<fp32lorenzoii, float>(std::string const&, std::string const&, cusz_execution_policy, cudaStream_t);
+
+template size_t stream_compress<fp32regression, float>(Context*, std::string const&, std::string const&, size_t const, cudaStream_t);
+template size_t stream_decompress<fp32regression, float>(std::string const&, std::string const&, cusz_execution_policy, cudaStream_t);
+
+template size_t stream_compress<fp32spline3, float>(Context*, std::string const&, std::string const&, size_t const, cudaStream_t);
+template size_t stream_decompress<fp32spline3, float>(std::string const&, std::string const&, cusz_execution_policy, cudaStream_t);
+
+}  // namespace cusz
@@ -0,0 +1,207 @@
+/**
+ * @file mempool.cc
+ * @author Jiannan Tian
+ * @brief
+ * @version 0.3
+ * @date 2022-12-20
+ *
+ * (C) 2022 by Indiana University, Argonne National Laboratory
+ *
+ */
+
+#include "utils/mempool.hh"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <stdexcept>
+
+#ifndef CUSZ_HOST_ONLY
+#include <cuda_runtime.h>
+#include "utils/cuda_err.cuh"
+#endif
+
+namespace {
+
+char const* kind_name[] = {"device", "host (pinned)", "host (pageable)"};
+
+std::atomic<cusz::memory_resource*> current_resource{nullptr};
+
+}  // namespace
+
+void* cusz::memory_resource::system_allocate(size_t nbyte, memkind kind)
+{
+    void* ptr{nullptr};
+#ifndef CUSZ_HOST_ONLY
+    if (kind == memkind::DEVICE)
+        CHECK_CUDA(cudaMalloc(&ptr, nbyte));
+    else if (kind == memkind::HOST_PINNED)
+        CHECK_CUDA(cudaMallocHost(&ptr, nbyte));
+    else
+        ptr = malloc(nbyte);
+#else
+    // without CUDA, pinning has no meaning and pinned memory is plain host memory
+    if (kind == memkind::DEVICE) throw std::runtime_error("Device memory requested from a host-only build.");
+    ptr = malloc(nbyte);
+#endif
+
+    if (ptr == nullptr) throw std::bad_alloc();
+    return ptr;
+}
+
+void cusz::memory_resource::system_deallocate(void* ptr, memkind kind)
+{
+#ifndef CUSZ_HOST_ONLY
+    if (kind == memkind::DEVICE)
+        cudaFree(ptr);
+    else if (kind == memkind::HOST_PINNED)
+        cudaFreeHost(ptr);
+    else
+        free(ptr);
+#else
+    (void)kind;  // whatever was asked for is plain host memory
+    free(ptr);
+#endif
+}
+
+void cusz::memory_resource::note_system_release(size_t nbyte, memkind kind)
+{
+    stats[(int)kind].reserved_nbyte -= nbyte;
+}
+
+void* cusz::memory_resource::allocate(size_t nbyte, memkind kind)
+{
+    if (nbyte == 0) return nullptr;
+
+    std::lock_guard<std::mutex> lock(mtx);
+
+    size_t nbyte_system = 0;
+    auto   ptr          = do_allocate(nbyte, kind, nbyte_system);
+    live[ptr]           = nbyte;
+
+    auto& s = stats[(int)kind];
+    s.inuse_nbyte += nbyte;
+    s.peak_nbyte = std::max(s.peak_nbyte, s.inuse_nbyte);
+    s.reserved_nbyte += nbyte_system;
+    s.nalloc_system += nbyte_system != 0;
+    s.nalloc += 1;
+
+    return ptr;
+}
+
+void cusz::memory_resource::deallocate(void* ptr, memkind kind)
+{
+    if (ptr == nullptr) return;
+
+    std::lock_guard<std::mutex> lock(mtx);
+
+    auto it = live.find(ptr);
+    if (it == live.end()) throw std::runtime_error("[memory_resource] deallocating a block it does not own.");
+
+    auto nbyte = it->second;
+    live.erase(it);
+
+    auto& s = stats[(int)kind];
+    s.inuse_nbyte -= nbyte;
+    s.reserved_nbyte -= do_deallocate(ptr, nbyte, kind);
+}
+
+cusz::memory_resource::stat cusz::memory_resource::get_stat(memkind kind) const
+{
+    std::lock_guard<std::mutex> lock(mtx);
+    return stats[(int)kind];
+}
+
+void cusz::memory_resource::reset_peak()
+{
+    std::lock_guard<std::mutex> lock(mtx);
+    for (auto& s : stats) s.peak_nbyte = s.inuse_nbyte;
+}
+
+void cusz::memory_resource::print_stat() const
+{
+    printf("\n%-18s %14s %14s %14s %8s %8s\n", "memory", "in use", "peak", "reserved", "#alloc", "#system");
+    for (auto i = 0; i < NKIND; i++) {
+        auto s = get_stat((memkind)i);
+        printf(
+            "%-18s %14zu %14zu %14zu %8zu %8zu\n", kind_name[i], s.inuse_nbyte, s.peak_nbyte, s.reserved_nbyte,
+            s.nalloc, s.nalloc_system);
+    }
+}
+
+void* cusz::direct_resource::do_allocate(size_t nbyte, memkind kind, size_t& nbyte_system)
+{
+    nbyte_system = nbyte;
+    return system_allocate(nbyte, kind);
+}
+
+size_t cusz::direct_resource::do_deallocate(void* ptr, size_t nbyte, memkind kind)
+{
+    system_deallocate(ptr, kind);
+    return nbyte;
+}
+
+cusz::caching_pool::~caching_pool() { release(); }
+
+void cusz::caching_pool::drop_cached(memkind kind)
+{
+    auto& bucket = cached[(int)kind];
+    for (auto& entry : bucket) {
+        system_deallocate(entry.second, kind);
+        block_nbyte.erase(entry.second);
+        note_system_release(entry.first, kind);
+    }
+    bucket.clear();
+}
+
+void cusz::caching_pool::release()
+{
+    std::lock_guard<std::mutex> lock(mtx);
+    for (auto i = 0; i < NKIND; i++) drop_cached((memkind)i);
+}
+
+void* cusz::caching_pool::do_allocate(size_t nbyte, memkind kind, size_t& nbyte_system)
+{
+    auto const reserve = (nbyte + GRANULARITY - 1) / GRANULARITY * GRANULARITY;
+    auto&      bucket  = cached[(int)kind];
+
+    auto it = bucket.lower_bound(reserve);
+    if (it != bucket.end() and it->first <= reserve + reserve / 8) {
+        auto ptr = it->second;
+        bucket.erase(it);
+        nbyte_system = 0;
+        return ptr;
+    }
+
+    void* ptr;
+    try {
+        ptr = system_allocate(reserve, kind);
+    }
+    catch (...) {
+        if (bucket.empty()) throw;
+        // out of memory with blocks still cached: give them back and try once more
+        drop_cached(kind);
+        ptr = system_allocate(reserve, kind);
+    }
+
+    block_nbyte[ptr] = reserve;
+    nbyte_system     = reserve;
+    return ptr;
+}
+
+size_t cusz::caching_pool::do_deallocate(void* ptr, size_t, memkind kind)
+{
+    cached[(int)kind].emplace(block_nbyte.at(ptr), ptr);
+    return 0;
+}
+
+cusz::memory_resource* cusz::default_memory_resource()
+{
+    // never destroyed, so that components in static storage can still return their buffers at exit
+    static caching_pool* pool = new caching_pool;
+    return current_resource.load() ? current_resource.load() : pool;
+}
+
+void cusz::set_default_memory_resource(memory_resource* mem) { current_resource.store(mem); }
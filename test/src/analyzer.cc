@@ -0,0 +1,84 @@
+/**
+ * @file analyzer.cc
+ * @author Jiannan Tian
+ * @brief (host) Analyzer::percentile100 and select against a std::sort baseline, short and duplicate-heavy inputs
+ * included.
+ * @version 0.3
+ * @date 2022-12-30
+ *
+ * (C) 2022 by Indiana University, Argonne National Laboratory
+ *
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "cli/analyzer.hh"
+
+// every len/100-th smallest value, then the largest, as percentile100 documents it
+template <typename T>
+std::vector<T> baseline(std::vector<T> sorted)
+{
+    std::sort(sorted.begin(), sorted.end());
+
+    std::vector<T> res;
+    auto const     len  = sorted.size();
+    auto const     step = std::max(len / 100, (size_t)1);
+    for (size_t i = 0; i < len; i += step) res.push_back(sorted[i]);
+    if (len) res.push_back(sorted[len - 1]);
+    return res;
+}
+
+// `ndistinct` distinct values in random order, so most values repeat when it is small
+template <typename T>
+std::vector<T> make(size_t len, int ndistinct, unsigned seed)
+{
+    std::mt19937                    gen(seed);
+    std::uniform_int_distribution<> pick(0, ndistinct - 1);
+
+    std::vector<T> a(len);
+    for (auto& v : a) v = (T)(pick(gen) - ndistinct / 2) * (T)3;
+    return a;
+}
+
+template <typename T>
+bool f(char const* type, size_t len, int ndistinct)
+{
+    auto a        = make<T>(len, ndistinct, 0x5eed + len);
+    auto expected = baseline(a);
+
+    auto scratch    = a;
+    auto percentile = Analyzer::percentile100<T>(scratch.data(), len);
+
+    // ranks out of order, repeated and past the end (clamped)
+    auto ranks = std::vector<size_t>{len / 2, 0, len / 2, len + 5, len ? len - 1 : 0, len / 3};
+    auto picks = Analyzer::select<T>(a.data(), len, ranks);
+
+    auto sorted = a;
+    std::sort(sorted.begin(), sorted.end());
+    auto picked_ok = picks.size() == (len ? ranks.size() : 0);
+    for (auto i = 0u; picked_ok and i < picks.size(); i++) picked_ok = picks[i] == sorted[std::min(ranks[i], len - 1)];
+
+    auto ok = percentile == expected and picked_ok;
+    printf(
+        "%-7slen %-9zu%-8d distinct:\tpercentile100 %s, select %s\n", type, len, ndistinct,
+        percentile == expected ? "ok" : "DIFFERS", picked_ok ? "ok" : "DIFFERS");
+    return ok;
+}
+
+int main()
+{
+    auto all_pass = true;
+
+    // shorter than 100 (step 1), around 100, and long enough for select_ranks to fork (> 2^16 per part)
+    for (auto len : {0ul, 1ul, 7ul, 99ul, 100ul, 101ul, 12345ul, 1000003ul}) {
+        all_pass = f<float>("float", len, 1) and all_pass;
+        all_pass = f<float>("float", len, 5) and all_pass;
+        all_pass = f<float>("float", len, 1 << 20) and all_pass;
+        all_pass = f<int>("int", len, 37) and all_pass;
+    }
+
+    return all_pass ? 0 : -1;
+}
@@ -0,0 +1,124 @@
+/**
+ * @file batch.cc
+ * @author Jiannan Tian
+ * @brief (host) round trip of multi-field archives with mixed shapes, into outputs that were not zeroed; LorenzoII
+ * refuses error bounds its residuals are not exact at.
+ * @version 0.3
+ * @date 2022-12-30
+ *
+ * (C) 2022 by Indiana University, Argonne National Laboratory
+ *
+ */
+
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "batch.hh"
+#include "context.hh"
+#include "framework.hh"
+#include "rand.hh"
+#include "stat/compare_cpu.hh"
+
+using T          = float;
+using BYTE       = uint8_t;
+using synth_kind = parsz::testutils::synth_kind;
+using shape      = std::array<size_t, 3>;
+
+template <class Compressor>
+bool f(char const* name, std::vector<shape> const& shapes)
+{
+    double const rel_eb = 1e-3;
+    auto const   nfield = shapes.size();
+
+    std::vector<std::vector<T>> data(nfield), xdata(nfield);
+    std::vector<T*>             fields(nfield), xfields(nfield);
+    std::vector<cusz::Context>  configs(nfield);
+
+    for (auto i = 0u; i < nfield; i++) {
+        auto x   = shapes[i][0], y = shapes[i][1], z = shapes[i][2];
+        auto len = x * y * z;
+
+        // inputs and outputs are read/written past the data length; see core_compress
+        data[i].resize((size_t)(len * 1.03) + 1);
+        xdata[i].assign((size_t)(len * 1.03) + 1, (T)-1234.5);  // deliberately not zeroed
+        parsz::testutils::synth_field<T>(data[i].data(), x, y, z, i % 2 ? synth_kind::NOISY : synth_kind::SMOOTH);
+
+        fields[i]  = data[i].data();
+        xfields[i] = xdata[i].data();
+
+        configs[i].set_len(x, y, z).set_eb(rel_eb).set_policy(CPU);
+        configs[i].mode = "r2r";
+    }
+
+    std::vector<BYTE> archive;
+    cusz::compress_batch<Compressor, T>(configs.data(), fields.data(), nfield, archive);
+    cusz::decompress_batch<Compressor, T>(archive.data(), archive.size(), xfields.data(), CPU);
+
+    auto all_pass = cusz::BatchHelper::is_batch_archive(archive.data(), archive.size()) and
+                    cusz::BatchHelper::get_nfield(archive.data()) == nfield;
+
+    for (auto i = 0u; i < nfield; i++) {
+        auto x   = shapes[i][0], y = shapes[i][1], z = shapes[i][2];
+        auto len = x * y * z;
+
+        auto minmax = std::minmax_element(data[i].begin(), data[i].begin() + len);
+        auto eb     = rel_eb * ((double)*minmax.second - *minmax.first);
+
+        size_t first_faulty = 0;
+        // with a little slack for the fp32 arithmetic of prediction
+        auto bounded = parsz::cppstd_error_bounded<T>(xdata[i].data(), data[i].data(), len, eb * 1.01, &first_faulty);
+
+        printf("%-12s field %u, %zu x %zu x %zu:\t%s\n", name, i, x, y, z, bounded ? "ok" : "NOT error bounded");
+        if (not bounded) printf("             first faulty index: %zu\n", first_faulty);
+        all_pass = all_pass and bounded;
+    }
+
+    return all_pass;
+}
+
+// whether LorenzoII refuses a bound so small that its residuals (4^d times the prequantized values) are past the
+// integers exact in float, rather than writing an archive that does not decompress to within it
+bool imprecise(size_t x, size_t y, size_t z, double rel_eb)
+{
+    std::vector<T> data((size_t)(x * y * z * 1.03) + 1);
+    parsz::testutils::synth_field<T>(data.data(), x, y, z, synth_kind::NOISY);
+
+    cusz::Context config;
+    config.set_len(x, y, z).set_eb(rel_eb).set_policy(CPU);
+    config.mode = "r2r";
+
+    auto              field = data.data();
+    std::vector<BYTE> archive;
+
+    auto refused = false;
+    try {
+        cusz::compress_batch<cusz::Framework<T>::LorenzoIIFeaturedCompressor, T>(&config, &field, 1, archive);
+    }
+    catch (std::runtime_error const& e) {
+        refused = std::string(e.what()).find("not exact") != std::string::npos;
+    }
+
+    printf("%-12s %zu x %zu x %zu, eb %.0e:\t%s\n", "lorenzo-ii", x, y, z, rel_eb, refused ? "ok" : "NOT refused");
+    return refused;
+}
+
+int main()
+{
+    // shapes change from field to field and come back, so compressors are both reused and replaced
+    auto shapes = std::vector<shape>{{64, 48, 40}, {500, 300, 1}, {64, 48, 40}, {100000, 1, 1}, {500, 300, 1}};
+
+    auto all_pass = true;
+    all_pass      = f<cusz::Framework<T>::LorenzoFeaturedCompressor>("lorenzo", shapes) and all_pass;
+    all_pass      = f<cusz::Framework<T>::LorenzoIIFeaturedCompressor>("lorenzo-ii", shapes) and all_pass;
+    all_pass      = f<cusz::Framework<T>::RegressionFeaturedCompressor>("regression", shapes) and all_pass;
+
+    all_pass = imprecise(64, 48, 40, 1e-9) and all_pass;
+    all_pass = imprecise(100000, 1, 1, 1e-9) and all_pass;
+
+    return all_pass ? 0 : -1;
+}
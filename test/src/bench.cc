@@ -0,0 +1,215 @@
+/**
+ * @file bench.cc
+ * @author Jiannan Tian
+ * @brief Compression ratio, quality and per-stage throughput of the host pipeline on synthetic fields, as JSON.
+ * @version 0.3
+ * @date 2022-12-21
+ *
+ * (C) 2022 by Indiana University, Argonne National Laboratory
+ *
+ */
+
+#include <omp.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "compressor.hh"
+#include "context.hh"
+#include "framework.hh"
+#include "header.h"
+#include "rand.hh"
+#include "stat/compare_cpu.hh"
+#include "utils/mempool.hh"
+
+using T          = float;
+using Compressor = cusz::Framework<T>::LorenzoFeaturedCompressor;
+using BYTE       = uint8_t;
+using synth_kind = parsz::testutils::synth_kind;
+
+namespace {
+
+struct bench_case {
+    char const* field;
+    synth_kind  kind;
+    size_t      x, y, z;
+};
+
+// best of NREP after one warm-up run, which also fills the memory pool
+constexpr int    NREP   = 3;
+constexpr double REL_EB = 1e-4;
+
+double GiBps(size_t nbyte, double ms) { return ms > 0 ? nbyte / 1073741824.0 / (ms / 1e3) : 0; }
+
+// JSON has no inf/nan, e.g., PSNR of a lossless reconstruction
+std::string number(double v)
+{
+    if (not std::isfinite(v)) return "null";
+    std::stringstream s;
+    s << v;
+    return s.str();
+}
+
+template <typename F>
+double wall_ms(F f)
+{
+    auto a = std::chrono::steady_clock::now();
+    f();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - a).count();
+}
+
+// stage name -> best time (ms), in pipeline order
+struct stage_times {
+    std::vector<std::pair<std::string, double>> ms;
+
+    void update(Compressor::TimeRecord const& rec)
+    {
+        for (auto const& r : rec) {
+            auto name = std::string(std::get<0>(r));
+            auto it   = std::find_if(ms.begin(), ms.end(), [&](auto const& s) { return s.first == name; });
+            if (it == ms.end())
+                ms.push_back({name, std::get<1>(r)});
+            else
+                it->second = std::min(it->second, std::get<1>(r));
+        }
+    }
+
+    void to_json(std::ostream& o, size_t nbyte, double total_ms) const
+    {
+        o << "{";
+        for (auto const& s : ms)
+            o << "\"" << s.first << "\": {\"ms\": " << s.second << ", \"GiBps\": " << GiBps(nbyte, s.second) << "}, ";
+        o << "\"total\": {\"ms\": " << total_ms << ", \"GiBps\": " << GiBps(nbyte, total_ms) << "}}";
+    }
+};
+
+size_t peak_nbyte()
+{
+    auto   mem = cusz::default_memory_resource();
+    size_t sum = 0;
+    for (auto k : {cusz::memkind::DEVICE, cusz::memkind::HOST_PINNED, cusz::memkind::HOST_PAGEABLE})
+        sum += mem->get_stat(k).peak_nbyte;
+    return sum;
+}
+
+bool run(bench_case const& c, std::ostream& o)
+{
+    auto const len  = c.x * c.y * c.z;
+    auto const ndim = c.z > 1 ? 3 : (c.y > 1 ? 2 : 1);
+
+    // inputs and outputs are read/written past the data length; see core_compress
+    std::vector<T> data((size_t)(len * 1.03) + 1), xdata((size_t)(len * 1.03) + 1);
+    parsz::testutils::synth_field<T>(data.data(), c.x, c.y, c.z, c.kind);
+
+    auto minmax = std::minmax_element(data.begin(), data.begin() + len);
+    auto range  = (double)*minmax.second - *minmax.first;
+
+    cusz::Context ctx;
+    ctx.set_len(c.x, c.y, c.z).set_eb(REL_EB * range).set_policy(CPU);
+    cusz::CompressorHelper::autotune_coarse_parvle(&ctx);
+
+    cusz::default_memory_resource()->reset_peak();
+
+    // compression
+    Compressor             compressor;
+    Compressor::TimeRecord rec;
+    stage_times            comp;
+    BYTE*                  compressed;
+    size_t                 compressed_len;
+    double                 comp_ms = 1e30;
+
+    compressor.init(&ctx);
+    for (auto r = 0; r <= NREP; r++) {
+        auto ms = wall_ms([&]() { compressor.compress(&ctx, data.data(), compressed, compressed_len); });
+        if (r == 0) continue;
+
+        compressor.export_timerecord(&rec);
+        comp.update(rec);
+        comp_ms = std::min(comp_ms, ms);
+    }
+
+    cusz::Header header;
+    compressor.export_header(header);
+    std::vector<BYTE> archive(compressed, compressed + compressed_len);
+
+    // decompression
+    Compressor  decompressor;
+    stage_times decomp;
+    double      decomp_ms = 1e30;
+
+    // every repetition decompresses into a stale, nonzero output and is checked on its own
+    size_t first_faulty = 0;
+    auto   bounded      = true;
+
+    decompressor.init(&header, false, CPU);
+    for (auto r = 0; r <= NREP; r++) {
+        std::fill(xdata.begin(), xdata.end(), (T)(r + 1) * (T)range);
+
+        auto ms = wall_ms([&]() { decompressor.decompress(&header, archive.data(), xdata.data(), nullptr, false); });
+
+        // with a little slack for the fp32 arithmetic of prediction
+        if (bounded)
+            bounded = parsz::cppstd_error_bounded<T>(xdata.data(), data.data(), len, ctx.eb * 1.01, &first_faulty);
+        if (r == 0) continue;
+
+        decompressor.export_timerecord(&rec);
+        decomp.update(rec);
+        decomp_ms = std::min(decomp_ms, ms);
+    }
+
+    cusz_stats stat;
+    parsz::cppstd_assess_quality<T>(&stat, xdata.data(), data.data(), len);
+
+    o << "    {\"field\": \"" << c.field << "\", \"ndim\": " << ndim << ", \"len\": [" << c.x << ", " << c.y << ", "
+      << c.z << "], \"rel_eb\": " << REL_EB << ",\n";
+    o << "     \"compress\": ";
+    comp.to_json(o, len * sizeof(T), comp_ms);
+    o << ",\n     \"decompress\": ";
+    decomp.to_json(o, len * sizeof(T), decomp_ms);
+    o << ",\n     \"cr\": " << 1.0 * len * sizeof(T) / compressed_len << ", \"psnr\": " << number(stat.reduced.PSNR)
+      << ", \"max_abs_err\": " << stat.max_err.abs << ", \"error_bounded\": " << (bounded ? "true" : "false")
+      << ", \"peak_nbyte\": " << peak_nbyte() << "}";
+
+    if (not bounded)
+        fprintf(stderr, "[cusz-bench] %s %dD: not error bounded at index %zu\n", c.field, ndim, first_faulty);
+    return bounded;
+}
+
+}  // namespace
+
+int main(int argc, char** argv)
+{
+    // cusz-bench [output.json] [scale]; scale multiplies the slowest dimension
+    auto const out_fname = argc > 1 ? std::string(argv[1]) : std::string("cusz-bench.json");
+    auto const scale     = argc > 2 ? std::max(1, atoi(argv[2])) : 1;
+
+    std::vector<bench_case> cases;
+    for (auto f : {std::make_pair("smooth", synth_kind::SMOOTH), std::make_pair("noisy", synth_kind::NOISY),
+                   std::make_pair("sparse", synth_kind::SPARSE)}) {
+        cases.push_back({f.first, f.second, (size_t)(1 << 21) * scale, 1, 1});
+        cases.push_back({f.first, f.second, 1536, (size_t)1024 * scale, 1});
+        cases.push_back({f.first, f.second, 128, 128, (size_t)128 * scale});
+    }
+
+    std::stringstream o;
+    o << "{\"policy\": \"host\", \"nthread\": " << omp_get_max_threads() << ", \"nrep\": " << NREP
+      << ",\n \"cases\": [\n";
+
+    auto pass = true;
+    for (auto i = 0u; i < cases.size(); i++) {
+        pass = run(cases[i], o) and pass;
+        o << (i + 1 < cases.size() ? ",\n" : "\n");
+    }
+    o << "]}\n";
+
+    printf("%s", o.str().c_str());
+    std::ofstream(out_fname) << o.str();
+
+    return pass ? 0 : 1;
+}
@@ -0,0 +1,174 @@
+/**
+ * @file capi.cc
+ * @author Jiannan Tian
+ * @brief (host) the C API: archives decompress with the predictor they were compressed with, whatever the handle's,
+ * and which a version-1 header does not tell; a handle reuses its buffers for fields of the same shape.
+ * @version 0.3
+ * @date 2022-12-30
+ *
+ * (C) 2022 by Indiana University, Argonne National Laboratory
+ *
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+#include "cusz.h"
+#include "rand.hh"
+#include "stat/compare_cpu.hh"
+
+using T          = float;
+using BYTE       = uint8_t;
+using synth_kind = parsz::testutils::synth_kind;
+
+constexpr size_t X = 500, Y = 300, LEN = X * Y;
+cusz_len const   LEN3 = cusz_len{X, Y, 1, 1, 1.03};
+
+cusz_framework* host_framework(cusz_predictortype predictor)
+{
+    auto framework            = cusz_default_framework();
+    framework->predictor.type = predictor;
+    framework->execution      = Host;
+    return framework;
+}
+
+// the archive, and its header, as compressed by `comp`
+std::vector<BYTE>
+compress(cusz_compressor* comp, std::vector<T>& data, cusz_len const len, double rel_eb, cusz_header& header)
+{
+    auto config = cusz_config{.eb = rel_eb, .mode = Rel};
+
+    BYTE*  compressed;
+    size_t compressed_len;
+    cusz_compress(comp, &config, data.data(), len, &compressed, &compressed_len, &header, nullptr, nullptr);
+
+    // what the handle exposed is released with it, or at its next compression
+    return std::vector<BYTE>(compressed, compressed + compressed_len);
+}
+
+// the archive, and its header, as compressed by a new handle
+std::vector<BYTE> compress(cusz_framework* framework, std::vector<T>& data, double rel_eb, cusz_header& header)
+{
+    auto comp    = cusz_create(framework, FP32);
+    auto archive = compress(comp, data, LEN3, rel_eb, header);
+    cusz_release(comp);
+    return archive;
+}
+
+// whether decompression by a new handle throws; otherwise, the output
+bool decompress(
+    cusz_framework*   framework,
+    cusz_header       header,
+    std::vector<BYTE> archive,
+    std::vector<T>&   xdata,
+    cusz_len const    len = LEN3)
+{
+    memcpy(archive.data(), &header, sizeof(header));
+
+    auto comp  = cusz_create(framework, FP32);
+    auto threw = false;
+    try {
+        cusz_decompress(comp, &header, archive.data(), archive.size(), xdata.data(), len, nullptr, nullptr);
+    }
+    catch (std::runtime_error const&) {
+        threw = true;
+    }
+    cusz_release(comp);
+    return threw;
+}
+
+// one handle, committed once, for several fields of one shape, then of another: init() only when the shape changes
+bool persistent(cusz_framework* framework, std::vector<T>& data, std::vector<T>& xdata)
+{
+    auto comp     = cusz_create(framework, FP32);
+    auto all_pass = cusz_commit_space(comp, LEN3, nullptr) == CUSZ_SUCCESS and comp->num_init == 1;
+
+    auto other = cusz_len{X / 2, Y * 2, 1, 1, 1.03};  // as long, of another shape
+
+    struct {
+        cusz_len len;
+        size_t   num_init;
+    } steps[] = {{LEN3, 1}, {LEN3, 1}, {LEN3, 1}, {other, 2}, {other, 2}, {LEN3, 3}};
+
+    auto i = 0;
+    for (auto const& step : steps) {
+        // a field of its own each time
+        for (auto& v : data) v += (T)1;
+
+        cusz_header header;
+        auto        archive = compress(comp, data, step.len, 1e-3, header);
+
+        auto minmax = std::minmax_element(data.begin(), data.begin() + LEN);
+        auto eb     = 1e-3 * ((double)*minmax.second - *minmax.first);
+
+        size_t first_faulty = 0;
+        auto   threw        = decompress(framework, header, archive, xdata, step.len);
+        auto   bounded      = parsz::cppstd_error_bounded<T>(xdata.data(), data.data(), LEN, eb * 1.01, &first_faulty);
+        auto   same_shape   = header.x == step.len.x and header.y == step.len.y;
+
+        printf(
+            "persistent handle, field %d, %zu x %zu: init %zu time(s) %s, %s\n", i++, step.len.x, step.len.y,
+            comp->num_init, comp->num_init == step.num_init ? "ok" : "FAILED",
+            not threw and bounded and same_shape ? "ok" : "NOT error bounded");
+        all_pass = all_pass and comp->num_init == step.num_init and not threw and bounded and same_shape;
+    }
+
+    cusz_release(comp);
+    return all_pass;
+}
+
+int main()
+{
+    // inputs and outputs are read/written past the data length; see core_compress
+    std::vector<T> data((size_t)(LEN * 1.03) + 1), expected(data.size()), xdata(data.size());
+    parsz::testutils::synth_field<T>(data.data(), X, Y, 1, synth_kind::NOISY);
+
+    auto all_pass = true;
+    auto check    = [&](char const* what, bool ok) {
+        printf("%-52s%s\n", what, ok ? "ok" : "FAILED");
+        all_pass = all_pass and ok;
+    };
+
+    auto minmax = std::minmax_element(data.begin(), data.begin() + LEN);
+    auto eb     = 1e-3 * ((double)*minmax.second - *minmax.first);
+
+    auto lorenzo = host_framework(LorenzoI);
+
+    cusz_header header;
+    auto        archive = compress(lorenzo, data, 1e-3, header);
+    check("Lorenzo: decompresses", not decompress(lorenzo, header, archive, expected));
+
+    // with a little slack for the fp32 arithmetic of prediction
+    size_t first_faulty = 0;
+    auto   bounded      = parsz::cppstd_error_bounded<T>(expected.data(), data.data(), LEN, eb * 1.01, &first_faulty);
+    check("Lorenzo: error bounded", bounded);
+
+    // version 1: no magic, and whatever was left where `predictor` is now
+    for (auto left : {LorenzoII, Spline3, Regression}) {
+        auto v1 = header;
+        memset(v1.magic, 0xff, sizeof(v1.magic));
+        v1.version   = 2;
+        v1.predictor = left;
+
+        std::fill(xdata.begin(), xdata.end(), (T)-1234.5);
+        auto threw = decompress(lorenzo, v1, archive, xdata);
+        auto same  = std::equal(xdata.begin(), xdata.begin() + LEN, expected.begin());
+        check("version 1: predictor not read, same output", not threw and same);
+    }
+
+    // the predictor is read from the archive, not the framework of the decompressing handle
+    auto lorenzo_ii = host_framework(LorenzoII);
+    archive         = compress(lorenzo_ii, data, 1e-3, header);
+    check("LorenzoII: decompresses", not decompress(lorenzo, header, archive, xdata));
+    bounded = parsz::cppstd_error_bounded<T>(xdata.data(), data.data(), LEN, eb * 1.01, &first_faulty);
+    check("LorenzoII: error bounded", bounded);
+
+    all_pass = persistent(lorenzo, data, xdata) and all_pass;
+
+    delete lorenzo_ii;
+    delete lorenzo;
+    return all_pass ? 0 : -1;
+}
@@ -0,0 +1,98 @@
+/**
+ * @file header.cc
+ * @author Jiannan Tian
+ * @brief (host) archive header versions: fields a version does not have are not read, newer versions are rejected.
+ * @version 0.3
+ * @date 2022-12-30
+ *
+ * (C) 2022 by Indiana University, Argonne National Laboratory
+ *
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+#include "compressor.hh"
+#include "context.hh"
+#include "framework.hh"
+#include "header.h"
+#include "rand.hh"
+
+using T          = float;
+using BYTE       = uint8_t;
+using synth_kind = parsz::testutils::synth_kind;
+
+constexpr size_t X = 500, Y = 300, LEN = X * Y;
+
+// whether decompression with `Compressor` throws; otherwise, the output
+template <class Compressor>
+bool decompress(cusz::Header header, std::vector<BYTE> archive, std::vector<T>& xdata)
+{
+    memcpy(archive.data(), &header, sizeof(header));
+    try {
+        Compressor decompressor;
+        decompressor.init(&header, false, CPU);
+        decompressor.decompress(&header, archive.data(), xdata.data(), nullptr, false);
+    }
+    catch (std::runtime_error const&) {
+        return true;
+    }
+    return false;
+}
+
+int main()
+{
+    using Lorenzo    = cusz::Framework<T>::LorenzoFeaturedCompressor;
+    using Regression = cusz::Framework<T>::RegressionFeaturedCompressor;
+
+    // inputs and outputs are read/written past the data length; see core_compress
+    std::vector<T> data((size_t)(LEN * 1.03) + 1), expected(data.size()), xdata(data.size());
+    parsz::testutils::synth_field<T>(data.data(), X, Y, 1, synth_kind::NOISY);
+
+    auto minmax = std::minmax_element(data.begin(), data.begin() + LEN);
+
+    cusz::Context ctx;
+    ctx.set_len(X, Y, 1).set_eb(1e-3 * (*minmax.second - *minmax.first)).set_policy(CPU);
+    cusz::CompressorHelper::autotune_coarse_parvle(&ctx);
+
+    Lorenzo compressor;
+    BYTE*   compressed;
+    size_t  compressed_len;
+    compressor.init(&ctx);
+    compressor.compress(&ctx, data.data(), compressed, compressed_len);
+
+    cusz::Header header;
+    compressor.export_header(header);
+    std::vector<BYTE> archive(compressed, compressed + compressed_len);
+
+    auto all_pass = true;
+    auto check    = [&](char const* what, bool ok) {
+        printf("%-52s%s\n", what, ok ? "ok" : "FAILED");
+        all_pass = all_pass and ok;
+    };
+
+    check("header is 128 bytes", sizeof(cusz::Header) == 128);
+    check("written as the current version", header.get_version() == cusz::Header::VERSION);
+    check("decompresses", not decompress<Lorenzo>(header, archive, expected));
+
+    // version 1: no magic, and whatever was left where `predictor` is now
+    auto v1 = header;
+    memset(v1.magic, 0xff, sizeof(v1.magic));
+    v1.version   = 2;
+    v1.predictor = 0xf;
+    check("version 1: read as such", v1.get_version() == 1);
+    check(
+        "version 1: predictor not read, same output",
+        not decompress<Lorenzo>(v1, archive, xdata) and memcmp(xdata.data(), expected.data(), sizeof(T) * LEN) == 0);
+
+    check("current version: other predictor rejected", decompress<Regression>(header, archive, xdata));
+
+    auto newer    = header;
+    newer.version = cusz::Header::VERSION + 1;
+    check("newer version rejected", decompress<Lorenzo>(newer, archive, xdata));
+
+    return all_pass ? 0 : -1;
+}
@@ -0,0 +1,148 @@
+/**
+ * @file hf_book.cc
+ * @author Jiannan Tian
+ * @brief (host) Huffman output must not depend on what the codec encoded before, cached books included; in the
+ * opt-in approximate mode, a perturbed histogram reuses the cached book, unless the book lacks one of its symbols.
+ * @version 0.3
+ * @date 2022-12-30
+ *
+ * (C) 2022 by Indiana University, Argonne National Laboratory
+ *
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "hf/hf.hh"
+#include "hf/hf_book_cpu.hh"
+#include "hf/hf_bookcache.hh"
+
+using T     = uint16_t;
+using H     = uint32_t;
+using M     = uint32_t;
+using Codec = cusz::LosslessCodec<T, H, M>;
+using BYTE  = uint8_t;
+
+constexpr int    BOOKLEN = 1024;
+constexpr size_t MAXLEN  = 1 << 18;
+constexpr int    SUBLEN  = 4096;
+constexpr int    PARDEG  = (MAXLEN - 1) / SUBLEN + 1;
+
+// symbol `i` appears freq[i] times, in a fixed shuffled order
+std::vector<T> make_qcodes(std::vector<uint32_t> const& freq)
+{
+    std::vector<T> q;
+    for (auto i = 0u; i < freq.size(); i++) q.insert(q.end(), freq[i], (T)i);
+    std::shuffle(q.begin(), q.end(), std::mt19937(0x5eed));
+    return q;
+}
+
+std::vector<BYTE> encode(Codec& codec, std::vector<T>& q)
+{
+    std::vector<uint32_t> freq(BOOKLEN, 0);
+    for (auto v : q) freq[v]++;
+
+    BYTE*  out;
+    size_t out_len;
+    codec.build_codebook(freq.data(), BOOKLEN);
+    codec.encode(q.data(), q.size(), out, out_len);
+    return std::vector<BYTE>(out, out + out_len);
+}
+
+bool decodes_to(Codec& codec, std::vector<BYTE> archive, std::vector<T> const& q)
+{
+    std::vector<T> xq(q.size());
+    codec.decode(archive.data(), xq.data());
+    return xq == q;
+}
+
+// bell-shaped around the center bin, as quant-codes of a smooth field; `wobble` perturbs every bin by up to 5%
+std::vector<uint32_t> make_bell(double wobble)
+{
+    std::vector<uint32_t> freq(BOOKLEN, 0);
+    for (auto i = 412; i < 612; i++) {
+        auto x  = (i - 512) / 12.0;
+        freq[i] = std::lround(4000 * std::exp(-x * x / 2) * (1 + 0.05 * wobble * std::sin(i)));
+    }
+    return freq;
+}
+
+// whether a cache holding the book of `cached` hits for `freq`, and, if so, returns that very book
+bool hits(bool approximate, std::vector<uint32_t> cached, std::vector<uint32_t> freq)
+{
+    auto const book_nbyte    = sizeof(H) * BOOKLEN;
+    auto const revbook_nbyte = sizeof(H) * 2 * (sizeof(H) * 8) + sizeof(T) * BOOKLEN;
+
+    std::vector<BYTE> book(book_nbyte), revbook(revbook_nbyte), book_out(book_nbyte), revbook_out(revbook_nbyte);
+    float             time_book;
+    asz::hf_buildbook_cpu<T, H>(cached.data(), BOOKLEN, (H*)book.data(), revbook.data(), revbook_nbyte, &time_book);
+
+    asz::hf_bookcache                cache;
+    asz::hf_bookcache::fingerprint_t fp;
+    uint64_t                         hash;
+    cache.set_approximate(approximate);
+
+    cache.fingerprint(cached.data(), BOOKLEN, fp, hash);
+    cache.insert(fp, hash, book.data(), book_nbyte, revbook.data(), revbook_nbyte);
+
+    cache.fingerprint(freq.data(), BOOKLEN, fp, hash);
+    auto hit = cache.lookup(freq.data(), fp, hash, book_out.data(), book_nbyte, revbook_out.data(), revbook_nbyte);
+    return hit and book_out == book and revbook_out == revbook and cache.get_hits() == 1;
+}
+
+int main()
+{
+    // same support and same power-of-two bucket in every bin, but different optimal books
+    std::vector<uint32_t> freq_a(BOOKLEN, 0), freq_b(BOOKLEN, 0);
+    freq_a[512] = 16 << 12, freq_b[512] = 31 << 12;
+    for (auto i : {510, 511, 513, 514}) freq_a[i] = freq_b[i] = 8 << 12;
+
+    auto qa = make_qcodes(freq_a);
+    auto qb = make_qcodes(freq_b);
+
+    Codec fresh_a, fresh_b, reused;
+    for (auto c : {&fresh_a, &fresh_b, &reused}) c->init(MAXLEN, BOOKLEN, PARDEG, false, CPU);
+
+    auto expected_a = encode(fresh_a, qa);
+    auto expected_b = encode(fresh_b, qb);
+
+    auto all_pass = true;
+    auto check    = [&](char const* what, bool ok) {
+        printf("%-40s%s\n", what, ok ? "ok" : "FAILED");
+        all_pass = all_pass and ok;
+    };
+
+    check("a, then b, then a: same bytes as fresh", [&]() {
+        auto first_a  = encode(reused, qa);
+        auto b        = encode(reused, qb);
+        auto second_a = encode(reused, qa);
+        return first_a == expected_a and b == expected_b and second_a == expected_a;
+    }());
+    check("b decodes after a was encoded", decodes_to(reused, encode(reused, qb), qb));
+
+    // approximate mode: every bin moved, one dropped, one where the cached book has no codeword
+    auto bell = make_bell(0), perturbed = make_bell(1), uncovered = make_bell(1), shifted = make_bell(0);
+    perturbed[430] = 0;
+    uncovered[700] = 1;
+    std::rotate(shifted.begin(), shifted.begin() + 40, shifted.end());
+
+    check("exact: perturbed histogram misses", not hits(false, bell, perturbed));
+    check("approximate: perturbed histogram hits", hits(true, bell, perturbed));
+    check("approximate: uncovered symbol misses", not hits(true, bell, uncovered));
+    check("approximate: shifted histogram misses", not hits(true, bell, shifted));
+
+    Codec approx;
+    approx.init(MAXLEN, BOOKLEN, PARDEG, false, CPU);
+    approx.set_approximate_bookcache(true);
+
+    auto qbell = make_qcodes(bell), qperturbed = make_qcodes(perturbed), quncovered = make_qcodes(uncovered);
+    encode(approx, qbell);
+    check("approximate: reused book decodes", decodes_to(approx, encode(approx, qperturbed), qperturbed));
+    check("approximate: rebuilt book decodes", decodes_to(approx, encode(approx, quncovered), quncovered));
+
+    return all_pass ? 0 : -1;
+}
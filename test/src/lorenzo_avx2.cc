@@ -0,0 +1,144 @@
+/**
+ * @file lorenzo_avx2.cc
+ * @author Jiannan Tian
+ * @brief (host) the AVX2 Lorenzo kernels against v0: the same quant-codes and outliers, and reconstructions equal bit
+ * for bit, partial sums past 2^24 and partial tiles included.
+ * @version 0.3
+ * @date 2022-12-30
+ *
+ * (C) 2022 by Indiana University, Argonne National Laboratory
+ *
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+#include "kernel/detail/lorenzo_cpu_avx2.inl"
+#include "rand.hh"
+
+using T          = float;
+using E          = uint16_t;
+using synth_kind = parsz::testutils::synth_kind;
+
+#if PARSZ_CPU_AVX2
+
+namespace v0   = parsz::cpu::__kernel::v0;
+namespace avx2 = parsz::cpu::__kernel::avx2;
+
+struct outliers {
+    std::vector<T>        val;
+    std::vector<uint32_t> idx;
+    uint32_t              count{0};
+
+    explicit outliers(size_t len) : val(len), idx(len) {}
+    CompactionDRAM<T> sink() { return CompactionDRAM<T>{val.data(), idx.data(), &count, (uint32_t)val.size()}; }
+
+    // in index order; the kernels append in no particular one
+    std::vector<std::pair<uint32_t, T>> sorted() const
+    {
+        std::vector<std::pair<uint32_t, T>> pairs;
+        for (auto i = 0u; i < count; i++) pairs.emplace_back(idx[i], val[i]);
+        std::sort(pairs.begin(), pairs.end());
+        return pairs;
+    }
+};
+
+bool f(size_t x, size_t y, size_t z, double offset, double rel_eb, int radius, dim3 tile_lo, dim3 tile_hi)
+{
+    auto const len3  = dim3(x, y, z);
+    auto const leap3 = dim3(1, x, x * y);
+    auto const len   = x * y * z;
+    auto const d     = z > 1 ? 3 : (y > 1 ? 2 : 1);
+
+    std::vector<T> data(len);
+    parsz::testutils::synth_field<T>(data.data(), x, y, z, synth_kind::SMOOTH);
+
+    // offset by a fraction of the range, so that prequantized values straddle powers of two past 2^24, where float
+    // partial sums round depending on the order of addition
+    auto minmax = std::minmax_element(data.begin(), data.end());
+    auto rng    = (double)*minmax.second - *minmax.first;
+    for (auto& v : data) v += (T)(offset * rng);
+    auto eb = rel_eb * rng;
+    auto ebx2_r = (float)(1 / (eb * 2)), ebx2 = (float)(eb * 2);
+
+    std::vector<E> q0(len), q1(len);
+    outliers       o0(len), o1(len);
+
+    if (d == 1) {
+        v0::c_lorenzo_1d1l<T, E, float>(data.data(), len3, leap3, radius, ebx2_r, q0.data(), o0.sink());
+        avx2::c_lorenzo_1d1l<E>(data.data(), len3, leap3, radius, ebx2_r, q1.data(), o1.sink());
+    }
+    else if (d == 2) {
+        v0::c_lorenzo_2d1l<T, E, float>(data.data(), len3, leap3, radius, ebx2_r, q0.data(), o0.sink());
+        avx2::c_lorenzo_2d1l<E>(data.data(), len3, leap3, radius, ebx2_r, q1.data(), o1.sink());
+    }
+    else {
+        v0::c_lorenzo_3d1l<T, E, float>(data.data(), len3, leap3, radius, ebx2_r, q0.data(), o0.sink());
+        avx2::c_lorenzo_3d1l<E>(data.data(), len3, leap3, radius, ebx2_r, q1.data(), o1.sink());
+    }
+    auto same_construct = q0 == q1 and o0.sorted() == o1.sorted();
+
+    // reconstruct from v0's output, scattered as decompression does, into outputs of the same stale contents
+    std::vector<T> dense(len, 0), x0(len, (T)-1234.5), x1(len, (T)-1234.5);
+    for (auto i = 0u; i < o0.count; i++) dense[o0.idx[i]] = o0.val[i];
+
+    auto same_reconstruct = [&](dim3 lo, dim3 hi) {
+        if (d == 1) {
+            v0::x_lorenzo_1d1l<T, E, float>(q0.data(), dense.data(), len3, leap3, radius, ebx2, x0.data(), lo, hi);
+            avx2::x_lorenzo_1d1l<E>(q0.data(), dense.data(), len3, leap3, radius, ebx2, x1.data(), lo, hi);
+        }
+        else if (d == 2) {
+            v0::x_lorenzo_2d1l<T, E, float>(q0.data(), dense.data(), len3, leap3, radius, ebx2, x0.data(), lo, hi);
+            avx2::x_lorenzo_2d1l<E>(q0.data(), dense.data(), len3, leap3, radius, ebx2, x1.data(), lo, hi);
+        }
+        else {
+            v0::x_lorenzo_3d1l<T, E, float>(q0.data(), dense.data(), len3, leap3, radius, ebx2, x0.data(), lo, hi);
+            avx2::x_lorenzo_3d1l<E>(q0.data(), dense.data(), len3, leap3, radius, ebx2, x1.data(), lo, hi);
+        }
+        return memcmp(x0.data(), x1.data(), sizeof(T) * len) == 0;
+    };
+
+    // a range of tiles first (the rest stays stale in both), then the whole field
+    auto same_range = same_reconstruct(tile_lo, tile_hi);
+    auto same_full  = same_reconstruct(dim3(0, 0, 0), dim3(UINT32_MAX, UINT32_MAX, UINT32_MAX));
+
+    printf(
+        "%zu x %zu x %zu, offset %g, eb %.0e, radius %d, %u outliers:\tconstruct %s, reconstruct (tiles) %s, "
+        "reconstruct %s\n",
+        x, y, z, offset, rel_eb, radius, o0.count, same_construct ? "ok" : "DIFFERS", same_range ? "ok" : "DIFFERS",
+        same_full ? "ok" : "DIFFERS");
+    return same_construct and same_range and same_full;
+}
+
+int main()
+{
+    if (not avx2::supported()) {
+        printf("AVX2 not supported here; skipped\n");
+        return 0;
+    }
+
+    auto all_pass = true;
+
+    // partial sums far past 2^24 (offset, small bounds), exact ones, and sizes that are not multiples of the tiles
+    all_pass = f(1 << 20, 1, 1, 0.3, 3e-9, 512, dim3(3, 0, 0), dim3(21, 1, 1)) and all_pass;
+    all_pass = f(1000003, 1, 1, 0, 1e-3, 512, dim3(0, 0, 0), dim3(9, 1, 1)) and all_pass;
+    all_pass = f(1000, 900, 1, 0.3, 1e-9, 512, dim3(5, 7, 0), dim3(40, 30, 1)) and all_pass;
+    all_pass = f(1001, 777, 1, 0, 1e-3, 512, dim3(60, 40, 0), dim3(UINT32_MAX, UINT32_MAX, 1)) and all_pass;
+    all_pass = f(64, 64, 64, 0.3, 1e-9, 128, dim3(1, 2, 3), dim3(5, 6, 7)) and all_pass;
+    all_pass = f(61, 63, 65, 0, 1e-3, 512, dim3(7, 0, 6), dim3(8, 8, 9)) and all_pass;
+
+    return all_pass ? 0 : -1;
+}
+
+#else
+
+int main()
+{
+    printf("no AVX2 kernels in this build; skipped\n");
+    return 0;
+}
+
+#endif
@@ -47,7 +47,7 @@ bool f(size_t const x, size_t const y, size_t const z, double const error_bound,
     compress_predict_lorenzo_i<T, E, FP>(  //
         data, len3, error_bound, radius,   // input and config
         eq, dummy_len3, anchor, dummy_len3, outlier, outlier_idx,
-        nullptr,  // output
+        nullptr, 0,  // output
         &time, stream);
     cudaStreamSynchronize(stream);
 
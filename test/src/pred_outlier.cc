@@ -0,0 +1,124 @@
+/**
+ * @file pred_outlier.cc
+ * @author Jiannan Tian
+ * @brief (device) Lorenzo prediction with outliers compacted into a bounded buffer, under and over its capacity.
+ * @version 0.3
+ * @date 2022-12-30
+ *
+ * (C) 2022 by Indiana University, Argonne National Laboratory
+ *
+ */
+
+#include <cuda_runtime.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+#include "component/prediction.hh"
+#include "kernel/lorenzo_all.hh"
+#include "rand.hh"
+#include "stat/compare_cpu.hh"
+
+using T          = float;
+using E          = uint16_t;
+using FP         = float;
+using synth_kind = parsz::testutils::synth_kind;
+
+constexpr int      RADIUS   = 512;
+constexpr uint32_t SENTINEL = 0xdeadbeef;
+
+// run the compacting kernel with room for `cap` outliers; return the count it reports
+uint32_t compress(T* data, dim3 len3, double eb, E* eq, T* val, uint32_t* idx, uint32_t* num, uint32_t cap)
+{
+    float time;
+    compress_predict_lorenzo_i<T, E, FP>(
+        data, len3, eb, RADIUS, eq, dim3(0, 0, 0), nullptr, dim3(0, 0, 0), val, idx, num, cap, &time, nullptr);
+    cudaDeviceSynchronize();
+    return *num;
+}
+
+bool f(size_t x, size_t y, size_t z)
+{
+    auto const len3 = dim3(x, y, z);
+    auto const len  = x * y * z;
+
+    T *       data, *xdata, *dense, *val;
+    E*        eq;
+    uint32_t *idx, *num;
+    cudaMallocManaged(&data, sizeof(T) * len);
+    cudaMallocManaged(&xdata, sizeof(T) * len);
+    cudaMallocManaged(&dense, sizeof(T) * len);
+    cudaMallocManaged(&eq, sizeof(E) * len);
+    cudaMallocManaged(&val, sizeof(T) * len);
+    cudaMallocManaged(&idx, sizeof(uint32_t) * len);
+    cudaMallocManaged(&num, sizeof(uint32_t));
+
+    // spikes of a sparse field fall outside the quantization range
+    parsz::testutils::synth_field<T>(data, x, y, z, synth_kind::SPARSE);
+    auto minmax = std::minmax_element(data, data + len);
+    auto eb     = 1e-4 * ((double)*minmax.second - *minmax.first);
+
+    auto const nall = compress(data, len3, eb, eq, val, idx, num, len);
+
+    // under capacity: exactly enough room; scatter the pairs back and reconstruct
+    std::fill(idx, idx + len, SENTINEL);
+    auto const n_under = compress(data, len3, eb, eq, val, idx, num, nall);
+
+    memset(dense, 0x0, sizeof(T) * len);
+    for (auto i = 0u; i < n_under; i++) dense[idx[i]] = val[i];
+
+    float time;
+    decompress_predict_lorenzo_i<T, E, FP>(
+        eq, dim3(0, 0, 0), nullptr, dim3(0, 0, 0), dense, nullptr, 0, eb, RADIUS, xdata, len3, &time, nullptr);
+    cudaDeviceSynchronize();
+
+    size_t first_faulty = 0;
+    auto   under_ok     = nall > 0 and n_under == nall and idx[nall - 1] != SENTINEL;
+    under_ok            = under_ok and parsz::cppstd_error_bounded<T>(xdata, data, len, eb, &first_faulty);
+
+    // over capacity: every outlier is counted, none is written past the capacity
+    auto const cap = nall / 2;
+    std::fill(idx, idx + len, SENTINEL);
+    auto const n_over = compress(data, len3, eb, eq, val, idx, num, cap);
+
+    auto over_ok = n_over == nall and std::all_of(idx + cap, idx + len, [](auto i) { return i == SENTINEL; });
+
+    // and the predictor refuses to go on: one slot for the whole field
+    auto thrown = false;
+    try {
+        cusz::PredictionUnified<T, E, FP> predictor;
+        T *                               _anchor, *_outlier;
+        E*                                _errctrl;
+        uint32_t *                        _outlier_idx, _num_outliers;
+
+        predictor.set_outlier_density_factor(len);
+        predictor.init(LorenzoI, len3, false, CUDA);
+        predictor.construct(
+            LorenzoI, len3, data, &_anchor, &_errctrl, &_outlier, &_outlier_idx, &_num_outliers, eb, RADIUS, nullptr);
+    }
+    catch (std::runtime_error const&) {
+        thrown = true;
+    }
+
+    printf(
+        "%zu x %zu x %zu, %u outliers:\tunder capacity %s, over capacity %s, predictor %s\n", x, y, z, nall,
+        under_ok ? "ok" : "FAILED", over_ok ? "ok" : "FAILED", thrown ? "throws" : "DOES NOT THROW");
+
+    cudaFree(data), cudaFree(xdata), cudaFree(dense), cudaFree(eq), cudaFree(val), cudaFree(idx), cudaFree(num);
+
+    return under_ok and over_ok and thrown;
+}
+
+int main()
+{
+    auto all_pass = true;
+
+    // one case per compaction kernel (1D, 2D, 3D); sizes are not multiples of the tiles
+    all_pass = f(1000000, 1, 1) and all_pass;
+    all_pass = f(1000, 900, 1) and all_pass;
+    all_pass = f(100, 90, 70) and all_pass;
+
+    return all_pass ? 0 : -1;
+}
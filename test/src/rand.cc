@@ -10,6 +10,7 @@
  */
 
 #include "rand.hh"
+#include <cmath>
 #include <iostream>
 #include <random>
 
@@ -58,4 +59,35 @@ void rand_array<double>(double* array, size_t len)
 }
 
 template float  randfp<float>(float, float);
-template double randfp<double>(double, double);
\ No newline at end of file
+template double randfp<double>(double, double);
+
+template <typename T>
+void parsz::testutils::synth_field(T* array, size_t x, size_t y, size_t z, synth_kind kind, unsigned seed)
+{
+    std::mt19937                      gen(seed);
+    std::uniform_real_distribution<T> noise(-0.1, 0.1);
+    std::uniform_real_distribution<T> spike(-1, 1);
+    std::uniform_real_distribution<T> coin(0, 1);
+
+    // fixed wavelengths in grid points, so that the field is as smooth at any size
+    auto wave = [](size_t i, double wavelength) { return std::sin(2 * M_PI * i / wavelength); };
+
+    for (size_t k = 0; k < z; k++) {
+        for (size_t j = 0; j < y; j++) {
+            for (size_t i = 0; i < x; i++) {
+                auto id = i + x * (j + y * k);
+
+                if (kind == synth_kind::SPARSE) {
+                    array[id] = coin(gen) < 0.01 ? spike(gen) : 0;
+                    continue;
+                }
+
+                double v = wave(i, 97.0) + 0.5 * wave(i + j, 211.0) * wave(k, 53.0) + 0.25 * wave(j + 3 * k, 31.0);
+                array[id] = v + (kind == synth_kind::NOISY ? noise(gen) : 0);
+            }
+        }
+    }
+}
+
+template void parsz::testutils::synth_field<float>(float*, size_t, size_t, size_t, synth_kind, unsigned);
+template void parsz::testutils::synth_field<double>(double*, size_t, size_t, size_t, synth_kind, unsigned);
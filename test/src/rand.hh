@@ -25,6 +25,19 @@ void rand_array(T* array, size_t len);
 
 namespace parsz {
 namespace testutils {
+
+// deterministic synthetic fields; the same seed always gives the same field
+enum class synth_kind { SMOOTH, NOISY, SPARSE };
+
+/**
+ * @brief Fill an x-fastest field of x * y * z elements.
+ *
+ * SMOOTH is a sum of low-frequency waves; NOISY adds uniform noise at a tenth of the leading wave; SPARSE is zero but
+ * for about 1% of the points.
+ */
+template <typename T>
+void synth_field(T* array, size_t x, size_t y, size_t z, synth_kind kind, unsigned seed = 0x5eed);
+
 namespace cuda {
 
 template <typename T>
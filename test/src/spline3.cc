@@ -0,0 +1,108 @@
+/**
+ * @file spline3.cc
+ * @author Jiannan Tian
+ * @brief (host) Spline3 round trips of 1D and 2D fields, of lengths that are and are not multiples of the anchor
+ * stride, must be error bounded; version-1 archives are read only where their layout is.
+ * @version 0.3
+ * @date 2022-12-30
+ *
+ * (C) 2022 by Indiana University, Argonne National Laboratory
+ *
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+#include "compressor.hh"
+#include "context.hh"
+#include "framework.hh"
+#include "header.h"
+#include "rand.hh"
+#include "stat/compare_cpu.hh"
+
+using T          = float;
+using Compressor = cusz::Framework<T>::Spline3FeaturedCompressor;
+using BYTE       = uint8_t;
+using synth_kind = parsz::testutils::synth_kind;
+
+bool f(size_t x, size_t y, size_t z, synth_kind kind, double rel_eb)
+{
+    auto const len = x * y * z;
+
+    // inputs and outputs are read/written past the data length; see core_compress
+    std::vector<T> data((size_t)(len * 1.03) + 1), xdata((size_t)(len * 1.03) + 1, (T)-1234.5);
+    parsz::testutils::synth_field<T>(data.data(), x, y, z, kind);
+
+    auto minmax = std::minmax_element(data.begin(), data.begin() + len);
+    auto eb     = rel_eb * ((double)*minmax.second - *minmax.first);
+
+    cusz::Context ctx;
+    ctx.set_len(x, y, z).set_eb(eb).set_policy(CPU);
+    cusz::CompressorHelper::autotune_coarse_parvle(&ctx);
+
+    Compressor compressor;
+    BYTE*      compressed;
+    size_t     compressed_len;
+    compressor.init(&ctx);
+    compressor.compress(&ctx, data.data(), compressed, compressed_len);
+
+    cusz::Header header;
+    compressor.export_header(header);
+    std::vector<BYTE> archive(compressed, compressed + compressed_len);
+
+    Compressor decompressor;
+    decompressor.init(&header, false, CPU);
+    decompressor.decompress(&header, archive.data(), xdata.data(), nullptr, false);
+
+    size_t first_faulty = 0;
+    // with a little slack for the fp32 arithmetic of prediction
+    auto bounded = parsz::cppstd_error_bounded<T>(xdata.data(), data.data(), len, eb * 1.01, &first_faulty);
+
+    // the same archive as version 1 would have labeled it
+    auto v1 = header;
+    memset(v1.magic, 0x0, sizeof(v1.magic));
+    memcpy(archive.data(), &v1, sizeof(v1));
+
+    auto v1_rejected = false;
+    try {
+        Compressor v1_decompressor;
+        v1_decompressor.init(&v1, false, CPU);
+        v1_decompressor.decompress(&v1, archive.data(), xdata.data(), nullptr, false);
+    }
+    catch (std::runtime_error const&) {
+        v1_rejected = true;
+    }
+    // only 3D kept its anchor layout
+    auto v1_ok = v1_rejected == (z == 1);
+
+    printf(
+        "%-8s%zu x %zu x %zu, eb %.0e:\t%s, version 1 %s\n", kind == synth_kind::SMOOTH ? "smooth" : "noisy", x, y, z,
+        rel_eb, bounded ? "ok" : "NOT error bounded", v1_ok ? "ok" : "FAILED");
+    if (not bounded) printf("        first faulty index: %zu\n", first_faulty);
+    return bounded and v1_ok;
+}
+
+int main()
+{
+    auto all_pass = true;
+
+    for (auto kind : {synth_kind::SMOOTH, synth_kind::NOISY})
+        for (auto rel_eb : {1e-2, 1e-4}) {
+            // 1D: shorter than one anchor stride (512), a multiple of it, and not
+            all_pass = f(300, 1, 1, kind, rel_eb) and all_pass;
+            all_pass = f(1 << 20, 1, 1, kind, rel_eb) and all_pass;
+            all_pass = f(1000003, 1, 1, kind, rel_eb) and all_pass;
+            // 2D: multiples of the stride (32), not, and thin either way
+            all_pass = f(1024, 512, 1, kind, rel_eb) and all_pass;
+            all_pass = f(1001, 777, 1, kind, rel_eb) and all_pass;
+            all_pass = f(3000, 20, 1, kind, rel_eb) and all_pass;
+            all_pass = f(20, 3000, 1, kind, rel_eb) and all_pass;
+            // 3D, whose layout version 1 shares
+            all_pass = f(100, 90, 70, kind, rel_eb) and all_pass;
+        }
+
+    return all_pass ? 0 : -1;
+}
@@ -0,0 +1,165 @@
+/**
+ * @file spv_host.cc
+ * @author Jiannan Tian
+ * @brief (host) SpcodecVec round trips: packed idx with partial last blocks, nnz = 0, raw and XOR-coded values,
+ * region decoding, and subfiles of other versions.
+ * @version 0.3
+ * @date 2022-12-30
+ *
+ * (C) 2022 by Indiana University, Argonne National Laboratory
+ *
+ */
+
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "component/spcodec_vec.hh"
+
+using T     = float;
+using M     = uint32_t;
+using Codec = cusz::SpcodecVec<T, M>;
+using BYTE  = uint8_t;
+
+constexpr size_t LEN = 1 << 22;
+
+// subfile headers as written by version 1 (before packing) and by this build; the codec keeps its own private
+struct header_v1 {
+    int    header_nbyte : 16;
+    size_t uncompressed_len;
+    int    nnz;
+    M      entry[4];
+};
+struct header_v2 : header_v1 {
+    uint64_t version;
+    int      val_coding;
+};
+
+// `nnz` nonzeros with gaps from 0 to over 2^16, so blocks pack at different widths
+std::vector<T> make_sparse(int nnz)
+{
+    std::vector<T>                  a(LEN, 0);
+    std::mt19937                    gen(0x5eed + nnz);
+    std::uniform_int_distribution<> width(0, 10);
+    std::normal_distribution<T>     val(0, 1e3);
+
+    size_t at = 0;
+    for (auto i = 0; i < nnz; i++, at++) {
+        at += gen() & ((1u << (i % 97 == 96 ? 17 : width(gen))) - 1);
+        a.at(at) = val(gen);
+        if (a[at] == 0) a[at] = 1;
+    }
+    return a;
+}
+
+std::vector<BYTE> encode(std::vector<T>& a, cusz_spcodec_valcoding coding)
+{
+    Codec codec;
+    codec.set_value_coding(coding);
+    codec.init(LEN, 1, false, CPU);
+
+    BYTE*  out;
+    size_t out_len;
+    codec.encode(a.data(), LEN, out, out_len);
+    return std::vector<BYTE>(out, out + out_len);
+}
+
+bool decodes_to(std::vector<BYTE> subfile, std::vector<T> const& a)
+{
+    Codec codec;
+    codec.init(LEN, 1, false, CPU);
+
+    std::vector<T> xa(LEN, 0);
+    codec.decode(subfile.data(), xa.data());
+    if (xa != a) return false;
+
+    // three ranges back to back, one of them empty, cut at no block boundary in particular
+    size_t const   ranges[] = {0, 1, 1001, 1001, 300001, LEN - 77};
+    std::vector<T> part(1 + (LEN - 77 - 300001), 0), expected;
+    for (auto r = 0; r < 3; r++)
+        expected.insert(expected.end(), a.begin() + ranges[2 * r], a.begin() + ranges[2 * r + 1]);
+
+    codec.decode_region(subfile.data(), ranges, 3, part.data());
+    return part == expected;
+}
+
+// the same nonzeros, in the layout of version 1: raw uint32_t idx and raw values
+std::vector<BYTE> make_v1(std::vector<T> const& a)
+{
+    std::vector<uint32_t> idx;
+    std::vector<T>        val;
+    for (auto i = 0u; i < LEN; i++)
+        if (a[i] != 0) idx.push_back(i), val.push_back(a[i]);
+
+    header_v1 h;
+    memset(&h, 0xff, sizeof(h));  // version-1 writers left the padding uninitialized
+    h.header_nbyte     = sizeof(header_v1);
+    h.uncompressed_len = LEN;
+    h.nnz              = idx.size();
+    h.entry[0]         = 0;
+    h.entry[1]         = 128;
+    h.entry[2]         = h.entry[1] + sizeof(uint32_t) * idx.size();
+    h.entry[3]         = h.entry[2] + sizeof(T) * val.size();
+
+    std::vector<BYTE> subfile(h.entry[3], 0xff);
+    memcpy(subfile.data(), &h, sizeof(h));
+    memcpy(subfile.data() + h.entry[1], idx.data(), sizeof(uint32_t) * idx.size());
+    memcpy(subfile.data() + h.entry[2], val.data(), sizeof(T) * val.size());
+    return subfile;
+}
+
+bool rejected(std::vector<BYTE> subfile)
+{
+    try {
+        Codec          codec;
+        std::vector<T> xa(LEN, 0);
+        codec.init(LEN, 1, false, CPU);
+        codec.decode(subfile.data(), xa.data());
+    }
+    catch (std::runtime_error const&) {
+        return true;
+    }
+    return false;
+}
+
+int main()
+{
+    auto all_pass = true;
+    auto check    = [&](char const* what, int nnz, bool ok) {
+        printf("%-36snnz = %-8d%s\n", what, nnz, ok ? "ok" : "FAILED");
+        all_pass = all_pass and ok;
+    };
+
+    // none, one, exactly one block (128), and partial last blocks
+    for (auto nnz : {0, 1, 128, 129, 1000, 3001}) {
+        auto a = make_sparse(nnz);
+
+        auto raw       = encode(a, RawValue);
+        auto xor_coded = encode(a, XorValue);
+
+        check("raw values", nnz, decodes_to(raw, a));
+        check("XOR-coded values", nnz, decodes_to(xor_coded, a));
+        check("version 1 (raw idx, raw values)", nnz, decodes_to(make_v1(a), a));
+    }
+
+    auto a       = make_sparse(1000);
+    auto subfile = encode(a, XorValue);
+
+    header_v2 h;
+    memcpy(&h, subfile.data(), sizeof(h));
+    check("header as laid out here", 1000, h.header_nbyte == sizeof(header_v2) and h.version == 2);
+
+    auto newer = subfile;
+    h.version  = 3;
+    memcpy(newer.data(), &h, sizeof(h));
+    check("newer version rejected", 1000, rejected(newer));
+
+    auto unknown = subfile;
+    h.version    = 2, h.val_coding = 7;
+    memcpy(unknown.data(), &h, sizeof(h));
+    check("unknown value coding rejected", 1000, rejected(unknown));
+
+    return all_pass ? 0 : -1;
+}
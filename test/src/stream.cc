@@ -0,0 +1,84 @@
+/**
+ * @file stream.cc
+ * @author Jiannan Tian
+ * @brief (host) round trip of multi-segment archives, with an uneven last segment, in r2r mode.
+ * @version 0.3
+ * @date 2022-12-30
+ *
+ * (C) 2022 by Indiana University, Argonne National Laboratory
+ *
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "context.hh"
+#include "framework.hh"
+#include "rand.hh"
+#include "stat/compare_cpu.hh"
+#include "stream.hh"
+
+using T          = float;
+using Compressor = cusz::Framework<T>::LorenzoFeaturedCompressor;
+using synth_kind = parsz::testutils::synth_kind;
+
+bool f(char const* name, size_t x, size_t y, size_t z, size_t seg_nslab, synth_kind kind)
+{
+    auto const   len    = x * y * z;
+    double const rel_eb = 1e-3;
+
+    auto const slab_len = z > 1 ? x * y : (y > 1 ? x : 1);
+    auto const nslab    = len / slab_len;
+
+    auto const in_fname  = std::string(name) + ".f32";
+    auto const out_fname = std::string(name) + ".cuszs";
+    auto const x_fname   = std::string(name) + ".f32.cuszx";
+
+    std::vector<T> data(len), xdata(len);
+    parsz::testutils::synth_field<T>(data.data(), x, y, z, kind);
+    std::ofstream(in_fname, std::ios::binary).write(reinterpret_cast<char*>(data.data()), sizeof(T) * len);
+
+    cusz::Context ctx;
+    ctx.set_len(x, y, z).set_eb(rel_eb).set_policy(CPU);
+    ctx.mode = "r2r";
+
+    auto const budget_nbyte = sizeof(T) * slab_len * seg_nslab;
+    auto const nseg         = (nslab - 1) / cusz::StreamHelper::get_seg_nslab(&ctx, sizeof(T), budget_nbyte) + 1;
+
+    cusz::stream_compress<Compressor, T>(&ctx, in_fname, out_fname, budget_nbyte);
+    auto xlen = cusz::stream_decompress<Compressor, T>(out_fname, x_fname, CPU);
+
+    std::ifstream(x_fname, std::ios::binary).read(reinterpret_cast<char*>(xdata.data()), sizeof(T) * len);
+
+    auto minmax = std::minmax_element(data.begin(), data.end());
+    auto eb     = rel_eb * ((double)*minmax.second - *minmax.first);
+
+    size_t first_faulty = 0;
+    // with a little slack for the fp32 arithmetic of prediction
+    auto bounded = xlen == len;
+    bounded      = bounded and parsz::cppstd_error_bounded<T>(xdata.data(), data.data(), len, eb * 1.01, &first_faulty);
+
+    printf(
+        "%-8s%zu x %zu x %zu, %zu segments of %zu slabs, last %zu:\t%s\n", name, x, y, z, nseg, seg_nslab,
+        nslab - (nseg - 1) * seg_nslab, bounded ? "ok" : "NOT error bounded");
+    if (not bounded and xlen == len) printf("        first faulty index: %zu\n", first_faulty);
+
+    for (auto fname : {in_fname, out_fname, x_fname}) remove(fname.c_str());
+
+    return bounded;
+}
+
+int main()
+{
+    auto all_pass = true;
+
+    // segments are whole Lorenzo tiles along the slowest dimension (8 in 3D, 16 in 2D, 256 in 1D)
+    all_pass = f("3d", 64, 64, 60, 16, synth_kind::NOISY) and all_pass;
+    all_pass = f("2d", 1000, 200, 1, 48, synth_kind::NOISY) and all_pass;
+    all_pass = f("1d", 100000, 1, 1, 4096, synth_kind::SMOOTH) and all_pass;
+
+    return all_pass ? 0 : -1;
+}